@@ -171,7 +171,7 @@ final class AppDelegate: UIResponder, UIApplicationDelegate {
         Logger.warn("Synchronous launch started")
         defer { Logger.info("Synchronous launch finished") }
 
-        BenchEventStart(title: "Presenting HomeView", eventId: "AppStart", logInProduction: true)
+        BenchEventStart(title: "Presenting HomeView", metric: PerformanceMetrics.shared.histogram("app.launch"), eventId: "AppStart", logInProduction: true)
         AppReadiness.runNowOrWhenUIDidBecomeReadySync { BenchEventComplete(eventId: "AppStart") }
 
         Cryptography.seedRandom()
@@ -184,6 +184,7 @@ final class AppDelegate: UIResponder, UIApplicationDelegate {
         // files haven't been moved into place)
         let didDeviceTransferRestoreSucceed = Bench(
             title: "Slow device transfer service launch",
+            metric: PerformanceMetrics.shared.histogram("app.deviceTransferLaunchCleanup"),
             logIfLongerThan: 0.01,
             logInProduction: true,
             block: { DeviceTransferService.shared.launchCleanup() }
@@ -12,6 +12,11 @@ class MainAppContext: NSObject, AppContext {
 
     private(set) var appForegroundTime: Date
 
+    private static let willEnterForegroundMetric = PerformanceMetrics.shared.histogram("app.willEnterForeground")
+    private static let didEnterBackgroundMetric = PerformanceMetrics.shared.histogram("app.didEnterBackground")
+    private static let willResignActiveMetric = PerformanceMetrics.shared.histogram("app.willResignActive")
+    private static let didBecomeActiveMetric = PerformanceMetrics.shared.histogram("app.didBecomeActive")
+
     override init() {
         _reportedApplicationState = AtomicValue(.inactive, lock: .init())
 
@@ -69,7 +74,7 @@ class MainAppContext: NSObject, AppContext {
         self.reportedApplicationState = .inactive
         self.appForegroundTime = Date()
 
-        BenchManager.bench(title: "Slow WillEnterForeground", logIfLongerThan: 0.2, logInProduction: true) {
+        Bench(title: "Slow WillEnterForeground", metric: Self.willEnterForegroundMetric, logIfLongerThan: 0.2, logInProduction: true) {
             NotificationCenter.default.post(name: .OWSApplicationWillEnterForeground, object: nil)
         }
     }
@@ -80,9 +85,12 @@ class MainAppContext: NSObject, AppContext {
 
         self.reportedApplicationState = .background
 
-        BenchManager.bench(title: "Slow DidEnterBackground", logIfLongerThan: 0.1, logInProduction: true) {
+        Bench(title: "Slow DidEnterBackground", metric: Self.didEnterBackgroundMetric, logIfLongerThan: 0.1, logInProduction: true) {
             NotificationCenter.default.post(name: .OWSApplicationDidEnterBackground, object: nil)
         }
+
+        // Buffered log lines would be lost if we're killed while suspended.
+        Logger.flush()
     }
 
     @objc
@@ -91,7 +99,7 @@ class MainAppContext: NSObject, AppContext {
 
         self.reportedApplicationState = .inactive
 
-        BenchManager.bench(title: "Slow WillResignActive", logIfLongerThan: 0.1, logInProduction: true) {
+        Bench(title: "Slow WillResignActive", metric: Self.willResignActiveMetric, logIfLongerThan: 0.1, logInProduction: true) {
             NotificationCenter.default.post(name: .OWSApplicationWillResignActive, object: nil)
         }
     }
@@ -102,7 +110,7 @@ class MainAppContext: NSObject, AppContext {
 
         self.reportedApplicationState = .active
 
-        BenchManager.bench(title: "Slow DidBecomeActive", logIfLongerThan: 0.1, logInProduction: true) {
+        Bench(title: "Slow DidBecomeActive", metric: Self.didBecomeActiveMetric, logIfLongerThan: 0.1, logInProduction: true) {
             NotificationCenter.default.post(name: .OWSApplicationDidBecomeActive, object: nil)
         }
 
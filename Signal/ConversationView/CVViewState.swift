@@ -88,6 +88,8 @@ public class CVViewState: NSObject {
 
     public let mediaCache = CVMediaCache()
 
+    public let measurementCache = CVMeasurementCache()
+
     let contactShareViewHelper = ContactShareViewHelper()
 
     public var userHasScrolled = false
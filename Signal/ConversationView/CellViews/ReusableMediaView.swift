@@ -470,11 +470,13 @@ public class MediaViewAdapterSticker: NSObject, MediaViewAdapterSwift {
 
     public let shouldBeRenderedByYY: Bool
     let attachmentStream: TSResourceStream
+    let stickerInfo: StickerInfo?
     let imageView: UIImageView
 
-    public init(attachmentStream: TSResourceStream) {
+    public init(attachmentStream: TSResourceStream, stickerInfo: StickerInfo?) {
         self.shouldBeRenderedByYY = attachmentStream.computeContentType().isAnimatedImage
         self.attachmentStream = attachmentStream
+        self.stickerInfo = stickerInfo
 
         if shouldBeRenderedByYY {
             imageView = CVAnimatedImageView()
@@ -508,6 +510,17 @@ public class MediaViewAdapterSticker: NSObject, MediaViewAdapterSwift {
             return Promise(error: OWSAssertionError("Attachment stream missing original file path."))
         }
         if shouldBeRenderedByYY {
+            // Share decoded frames with every other cell showing this sticker.
+            if
+                let stickerInfo,
+                let animatedImage = StickerFrameCache.shared.image(
+                    stickerKey: stickerInfo.asKey(),
+                    fileUrl: URL(fileURLWithPath: filePath),
+                    pointSize: CVComponentSticker.stickerSize
+                )
+            {
+                return Promise.value(animatedImage)
+            }
             guard let animatedImage = YYImage(contentsOfFile: filePath) else {
                 return Promise(error: OWSAssertionError("Invalid animated image."))
             }
@@ -524,7 +537,8 @@ public class MediaViewAdapterSticker: NSObject, MediaViewAdapterSwift {
         AssertIsOnMainThread()
 
         if shouldBeRenderedByYY {
-            guard let image = media as? YYImage else {
+            // Either a YYImage or an animated image from StickerFrameCache.
+            guard let image = media as? UIImage else {
                 owsFailDebug("Media has unexpected type: \(type(of: media))")
                 return
             }
@@ -796,6 +796,7 @@ fileprivate extension CVComponentState.Builder {
     mutating func populateAndBuild() throws -> CVComponentState {
 
         if let reactionState = InteractionReactionState(interaction: interaction,
+                                                        prefetch: prefetch,
                                                         transaction: transaction),
            reactionState.hasReactions {
             self.reactions = Reactions(reactionState: reactionState,
@@ -55,7 +55,10 @@ public class CVComponentSticker: CVComponentBase, CVComponent {
             if let cachedView = mediaCache.getMediaView(cacheKey, isAnimated: isAnimated) {
                 reusableMediaView = cachedView
             } else {
-                let mediaViewAdapter = MediaViewAdapterSticker(attachmentStream: attachmentStream.attachmentStream)
+                let mediaViewAdapter = MediaViewAdapterSticker(
+                    attachmentStream: attachmentStream.attachmentStream,
+                    stickerInfo: stickerInfo
+                )
                 reusableMediaView = ReusableMediaView(mediaViewAdapter: mediaViewAdapter, mediaCache: mediaCache)
                 mediaCache.setMediaView(reusableMediaView, forKey: cacheKey, isAnimated: isAnimated)
             }
@@ -404,7 +404,7 @@ public final class ConversationViewController: OWSViewController {
             Task {
                 let profileFetcher = SSKEnvironment.shared.profileFetcherRef
                 for serviceId in serviceIds {
-                    _ = try? await profileFetcher.fetchProfile(for: serviceId, options: [.opportunistic])
+                    _ = try? await profileFetcher.fetchProfile(for: serviceId, options: [.opportunistic, .activeThread])
                 }
             }
             self.updateV2GroupIfNecessary()
@@ -21,6 +21,8 @@ struct CVLoadContext: CVItemBuildingContext {
     let prevRenderState: CVRenderState
     let transaction: SDSAnyReadTransaction
     let avatarBuilder: CVAvatarBuilder
+    // Set once the load window is known.
+    var prefetch: CVLoadPrefetch?
 
     init(
         loadRequest: CVLoadRequest,
@@ -58,6 +60,7 @@ protocol CVItemBuildingContext {
     var viewStateSnapshot: CVViewStateSnapshot { get }
     var transaction: SDSAnyReadTransaction { get }
     var avatarBuilder: CVAvatarBuilder { get }
+    var prefetch: CVLoadPrefetch? { get }
 }
 
 // MARK: -
@@ -77,6 +80,7 @@ struct CVItemBuildingContextImpl: CVItemBuildingContext {
     let viewStateSnapshot: CVViewStateSnapshot
     let transaction: SDSAnyReadTransaction
     let avatarBuilder: CVAvatarBuilder
+    var prefetch: CVLoadPrefetch?
 }
 
 // MARK: -
@@ -97,4 +101,5 @@ extension CVItemBuilding {
     var mediaCache: CVMediaCache { itemBuildingContext.mediaCache }
     var transaction: SDSAnyReadTransaction { itemBuildingContext.transaction }
     var avatarBuilder: CVAvatarBuilder { itemBuildingContext.avatarBuilder }
+    var prefetch: CVLoadPrefetch? { itemBuildingContext.prefetch }
 }
@@ -482,7 +482,8 @@ public class CVLoadCoordinator: NSObject {
             viewStateSnapshot: viewStateSnapshot,
             spoilerState: spoilerState,
             prevRenderState: prevRenderState,
-            messageLoader: messageLoader
+            messageLoader: messageLoader,
+            measurementCache: viewState.measurementCache
         )
 
         firstly {
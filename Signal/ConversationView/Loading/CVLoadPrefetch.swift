@@ -0,0 +1,63 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import SignalServiceKit
+import SignalUI
+
+// Building component states used to query the database item by item
+// (reactions, attachments, ...), so loading a busy conversation ran
+// hundreds of small queries. When a load needs to build many items,
+// we instead fetch what they'll need up front with a few set-based
+// queries over the rowid range of the items being built.
+struct CVLoadPrefetch {
+
+    // Below this, per-item queries are cheaper than a range query.
+    static let minInteractionCount = 8
+
+    let interactionRowIds: ClosedRange<Int64>
+
+    private let reactionsByMessageId: [String: [OWSReaction]]
+
+    static func build(
+        interactionsToBuild interactions: [TSInteraction],
+        threadUniqueId: String,
+        transaction: SDSAnyReadTransaction
+    ) -> CVLoadPrefetch? {
+        let rowIds = interactions.compactMap { $0.sqliteRowId }
+        guard
+            rowIds.count >= minInteractionCount,
+            let minRowId = rowIds.min(),
+            let maxRowId = rowIds.max()
+        else {
+            return nil
+        }
+        let interactionRowIds = minRowId...maxRowId
+
+        let reactionsByMessageId = ReactionFinder.allReactions(
+            threadUniqueId: threadUniqueId,
+            interactionRowIds: interactionRowIds,
+            transaction: transaction.unwrapGrdbRead
+        )
+
+        // This populates the attachment read cache, which the per-item
+        // attachment lookups consult first.
+        let attachmentStore = TSAttachmentStore()
+        let attachmentIds = interactions.lazy
+            .compactMap { $0 as? TSMessage }
+            .flatMap { attachmentStore.allAttachmentIds(for: $0) }
+        attachmentStore.prefetchAttachments(withAttachmentIds: Array(attachmentIds), tx: transaction)
+
+        return CVLoadPrefetch(interactionRowIds: interactionRowIds, reactionsByMessageId: reactionsByMessageId)
+    }
+
+    /// Returns the reactions to `message`, or nil if the message wasn't
+    /// covered by this prefetch.
+    func reactions(for message: TSMessage) -> [OWSReaction]? {
+        guard let rowId = message.sqliteRowId, interactionRowIds.contains(rowId) else {
+            return nil
+        }
+        return reactionsByMessageId[message.uniqueId] ?? []
+    }
+}
@@ -15,6 +15,10 @@ public class CVLoader: NSObject {
     private let spoilerState: SpoilerRenderState
     private let prevRenderState: CVRenderState
     private let messageLoader: MessageLoader
+    private let measurementCache: CVMeasurementCache
+
+    private static let initialLoadMetric = PerformanceMetrics.shared.histogram("cv.initialLoad")
+    private static let loadMetric = PerformanceMetrics.shared.histogram("cv.load")
 
     init(
         threadUniqueId: String,
@@ -22,7 +26,8 @@ public class CVLoader: NSObject {
         viewStateSnapshot: CVViewStateSnapshot,
         spoilerState: SpoilerRenderState,
         prevRenderState: CVRenderState,
-        messageLoader: MessageLoader
+        messageLoader: MessageLoader,
+        measurementCache: CVMeasurementCache
     ) {
         self.threadUniqueId = threadUniqueId
         self.loadRequest = loadRequest
@@ -30,6 +35,7 @@ public class CVLoader: NSObject {
         self.spoilerState = spoilerState
         self.prevRenderState = prevRenderState
         self.messageLoader = messageLoader
+        self.measurementCache = measurementCache
     }
 
     func loadPromise() -> Promise<CVUpdate> {
@@ -47,6 +53,12 @@ public class CVLoader: NSObject {
         }
 
         return firstly(on: CVUtils.workQueue(isInitialLoad: loadRequest.isInitialLoad)) { () -> CVUpdate in
+            let startTime = CACurrentMediaTime()
+            defer {
+                let metric = loadRequest.isInitialLoad ? Self.initialLoadMetric : Self.loadMetric
+                metric.record(CACurrentMediaTime() - startTime)
+            }
+
             // To ensure coherency, the entire load should be done with a single transaction.
             let loadState: LoadState = try Self.databaseStorage.read { transaction in
                 let thread = TSThread.anyFetch(uniqueId: threadUniqueId, transaction: transaction)
@@ -65,7 +77,7 @@ public class CVLoader: NSObject {
                     return ConversationViewModel.load(for: thread, tx: transaction)
                 }()
 
-                let loadContext = CVLoadContext(
+                var loadContext = CVLoadContext(
                     loadRequest: loadRequest,
                     threadViewModel: threadViewModel,
                     viewStateSnapshot: viewStateSnapshot,
@@ -163,6 +175,9 @@ public class CVLoader: NSObject {
                     throw error
                 }
 
+                loadContext.prefetch = self.buildPrefetch(loadContext: loadContext,
+                                                          updatedInteractionIds: updatedInteractionIds)
+
                 return LoadState(
                     threadViewModel: threadViewModel,
                     conversationViewModel: conversationViewModel,
@@ -193,14 +208,34 @@ public class CVLoader: NSObject {
 
     // MARK: -
 
+    private func canReuseComponentStates(loadContext: CVLoadContext) -> Bool {
+        // Don't cache in the reset() case.
+        return (loadRequest.canReuseComponentStates &&
+                    loadContext.conversationStyle.isEqualForCellRendering(prevRenderState.conversationStyle))
+    }
+
+    // If many of the loaded interactions need their component states
+    // built, fetch what they'll need up front.
+    private func buildPrefetch(loadContext: CVLoadContext,
+                               updatedInteractionIds: Set<String>) -> CVLoadPrefetch? {
+        var interactionsToBuild = loadContext.messageLoader.loadedInteractions
+        if canReuseComponentStates(loadContext: loadContext) {
+            let prevInteractionIds = Set(prevRenderState.items.lazy.map { $0.interactionUniqueId })
+            interactionsToBuild = interactionsToBuild.filter { interaction in
+                !prevInteractionIds.contains(interaction.uniqueId) || updatedInteractionIds.contains(interaction.uniqueId)
+            }
+        }
+        return CVLoadPrefetch.build(interactionsToBuild: interactionsToBuild,
+                                    threadUniqueId: threadUniqueId,
+                                    transaction: loadContext.transaction)
+    }
+
     private func buildRenderItems(loadContext: CVLoadContext,
                                   updatedInteractionIds: Set<String>) -> [CVRenderItem] {
 
         let conversationStyle = loadContext.conversationStyle
 
-        // Don't cache in the reset() case.
-        let canReuseState = (loadRequest.canReuseComponentStates &&
-                                conversationStyle.isEqualForCellRendering(prevRenderState.conversationStyle))
+        let canReuseState = canReuseComponentStates(loadContext: loadContext)
 
         var itemModelBuilder = CVItemModelBuilder(loadContext: loadContext)
 
@@ -216,22 +251,38 @@ public class CVLoader: NSObject {
         }
         let itemModels: [CVItemModel] = itemModelBuilder.buildItems()
 
-        var renderItems = [CVRenderItem]()
-        for itemModel in itemModels {
-            guard let renderItem = buildRenderItem(itemBuildingContext: loadContext,
-                                                   itemModel: itemModel) else {
-                continue
+        return Self.buildRenderItems(itemModels: itemModels,
+                                     conversationStyle: conversationStyle,
+                                     measurementCache: measurementCache)
+    }
+
+    static func buildRenderItems(itemModels: [CVItemModel],
+                                 conversationStyle: ConversationStyle,
+                                 measurementCache: CVMeasurementCache) -> [CVRenderItem] {
+        let items: [(itemModel: CVItemModel, rootComponent: CVRootComponent)] = itemModels.compactMap { itemModel in
+            guard let rootComponent = buildRootComponent(itemModel: itemModel) else {
+                return nil
             }
-            renderItems.append(renderItem)
+            return (itemModel, rootComponent)
         }
 
-        return renderItems
-    }
+        var cellMeasurements = items.map { measurementCache.cellMeasurement(for: $0.itemModel) }
+        let unmeasuredIndices = cellMeasurements.indices.filter { cellMeasurements[$0] == nil }
 
-    private func buildRenderItem(itemBuildingContext: CVItemBuildingContext,
-                                 itemModel: CVItemModel) -> CVRenderItem? {
-        Self.buildRenderItem(itemBuildingContext: itemBuildingContext,
-                             itemModel: itemModel)
+        // Measurement uses shared text and layout caches, so cells are
+        // measured one at a time.
+        for itemIndex in unmeasuredIndices {
+            let cellMeasurement = buildCellMeasurement(rootComponent: items[itemIndex].rootComponent,
+                                                       conversationStyle: conversationStyle)
+            cellMeasurements[itemIndex] = cellMeasurement
+            measurementCache.setCellMeasurement(cellMeasurement, for: items[itemIndex].itemModel)
+        }
+
+        return zip(items, cellMeasurements).map { item, cellMeasurement in
+            CVRenderItem(itemModel: item.itemModel,
+                         rootComponent: item.rootComponent,
+                         cellMeasurement: cellMeasurement!)
+        }
     }
 
     #if USE_DEBUG_UI
@@ -392,9 +443,19 @@ public class CVLoader: NSObject {
 
     private static func buildRenderItem(itemBuildingContext: CVItemBuildingContext,
                                         itemModel: CVItemModel) -> CVRenderItem? {
+        guard let rootComponent = buildRootComponent(itemModel: itemModel) else {
+            return nil
+        }
 
-        let conversationStyle = itemBuildingContext.conversationStyle
+        let cellMeasurement = buildCellMeasurement(rootComponent: rootComponent,
+                                                   conversationStyle: itemBuildingContext.conversationStyle)
+
+        return CVRenderItem(itemModel: itemModel,
+                            rootComponent: rootComponent,
+                            cellMeasurement: cellMeasurement)
+    }
 
+    private static func buildRootComponent(itemModel: CVItemModel) -> CVRootComponent? {
         let rootComponent: CVRootComponent
         switch itemModel.messageCellType {
         case .dateHeader:
@@ -447,13 +508,7 @@ public class CVLoader: NSObject {
             Logger.warn("Discarding item: \(itemModel.messageCellType).")
             return nil
         }
-
-        let cellMeasurement = buildCellMeasurement(rootComponent: rootComponent,
-                                                   conversationStyle: conversationStyle)
-
-        return CVRenderItem(itemModel: itemModel,
-                            rootComponent: rootComponent,
-                            cellMeasurement: cellMeasurement)
+        return rootComponent
     }
 
     private static func buildEmptyCellMeasurement() -> CVCellMeasurement {
@@ -0,0 +1,58 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import SignalServiceKit
+import SignalUI
+
+// Measuring cells is the most expensive part of building render items.
+// Loads often rebuild items whose appearance hasn't changed: the load
+// window moves, a group update invalidates the component states, or the
+// conversation style changes and later changes back (e.g. on rotation).
+//
+// A cell's measurement depends only on its component state, its view
+// state and the conversation style, so we can reuse measurements across
+// loads whenever all three are equal.
+public class CVMeasurementCache {
+
+    private struct Entry {
+        let componentState: CVComponentState
+        let itemViewState: CVItemViewState
+        let conversationStyle: ConversationStyle
+        let cellMeasurement: CVCellMeasurement
+    }
+
+    // We keep a few measurements per interaction so that toggling between
+    // conversation styles (e.g. portrait and landscape) keeps hitting.
+    private static let maxEntriesPerInteraction = 2
+
+    // Loads are serialized, so entries for a given interaction are never
+    // updated concurrently. LRUCache is thread-safe.
+    private let entries = LRUCache<String, [Entry]>(maxSize: 1024, shouldEvacuateInBackground: true)
+
+    public init() {}
+
+    func cellMeasurement(for itemModel: CVItemModel) -> CVCellMeasurement? {
+        guard let entries = entries.get(key: itemModel.interaction.uniqueId) else {
+            return nil
+        }
+        return entries.first(where: { entry in
+            entry.conversationStyle.isEqualForCellRendering(itemModel.conversationStyle) &&
+                entry.itemViewState == itemModel.itemViewState &&
+                entry.componentState == itemModel.componentState
+        })?.cellMeasurement
+    }
+
+    func setCellMeasurement(_ cellMeasurement: CVCellMeasurement, for itemModel: CVItemModel) {
+        let interactionId = itemModel.interaction.uniqueId
+        let entry = Entry(
+            componentState: itemModel.componentState,
+            itemViewState: itemModel.itemViewState,
+            conversationStyle: itemModel.conversationStyle,
+            cellMeasurement: cellMeasurement
+        )
+        let existingEntries = entries.get(key: interactionId) ?? []
+        entries.set(key: interactionId, value: Array(([entry] + existingEntries).prefix(Self.maxEntriesPerInteraction)))
+    }
+}
@@ -18,7 +18,7 @@ public class InteractionReactionState: NSObject {
     let emojiCounts: [EmojiCount]
     let localUserEmoji: String?
 
-    init?(interaction: TSInteraction, transaction: SDSAnyReadTransaction) {
+    init?(interaction: TSInteraction, prefetch: CVLoadPrefetch? = nil, transaction: SDSAnyReadTransaction) {
         // No reactions on non-message interactions
         guard let message = interaction as? TSMessage else { return nil }
 
@@ -27,8 +27,8 @@ public class InteractionReactionState: NSObject {
             return nil
         }
 
-        let finder = ReactionFinder(uniqueMessageId: message.uniqueId)
-        let allReactions = finder.allReactions(transaction: transaction.unwrapGrdbRead)
+        let allReactions = prefetch?.reactions(for: message)
+            ?? ReactionFinder(uniqueMessageId: message.uniqueId).allReactions(transaction: transaction.unwrapGrdbRead)
         let localUserReaction = allReactions.first(where: { $0.reactor == localAddress })
 
         reactionsByEmoji = allReactions.reduce(
@@ -0,0 +1,244 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import SignalServiceKit
+
+/// A group of small files sent as a single resource during a device transfer.
+///
+/// Every resource sent over the session has a fixed cost, for hashing it,
+/// setting up the transfer and waiting for it to complete. This cost
+/// dominates the time to send the many small files (avatars, stickers,
+/// thumbnails) most devices have, so files under `maxBatchedFileSize` are
+/// sent in batches of about `targetBatchSize` bytes instead.
+///
+/// A batch is sent as an archive of its files, which is compressed if that
+/// makes it noticeably smaller. The new device unpacks the archive into the
+/// pending transfer directory, just as if each file had been sent on its own.
+struct DeviceTransferBatch {
+    static let maxBatchedFileSize: UInt64 = 256 * 1024
+    static let targetBatchSize: UInt64 = 4 * 1024 * 1024
+
+    private static let identifierPrefix = "batch-"
+
+    let identifier: String
+    let files: [DeviceTransferProtoFile]
+
+    var estimatedSize: UInt64 { files.reduce(0) { $0 + $1.estimatedSize } }
+
+    static func isBatchIdentifier(_ identifier: String) -> Bool {
+        return identifier.hasPrefix(identifierPrefix)
+    }
+
+    /// Groups the small files in `files` into batches, and returns them along
+    /// with the files that should be sent on their own.
+    ///
+    /// Batches are assigned in order, so the same files always produce the
+    /// same batches.
+    static func makeBatches(
+        files: [DeviceTransferProtoFile]
+    ) -> (batches: [DeviceTransferBatch], unbatchedFiles: [DeviceTransferProtoFile]) {
+        var batches = [DeviceTransferBatch]()
+        var unbatchedFiles = [DeviceTransferProtoFile]()
+
+        var currentFiles = [DeviceTransferProtoFile]()
+        var currentSize: UInt64 = 0
+        func finishBatch() {
+            guard !currentFiles.isEmpty else {
+                return
+            }
+            batches.append(DeviceTransferBatch(identifier: identifierPrefix + String(batches.count), files: currentFiles))
+            currentFiles = []
+            currentSize = 0
+        }
+
+        for file in files {
+            guard file.estimatedSize <= maxBatchedFileSize else {
+                unbatchedFiles.append(file)
+                continue
+            }
+            currentFiles.append(file)
+            currentSize += file.estimatedSize
+            if currentSize >= targetBatchSize {
+                finishBatch()
+            }
+        }
+        finishBatch()
+
+        return (batches, unbatchedFiles)
+    }
+
+    /// Returns the batch with `identifier` that `makeBatches(files:)` makes
+    /// from `files`, if there is one.
+    static func batch(identifier: String, files: [DeviceTransferProtoFile]) -> DeviceTransferBatch? {
+        return makeBatches(files: files).batches.first { $0.identifier == identifier }
+    }
+
+    // MARK: - Archives
+
+    enum ArchiveError: Error {
+        case invalidHeader
+        case invalidEntry
+        case decompressionFailed
+    }
+
+    /// Archives start with "SGTB" and a format version.
+    private static let archiveMagic = Data("SGTB".utf8)
+    private static let archiveVersion: UInt8 = 1
+
+    private enum ArchiveFlags {
+        static let compressed: UInt8 = 1 << 0
+    }
+
+    private enum EntryFlags {
+        static let missing: UInt8 = 1 << 0
+    }
+
+    /// Compression is only worth its cost on the receiving end if it saves
+    /// at least this fraction of the archive's size. Most attachments are
+    /// already compressed media, and don't get any smaller.
+    private static let minimumCompressionSavings = 0.1
+
+    /// Writes an archive of the batch's files, read from `baseDirectory`, to
+    /// `url`.
+    ///
+    /// Files that no longer exist are recorded as missing, so the new device
+    /// can skip them rather than waiting for them.
+    ///
+    /// - Returns: Whether the archive was compressed.
+    @discardableResult
+    func writeArchive(baseDirectory: URL, to url: URL) throws -> Bool {
+        var payload = Data()
+        payload.reserveCapacity(Int(estimatedSize) + files.count * 64)
+
+        for file in files {
+            let fileUrl = URL(fileURLWithPath: file.relativePath, relativeTo: baseDirectory)
+            let identifierData = Data(file.identifier.utf8)
+            let fileData: Data?
+            do {
+                fileData = try Data(contentsOf: fileUrl)
+            } catch CocoaError.fileReadNoSuchFile {
+                Logger.warn("Missing file for transfer, it probably disappeared or was otherwise deleted.")
+                fileData = nil
+            }
+
+            payload.appendBigEndian(UInt16(identifierData.count))
+            payload.append(identifierData)
+            payload.append(fileData == nil ? EntryFlags.missing : 0)
+            payload.appendBigEndian(UInt64(fileData?.count ?? 0))
+            if let fileData {
+                payload.append(fileData)
+            }
+        }
+
+        var flags: UInt8 = 0
+        if
+            let compressedPayload = try? (payload as NSData).compressed(using: .lzfse) as Data,
+            Double(compressedPayload.count) <= Double(payload.count) * (1 - Self.minimumCompressionSavings)
+        {
+            payload = compressedPayload
+            flags |= ArchiveFlags.compressed
+        }
+
+        var archive = Self.archiveMagic
+        archive.append(Self.archiveVersion)
+        archive.append(flags)
+        archive.append(payload)
+        try archive.write(to: url)
+
+        return flags & ArchiveFlags.compressed != 0
+    }
+
+    /// Unpacks an archive written by `writeArchive(baseDirectory:to:)`,
+    /// writing each file to `directory`, named after its identifier.
+    ///
+    /// - Returns: The identifiers of the files that were unpacked, and of the
+    /// files that were missing on the old device.
+    static func extractArchive(at url: URL, to directory: URL) throws -> (receivedFileIds: [String], missingFileIds: [String]) {
+        let archive = try Data(contentsOf: url, options: .mappedIfSafe)
+        let headerLength = archiveMagic.count + 2
+        guard
+            archive.count >= headerLength,
+            archive.starts(with: archiveMagic),
+            archive[archive.startIndex + archiveMagic.count] == archiveVersion
+        else {
+            throw ArchiveError.invalidHeader
+        }
+        let flags = archive[archive.startIndex + archiveMagic.count + 1]
+
+        var payload = archive.dropFirst(headerLength)
+        if flags & ArchiveFlags.compressed != 0 {
+            guard let decompressedPayload = try? (payload as NSData).decompressed(using: .lzfse) as Data else {
+                throw ArchiveError.decompressionFailed
+            }
+            payload = decompressedPayload
+        }
+
+        var receivedFileIds = [String]()
+        var missingFileIds = [String]()
+        var reader = ArchiveReader(data: payload)
+        while !reader.isAtEnd {
+            let identifierLength = Int(try reader.readBigEndian(UInt16.self))
+            guard let identifier = String(data: try reader.read(count: identifierLength), encoding: .utf8) else {
+                throw ArchiveError.invalidEntry
+            }
+            // Identifiers become file names, so they mustn't be able to
+            // refer to anything outside of `directory`.
+            guard
+                !identifier.isEmpty,
+                !identifier.contains("/"),
+                identifier != ".",
+                identifier != ".."
+            else {
+                throw ArchiveError.invalidEntry
+            }
+            let entryFlags = try reader.read(count: 1).first!
+            let fileLength = try reader.readBigEndian(UInt64.self)
+            guard fileLength <= UInt64(Int.max) else {
+                throw ArchiveError.invalidEntry
+            }
+            let fileData = try reader.read(count: Int(fileLength))
+
+            if entryFlags & EntryFlags.missing != 0 {
+                missingFileIds.append(identifier)
+            } else {
+                try fileData.write(to: URL(fileURLWithPath: identifier, relativeTo: directory))
+                receivedFileIds.append(identifier)
+            }
+        }
+        return (receivedFileIds, missingFileIds)
+    }
+
+    private struct ArchiveReader {
+        private let data: Data
+        private var cursor: Data.Index
+
+        init(data: Data) {
+            self.data = data
+            self.cursor = data.startIndex
+        }
+
+        var isAtEnd: Bool { cursor >= data.endIndex }
+
+        mutating func read(count: Int) throws -> Data {
+            guard count >= 0, data.endIndex - cursor >= count else {
+                throw ArchiveError.invalidEntry
+            }
+            let result = data[cursor..<(cursor + count)]
+            cursor += count
+            return result
+        }
+
+        mutating func readBigEndian<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+            return try read(count: MemoryLayout<T>.size).reduce(T.zero) { ($0 << 8) | T($1) }
+        }
+    }
+}
+
+private extension Data {
+    mutating func appendBigEndian<T: FixedWidthInteger>(_ value: T) {
+        withUnsafeBytes(of: value.bigEndian) { append(contentsOf: $0) }
+    }
+}
@@ -10,13 +10,43 @@ class DeviceTransferOperation: OWSOperation {
 
     public struct CancelError: Error {}
 
-    let file: DeviceTransferProtoFile
+    private enum Payload {
+        case file(DeviceTransferProtoFile)
+        case batch(DeviceTransferBatch)
+    }
+
+    private let payload: Payload
+
+    private var identifier: String {
+        switch payload {
+        case .file(let file):
+            return file.identifier
+        case .batch(let batch):
+            return batch.identifier
+        }
+    }
+
+    private var estimatedSize: UInt64 {
+        switch payload {
+        case .file(let file):
+            return file.estimatedSize
+        case .batch(let batch):
+            return batch.estimatedSize
+        }
+    }
 
     let promise: Promise<Void>
     private let future: Future<Void>
 
     class func scheduleTransfer(file: DeviceTransferProtoFile, priority: Operation.QueuePriority = .normal) -> Promise<Void> {
-        let operation = DeviceTransferOperation(file: file)
+        let operation = DeviceTransferOperation(payload: .file(file))
+        operation.queuePriority = priority
+        operationQueue.addOperation(operation)
+        return operation.promise
+    }
+
+    class func scheduleTransfer(batch: DeviceTransferBatch) -> Promise<Void> {
+        let operation = DeviceTransferOperation(payload: .batch(batch))
         operationQueue.addOperation(operation)
         return operation.promise
     }
@@ -30,8 +60,8 @@ class DeviceTransferOperation: OWSOperation {
         return queue
     }()
 
-    private init(file: DeviceTransferProtoFile) {
-        self.file = file
+    private init(payload: Payload) {
+        self.payload = payload
         (self.promise, self.future) = Promise<Void>.pending()
         super.init()
     }
@@ -56,24 +86,44 @@ class DeviceTransferOperation: OWSOperation {
     }
 
     override public func run() {
-        Logger.info("Transferring file: \(file.identifier), estimatedSize: \(file.estimatedSize)")
-
-        // Use the main thread for all MCSession related operations.
-        // There shouldn't be anything else going on in the app, anyway.
-        DispatchQueue.main.async { self.prepareForSending() }
-    }
+        Logger.info("Transferring file: \(identifier), estimatedSize: \(estimatedSize)")
 
-    private var progress: Progress?
-    private func prepareForSending() {
-        guard case .outgoing(let newDevicePeerId, _, _, let transferredFiles, let progress) = deviceTransferService.transferState else {
+        guard case .outgoing(_, _, _, let transferredFiles, _) = deviceTransferService.transferState else {
             return reportError(OWSAssertionError("Tried to transfer file while in unexpected state: \(deviceTransferService.transferState)"))
         }
 
-        guard !transferredFiles.contains(file.identifier) else {
+        guard !transferredFiles.contains(identifier) else {
             Logger.info("File was already transferred, skipping")
             return reportSuccess()
         }
 
+        switch payload {
+        case .file(let file):
+            // Use the main thread for all MCSession related operations.
+            // There shouldn't be anything else going on in the app, anyway.
+            DispatchQueue.main.async { self.prepareForSending(file: file) }
+        case .batch(let batch):
+            // Archive the batch on the operation's thread, so that other
+            // batches can be prepared while this one is being sent.
+            let archiveUrl = OWSFileSystem.temporaryFileUrl()
+            do {
+                let isCompressed = try batch.writeArchive(baseDirectory: DeviceTransferService.appSharedDataDirectory, to: archiveUrl)
+                Logger.info("Archived \(batch.files.count) files for \(batch.identifier), compressed: \(isCompressed)")
+            } catch {
+                OWSFileSystem.deleteFileIfExists(archiveUrl.path)
+                return reportError(OWSAssertionError("Failed to archive \(batch.identifier) \(error)"))
+            }
+            DispatchQueue.main.async {
+                self.send(url: archiveUrl)
+                // The session reads the file before calling back, so it can
+                // be deleted once the operation has finished.
+                self.promise.ensure { OWSFileSystem.deleteFileIfExists(archiveUrl.path) }.cauterize()
+            }
+        }
+    }
+
+    private var progress: Progress?
+    private func prepareForSending(file: DeviceTransferProtoFile) {
         var url = URL(fileURLWithPath: file.relativePath, relativeTo: DeviceTransferService.appSharedDataDirectory)
 
         if !OWSFileSystem.fileOrFolderExists(url: url) {
@@ -99,6 +149,14 @@ class DeviceTransferOperation: OWSOperation {
             }
         }
 
+        send(url: url)
+    }
+
+    private func send(url: URL) {
+        guard case .outgoing(let newDevicePeerId, _, _, _, let progress) = deviceTransferService.transferState else {
+            return reportError(OWSAssertionError("Tried to transfer file while in unexpected state: \(deviceTransferService.transferState)"))
+        }
+
         guard let sha256Digest = try? Cryptography.computeSHA256DigestOfFile(at: url) else {
             return reportError(OWSAssertionError("Failed to calculate sha256 for file"))
         }
@@ -109,27 +167,27 @@ class DeviceTransferOperation: OWSOperation {
 
         guard let fileProgress = session.sendResource(
             at: url,
-            withName: file.identifier + " " + sha256Digest.hexadecimalString,
+            withName: identifier + " " + sha256Digest.hexadecimalString,
             toPeer: newDevicePeerId,
             withCompletionHandler: { [weak self] error in
                 guard let self = self else { return }
 
                 if let error = error {
-                    self.reportError(OWSAssertionError("Transferring file \(self.file.identifier) failed \(error)"))
+                    self.reportError(OWSAssertionError("Transferring file \(self.identifier) failed \(error)"))
                 } else {
-                    Logger.info("Transferring file \(self.file.identifier) complete")
+                    Logger.info("Transferring file \(self.identifier) complete")
                     self.deviceTransferService.transferState =
-                        self.deviceTransferService.transferState.appendingFileId(self.file.identifier)
+                        self.deviceTransferService.transferState.appendingFileId(self.identifier)
                     self.reportSuccess()
                 }
 
                 self.progress?.removeObserver(self, forKeyPath: "fractionCompleted")
             }
         ) else {
-            return reportError(OWSAssertionError("Transfer of file failed \(file.identifier)"))
+            return reportError(OWSAssertionError("Transfer of file failed \(identifier)"))
         }
 
-        progress.addChild(fileProgress, withPendingUnitCount: Int64(file.estimatedSize))
+        progress.addChild(fileProgress, withPendingUnitCount: Int64(estimatedSize))
         self.progress = fileProgress
         fileProgress.addObserver(self, forKeyPath: "fractionCompleted", options: .initial, context: nil)
     }
@@ -149,6 +207,6 @@ class DeviceTransferOperation: OWSOperation {
         // every 1%. Otherwise, every 10%.
         guard percentChange >= (DebugFlags.deviceTransferVerboseProgressLogging ? 1 : 10) else { return }
 
-        Logger.info("Transferring file \(self.file.identifier) \(currentWholeNumberProgress)%")
+        Logger.info("Transferring file \(self.identifier) \(currentWholeNumberProgress)%")
     }
 }
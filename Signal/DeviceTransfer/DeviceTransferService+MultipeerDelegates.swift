@@ -236,6 +236,17 @@ extension DeviceTransferService: MCSessionDelegate {
                 return Logger.info("Ignoring previously skipped file: \(fileIdentifier)")
             }
 
+            if DeviceTransferBatch.isBatchIdentifier(fileIdentifier) {
+                // The old device batches the manifest's files the same way,
+                // so we can work out what's in the batch before it arrives.
+                guard let batch = DeviceTransferBatch.batch(identifier: fileIdentifier, files: manifest.files) else {
+                    return owsFailDebug("Received unexpected batch on new device: \(fileIdentifier)")
+                }
+                Logger.info("Receiving batch: \(batch.identifier), estimatedSize: \(batch.estimatedSize)")
+                progress.addChild(fileProgress, withPendingUnitCount: Int64(batch.estimatedSize))
+                return
+            }
+
             guard let file: DeviceTransferProtoFile = {
                 switch fileIdentifier {
                 case DeviceTransferService.databaseIdentifier:
@@ -295,6 +306,10 @@ extension DeviceTransferService: MCSessionDelegate {
                 return Logger.info("Ignoring previously skipped file: \(fileIdentifier)")
             }
 
+            if DeviceTransferBatch.isBatchIdentifier(fileIdentifier) {
+                return handleReceivedBatch(identifier: fileIdentifier, hash: fileHash, at: localURL, error: error)
+            }
+
             guard let file: DeviceTransferProtoFile = {
                 switch fileIdentifier {
                 case DeviceTransferService.databaseIdentifier:
@@ -345,6 +360,45 @@ extension DeviceTransferService: MCSessionDelegate {
         }
     }
 
+    private func handleReceivedBatch(identifier: String, hash: String, at localURL: URL?, error: Swift.Error?) {
+        if let error = error {
+            return failTransfer(.assertion, "Failed to receive batch \(identifier) \(error)")
+        }
+        guard let localURL = localURL else {
+            return owsFailDebug("Unexpectedly completed transfer of resource with no URL or error")
+        }
+        defer { OWSFileSystem.deleteFileIfExists(localURL.path) }
+
+        guard let computedHash = try? Cryptography.computeSHA256DigestOfFile(at: localURL) else {
+            return failTransfer(.assertion, "Failed to compute hash for \(identifier)")
+        }
+
+        guard computedHash.hexadecimalString == hash else {
+            return failTransfer(.assertion, "Received batch with incorrect hash \(identifier)")
+        }
+
+        OWSFileSystem.ensureDirectoryExists(DeviceTransferService.pendingTransferFilesDirectory.path)
+
+        let extractedFileIds: (receivedFileIds: [String], missingFileIds: [String])
+        do {
+            extractedFileIds = try DeviceTransferBatch.extractArchive(
+                at: localURL,
+                to: DeviceTransferService.pendingTransferFilesDirectory
+            )
+        } catch {
+            return failTransfer(.assertion, "Failed to extract batch \(identifier) \(error)")
+        }
+
+        if !extractedFileIds.missingFileIds.isEmpty {
+            Logger.warn("Received notification of \(extractedFileIds.missingFileIds.count) missing files in \(identifier), skipping.")
+        }
+        Logger.info("Received batch: \(identifier) with \(extractedFileIds.receivedFileIds.count) files")
+        transferState = transferState.appendingFileIds(
+            extractedFileIds.receivedFileIds + [identifier],
+            skippedFileIds: extractedFileIds.missingFileIds
+        )
+    }
+
     func session(
         _ session: MCSession,
         didReceiveCertificate certificates: [Any]?,
@@ -58,6 +58,9 @@ extension DeviceTransferService {
             return false
         }
 
+        let receivedFileIds = Set(receivedFileIds)
+        let skippedFileIds = Set(skippedFileIds)
+
         // Check that there aren't any files that we were
         // expecting that are missing.
         for file in manifest.files {
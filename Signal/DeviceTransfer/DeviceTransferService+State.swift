@@ -58,6 +58,26 @@ extension DeviceTransferService {
             }
         }
 
+        /// Records the files received in a batch, all at once.
+        func appendingFileIds(_ fileIds: [String], skippedFileIds newSkippedFileIds: [String]) -> TransferState {
+            switch self {
+            case .incoming(let oldDevicePeerId, let manifest, let receivedFileIds, let skippedFileIds, let progress):
+                return .incoming(
+                    oldDevicePeerId: oldDevicePeerId,
+                    manifest: manifest,
+                    receivedFileIds: receivedFileIds + fileIds,
+                    skippedFileIds: skippedFileIds + newSkippedFileIds,
+                    progress: progress
+                )
+            case .outgoing:
+                owsFailDebug("unexpectedly tried to append received files on outgoing")
+                return self
+            case .idle:
+                owsFailDebug("unexpectedly tried to append files while idle")
+                return .idle
+            }
+        }
+
         func appendingSkippedFileId(_ fileId: String) -> TransferState {
             switch self {
             case .incoming(let oldDevicePeerId, let manifest, let receivedFileIds, let skippedFileIds, let progress):
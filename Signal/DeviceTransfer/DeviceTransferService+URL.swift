@@ -7,7 +7,9 @@ import MultipeerConnectivity
 import SignalServiceKit
 
 extension DeviceTransferService {
-    private static let currentTransferVersion = 1
+    /// Version 2 sends small files in batches (see `DeviceTransferBatch`),
+    /// which version 1 devices can't unpack.
+    private static let currentTransferVersion = 2
 
     private static let versionKey = "version"
     private static let peerIdKey = "peerId"
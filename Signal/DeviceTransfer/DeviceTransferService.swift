@@ -349,20 +349,43 @@ class DeviceTransferService: NSObject {
 
         promises.append(databaseTransferPromise)
 
-        // Make a copy of the database files within a write transaction so we can be confident
-        // they aren't mutated during the copy. We then transfer these copies.
-        databaseStorage.asyncWrite { _ in
+        // Take a snapshot of the database from a read transaction, so that
+        // writers aren't held off while it's made. We then transfer the
+        // snapshot.
+        DispatchQueue.global(qos: .userInitiated).async {
             do {
-                let dbCopy = try Self.makeLocalCopy(databaseFile: database.database)
-                let walCopy = try Self.makeLocalCopy(databaseFile: database.wal)
+                let dbCopy = try self.makeSnapshot(databaseFile: database.database)
+                let walCopy = try Self.makeEmptyCopy(databaseFile: database.wal)
                 databaseCopyFuture.resolve(.init(db: dbCopy, wal: walCopy))
+                return
             } catch {
-                Logger.error("Failed to copy database files!")
-                databaseCopyFuture.reject(error)
+                Logger.warn("Failed to snapshot database, copying files instead: \(error)")
             }
+
+            // Make a copy of the database files within a write transaction so we can be confident
+            // they aren't mutated during the copy. We then transfer these copies.
+            self.databaseStorage.asyncWrite { _ in
+                do {
+                    let dbCopy = try Self.makeLocalCopy(databaseFile: database.database)
+                    let walCopy = try Self.makeLocalCopy(databaseFile: database.wal)
+                    databaseCopyFuture.resolve(.init(db: dbCopy, wal: walCopy))
+                } catch {
+                    Logger.error("Failed to copy database files!")
+                    databaseCopyFuture.reject(error)
+                }
+            }
+        }
+
+        // Small files are sent in batches, to save the overhead of sending
+        // each one separately.
+        let (batches, unbatchedFiles) = DeviceTransferBatch.makeBatches(files: manifest.files)
+        Logger.info("Sending \(manifest.files.count) files, \(unbatchedFiles.count) individually and the rest in \(batches.count) batches")
+
+        for batch in batches {
+            promises.append(DeviceTransferOperation.scheduleTransfer(batch: batch))
         }
 
-        for file in manifest.files {
+        for file in unbatchedFiles {
             promises.append(DeviceTransferOperation.scheduleTransfer(file: file))
         }
 
@@ -427,6 +450,44 @@ class DeviceTransferService: NSObject {
         return protoBuilder.buildInfallibly()
     }
 
+    /// Writes a snapshot of the database to the copy location for
+    /// `databaseFile`. See `GRDBDatabaseStorageAdapter.writeSnapshot(to:keyFetcher:)`.
+    private func makeSnapshot(
+        databaseFile: DeviceTransferProtoFile
+    ) throws -> DeviceTransferProtoFile {
+        let copyUrl = try Self.urlForCopy(databaseFile: databaseFile)
+
+        if OWSFileSystem.fileOrFolderExists(url: copyUrl) {
+            // We might have partially copied before. Delete it.
+            try OWSFileSystem.deleteFile(url: copyUrl)
+        }
+        do {
+            try databaseStorage.grdbStorage.writeSnapshot(to: copyUrl, keyFetcher: databaseStorage.keyFetcher)
+        } catch {
+            try? OWSFileSystem.deleteFileIfExists(url: copyUrl)
+            throw error
+        }
+
+        var protoBuilder = databaseFile.asBuilder()
+        protoBuilder.setRelativePath(copyUrl.relativePath)
+        return protoBuilder.buildInfallibly()
+    }
+
+    /// Creates an empty file at the copy location for `databaseFile`.
+    ///
+    /// Database snapshots have no WAL, but the new device expects to receive
+    /// one, so an empty one is sent in its place.
+    private static func makeEmptyCopy(
+        databaseFile: DeviceTransferProtoFile
+    ) throws -> DeviceTransferProtoFile {
+        let copyUrl = try Self.urlForCopy(databaseFile: databaseFile)
+        try Data().write(to: copyUrl)
+
+        var protoBuilder = databaseFile.asBuilder()
+        protoBuilder.setRelativePath(copyUrl.relativePath)
+        return protoBuilder.buildInfallibly()
+    }
+
     static let doneMessage = "Transfer Complete".data(using: .utf8)!
     func sendDoneMessage(to peerId: MCPeerID) throws {
         Logger.info("Sending done message")
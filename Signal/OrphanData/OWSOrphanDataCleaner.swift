@@ -309,6 +309,11 @@ enum OWSOrphanDataCleaner {
     private static func findOrphanDataSync() -> OWSOrphanData? {
         var shouldAbort = false
 
+        let fileManifest = OrphanDataFileManifest()
+        func filePaths(inDirectorySafe dirPath: String) -> Set<String>? {
+            return fileManifest.filePaths(inDirectory: dirPath, shouldContinue: { isMainAppAndActive })
+        }
+
         let legacyAttachmentsDirPath = TSAttachmentStream.legacyAttachmentsDirPath()
         let sharedDataAttachmentsDirPath = TSAttachmentStream.sharedDataAttachmentsDirPath()
         guard let legacyAttachmentFilePaths = filePaths(inDirectorySafe: legacyAttachmentsDirPath), isMainAppAndActive else {
@@ -336,6 +341,9 @@ enum OWSOrphanDataCleaner {
             return nil
         }
 
+        fileManifest.forgetUnvisitedDirectories()
+        Logger.info("Listed \(fileManifest.listedDirectoryCount) directories, reused \(fileManifest.reusedDirectoryCount) unchanged directories.")
+
         let allOnDiskFilePaths: Set<String> = {
             var result: Set<String> = []
             result.formUnion(legacyAttachmentFilePaths)
@@ -916,41 +924,4 @@ enum OWSOrphanDataCleaner {
             return nil
         }
     }
-
-    private static func filePaths(inDirectorySafe dirPath: String) -> Set<String>? {
-        guard FileManager.default.fileExists(atPath: dirPath) else {
-            return []
-        }
-        do {
-            var result: Set<String> = []
-            let fileNames = try FileManager.default.contentsOfDirectory(atPath: dirPath)
-            for fileName in fileNames {
-                guard isMainAppAndActive else {
-                    return nil
-                }
-                let filePath = dirPath.appendingPathComponent(fileName)
-                var isDirectory: ObjCBool = false
-                if FileManager.default.fileExists(atPath: filePath, isDirectory: &isDirectory) {
-                    if isDirectory.boolValue {
-                        guard let dirPaths = filePaths(inDirectorySafe: filePath) else {
-                            return nil
-                        }
-                        result.formUnion(dirPaths)
-                    } else {
-                        result.insert(filePath)
-                    }
-                }
-            }
-            return result
-        } catch {
-            switch error {
-            case POSIXError.ENOENT, CocoaError.fileReadNoSuchFile:
-                // Races may cause files to be removed while we crawl the directory contents.
-                Logger.warn("Error: \(error)")
-            default:
-                owsFailDebug("Error: \(error)")
-            }
-            return []
-        }
-    }
 }
@@ -0,0 +1,181 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import SignalServiceKit
+
+/// Remembers the contents of the directories the orphan data cleaner audits,
+/// so that later audits only list the directories that have changed.
+///
+/// Adding, removing or renaming a file updates the modification date of the
+/// directory that contains it, so a directory whose modification date hasn't
+/// changed since it was last listed still contains the same files. Audits
+/// still check each directory's date, but that's one `stat` per directory
+/// rather than a listing plus a `stat` per file.
+///
+/// The manifest is saved as directories are listed, including when a scan is
+/// aborted because the app resigned active, so the next scan resumes rather
+/// than starting over.
+final class OrphanDataFileManifest {
+
+    private struct DirectoryEntry: Codable {
+        var modificationDate: Date
+        var fileNames: [String]
+        var subdirectoryNames: [String]
+    }
+
+    /// Directories modified this recently aren't remembered, since a file
+    /// could be added within the resolution of their modification date.
+    private static let minimumDirectoryAge: TimeInterval = 2
+
+    /// How many directories are listed between saves.
+    private static let saveInterval = 1000
+
+    private let manifestUrl: URL
+    private let dateProvider: DateProvider
+
+    /// Directories listed by previous scans, keyed by path.
+    private var directories: [String: DirectoryEntry]
+    private var unsavedDirectoryCount = 0
+    /// Directories seen by this instance's scans.
+    private var visitedDirectoryPaths = Set<String>()
+
+    private(set) var listedDirectoryCount = 0
+    private(set) var reusedDirectoryCount = 0
+
+    static var defaultManifestUrl: URL {
+        URL(fileURLWithPath: OWSFileSystem.cachesDirectoryPath()).appendingPathComponent("OrphanDataFileManifest.json")
+    }
+
+    init(manifestUrl: URL = defaultManifestUrl, dateProvider: @escaping DateProvider = Date.provider) {
+        self.manifestUrl = manifestUrl
+        self.dateProvider = dateProvider
+        self.directories = Self.load(from: manifestUrl)
+    }
+
+    private static func load(from manifestUrl: URL) -> [String: DirectoryEntry] {
+        guard OWSFileSystem.fileOrFolderExists(url: manifestUrl) else {
+            return [:]
+        }
+        do {
+            return try JSONDecoder().decode([String: DirectoryEntry].self, from: Data(contentsOf: manifestUrl))
+        } catch {
+            Logger.warn("Discarding unreadable orphan data manifest: \(error)")
+            return [:]
+        }
+    }
+
+    func save() {
+        unsavedDirectoryCount = 0
+        do {
+            try JSONEncoder().encode(directories).write(to: manifestUrl, options: .atomic)
+        } catch {
+            owsFailDebug("Couldn't save orphan data manifest: \(error)")
+        }
+    }
+
+    /// Returns the paths of all files within `directoryPath` and its
+    /// subdirectories, or nil if `shouldContinue` returned false first.
+    func filePaths(inDirectory directoryPath: String, shouldContinue: () -> Bool) -> Set<String>? {
+        var result = Set<String>()
+        let didComplete = collectFilePaths(inDirectory: directoryPath, into: &result, shouldContinue: shouldContinue)
+        save()
+        return didComplete ? result : nil
+    }
+
+    private func collectFilePaths(
+        inDirectory directoryPath: String,
+        into result: inout Set<String>,
+        shouldContinue: () -> Bool
+    ) -> Bool {
+        guard shouldContinue() else {
+            return false
+        }
+
+        let directoryUrl = URL(fileURLWithPath: directoryPath)
+        guard let modificationDate = try? directoryUrl.resourceValues(forKeys: [.contentModificationDateKey]).contentModificationDate else {
+            // The directory doesn't exist (anymore).
+            return true
+        }
+        visitedDirectoryPaths.insert(directoryPath)
+
+        let entry: DirectoryEntry
+        if let cachedEntry = directories[directoryPath], cachedEntry.modificationDate == modificationDate {
+            entry = cachedEntry
+            reusedDirectoryCount += 1
+        } else if let listedEntry = listDirectory(directoryUrl, modificationDate: modificationDate) {
+            entry = listedEntry
+            listedDirectoryCount += 1
+            if dateProvider().timeIntervalSince(modificationDate) >= Self.minimumDirectoryAge {
+                directories[directoryPath] = entry
+                unsavedDirectoryCount += 1
+                if unsavedDirectoryCount >= Self.saveInterval {
+                    save()
+                }
+            } else {
+                directories[directoryPath] = nil
+            }
+        } else {
+            return true
+        }
+
+        for fileName in entry.fileNames {
+            result.insert(directoryPath.appendingPathComponent(fileName))
+        }
+        for subdirectoryName in entry.subdirectoryNames {
+            let subdirectoryPath = directoryPath.appendingPathComponent(subdirectoryName)
+            guard collectFilePaths(inDirectory: subdirectoryPath, into: &result, shouldContinue: shouldContinue) else {
+                return false
+            }
+        }
+        return true
+    }
+
+    private func listDirectory(_ directoryUrl: URL, modificationDate: Date) -> DirectoryEntry? {
+        let contents: [URL]
+        do {
+            // Asking for the directory key up front lets the file system
+            // return it along with the listing, instead of a `stat` per file.
+            contents = try FileManager.default.contentsOfDirectory(
+                at: directoryUrl,
+                includingPropertiesForKeys: [.isDirectoryKey],
+                options: []
+            )
+        } catch {
+            switch error {
+            case POSIXError.ENOENT, CocoaError.fileReadNoSuchFile:
+                // Races may cause files to be removed while we crawl the directory contents.
+                Logger.warn("Error: \(error)")
+            default:
+                owsFailDebug("Error: \(error)")
+            }
+            return nil
+        }
+
+        var entry = DirectoryEntry(modificationDate: modificationDate, fileNames: [], subdirectoryNames: [])
+        for url in contents {
+            guard let isDirectory = try? url.resourceValues(forKeys: [.isDirectoryKey]).isDirectory else {
+                continue
+            }
+            if isDirectory {
+                entry.subdirectoryNames.append(url.lastPathComponent)
+            } else {
+                entry.fileNames.append(url.lastPathComponent)
+            }
+        }
+        return entry
+    }
+
+    /// Forgets directories that weren't seen by this instance's scans, such
+    /// as directories that have been removed. Only call this after every
+    /// directory the manifest is used for has been scanned to completion.
+    func forgetUnvisitedDirectories() {
+        let oldCount = directories.count
+        directories = directories.filter { visitedDirectoryPaths.contains($0.key) }
+        if directories.count != oldCount {
+            save()
+        }
+    }
+}
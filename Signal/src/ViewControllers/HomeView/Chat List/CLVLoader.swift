@@ -59,11 +59,20 @@ enum CLVLoadResult {
 
 public class CLVLoader: Dependencies {
 
-    static func loadRenderStateForReset(viewInfo: CLVViewInfo, transaction: SDSAnyReadTransaction) -> CLVLoadResult {
+    /// Unpinned threads are loaded this many at a time, starting with the
+    /// most recently active. The next page is loaded as the user scrolls
+    /// towards the end of the loaded threads.
+    static let pageSize = 100
+
+    static func loadRenderStateForReset(viewInfo: CLVViewInfo,
+                                        unpinnedThreadLimit: Int,
+                                        transaction: SDSAnyReadTransaction) -> CLVLoadResult {
         AssertIsOnMainThread()
 
         do {
-            let renderState = try Self.loadRenderStateInternal(viewInfo: viewInfo, transaction: transaction)
+            let renderState = try Self.loadRenderStateInternal(viewInfo: viewInfo,
+                                                               unpinnedThreadLimit: unpinnedThreadLimit,
+                                                               transaction: transaction)
             return CLVLoadResult.renderStateForReset(renderState: renderState)
         } catch {
             owsFailDebug("error: \(error)")
@@ -72,6 +81,7 @@ public class CLVLoader: Dependencies {
     }
 
     private static func loadRenderStateInternal(viewInfo: CLVViewInfo,
+                                                unpinnedThreadLimit: Int,
                                                 transaction: SDSAnyReadTransaction) throws -> CLVRenderState {
 
         let threadFinder = ThreadFinder()
@@ -79,32 +89,37 @@ public class CLVLoader: Dependencies {
 
         var pinnedThreads = [TSThread]()
         var threads = [TSThread]()
+        var hasMoreUnpinnedThreads = false
 
-        let pinnedThreadIds = DependenciesBridge.shared.pinnedThreadStore.pinnedThreadIds(tx: transaction.asV2Read)
+        // Pinned threads only have their own section in the inbox.
+        let pinnedThreadIds: [String]
+        if isViewingArchive {
+            pinnedThreadIds = []
+        } else {
+            pinnedThreadIds = DependenciesBridge.shared.pinnedThreadStore.pinnedThreadIds(tx: transaction.asV2Read)
+        }
 
         func buildRenderState() -> CLVRenderState {
             // Pinned threads are always ordered in the order they were pinned.
-            let pinnedThreadsFinal: OrderedDictionary<String, TSThread>
-            if isViewingArchive {
-                pinnedThreadsFinal = OrderedDictionary()
-            } else {
-                let existingPinnedThreadIds = pinnedThreads.map { $0.uniqueId }
-                pinnedThreadsFinal = OrderedDictionary(
-                    keyValueMap: Dictionary(uniqueKeysWithValues: pinnedThreads.map { ($0.uniqueId, $0) }),
-                    orderedKeys: pinnedThreadIds.filter { existingPinnedThreadIds.contains($0) }
-                )
-            }
+            let existingPinnedThreadIds = pinnedThreads.map { $0.uniqueId }
+            let pinnedThreadsFinal = OrderedDictionary(
+                keyValueMap: Dictionary(uniqueKeysWithValues: pinnedThreads.map { ($0.uniqueId, $0) }),
+                orderedKeys: pinnedThreadIds.filter { existingPinnedThreadIds.contains($0) }
+            )
             let unpinnedThreadsFinal = threads
 
             return CLVRenderState(viewInfo: viewInfo,
                                  pinnedThreads: pinnedThreadsFinal,
-                                 unpinnedThreads: unpinnedThreadsFinal)
+                                 unpinnedThreads: unpinnedThreadsFinal,
+                                 hasMoreUnpinnedThreads: hasMoreUnpinnedThreads)
         }
 
         // This method is a perf hotspot. To improve perf, we try to leverage
         // the model cache. If any problems arise, we fall back to using
         // threadFinder.enumerateVisibleThreads() which is robust but expensive.
         func loadWithoutCache() throws {
+            pinnedThreads = []
+            threads = []
             try threadFinder.enumerateVisibleThreads(isArchived: isViewingArchive, transaction: transaction) { thread in
                 if pinnedThreadIds.contains(thread.uniqueId) {
                     pinnedThreads.append(thread)
@@ -112,102 +127,168 @@ public class CLVLoader: Dependencies {
                     threads.append(thread)
                 }
             }
+            hasMoreUnpinnedThreads = threads.count > unpinnedThreadLimit
+            threads = Array(threads.prefix(unpinnedThreadLimit))
+        }
+
+        // 1. Fetch the uniqueIds for the first page(s) of unpinned threads.
+        //    Fetch one extra to find out whether there are more.
+        var threadIds = try threadFinder.visibleThreadIds(isArchived: isViewingArchive,
+                                                          excludingThreadIds: pinnedThreadIds,
+                                                          after: nil,
+                                                          limit: unpinnedThreadLimit + 1,
+                                                          transaction: transaction)
+        hasMoreUnpinnedThreads = threadIds.count > unpinnedThreadLimit
+        threadIds = Array(threadIds.prefix(unpinnedThreadLimit))
+
+        // 2. Load the pinned threads, and drop any that shouldn't be visible.
+        for thread in try loadThreads(threadIds: pinnedThreadIds, transaction: transaction).values {
+            guard thread.shouldThreadBeVisible else {
+                continue
+            }
+            guard !ThreadAssociatedData.fetchOrDefault(for: thread, transaction: transaction).isArchived else {
+                continue
+            }
+            pinnedThreads.append(thread)
         }
 
-        // Loading the mapping from the cache has the following steps:
-        //
-        // 1. Fetch the uniqueIds for the visible threads.
-        let threadIds = try threadFinder.visibleThreadIds(isArchived: isViewingArchive, transaction: transaction)
         guard !threadIds.isEmpty else {
             return buildRenderState()
         }
 
-        // 2. Try to pull as many threads as possible from the cache.
+        // 3. Load the unpinned threads.
+        let threadIdToModelMap = try loadThreads(threadIds: threadIds, transaction: transaction)
+        guard threadIds.count == threadIdToModelMap.count else {
+            owsFailDebug("Missing threads.")
+            try loadWithoutCache()
+            return buildRenderState()
+        }
+
+        // 4. Build the ordered list of threads.
+        threads = threadIds.compactMap { threadIdToModelMap[$0] }
+
+        return buildRenderState()
+    }
+
+    /// Loads threads, pulling as many as possible from the cache. Threads
+    /// that don't exist are omitted.
+    private static func loadThreads(threadIds: [String],
+                                    transaction: SDSAnyReadTransaction) throws -> [String: TSThread] {
+        guard !threadIds.isEmpty else {
+            return [:]
+        }
+
+        // Try to pull as many threads as possible from the cache.
         var threadIdToModelMap: [String: TSThread] = modelReadCaches.threadReadCache.getThreadsIfInCache(forUniqueIds: threadIds,
                                                                                                          transaction: transaction)
         var threadsToLoad = Set(threadIds)
         threadsToLoad.subtract(threadIdToModelMap.keys)
 
-        // 3. Bulk load any threads that are not in the cache in a
-        //    single query.
+        // Bulk load any threads that are not in the cache, in as few queries
+        // as possible.
         //
         // NOTE: There's an upper bound on how long SQL queries should be.
         //       We use kMaxIncrementalRowChanges to limit query size.
-        guard threadsToLoad.count <= DatabaseChangeObserver.kMaxIncrementalRowChanges else {
-            try loadWithoutCache()
-            return buildRenderState()
-        }
-
-        if !threadsToLoad.isEmpty {
-            let loadedThreads = try threadFinder.threads(withThreadIds: threadsToLoad, transaction: transaction)
-            guard loadedThreads.count == threadsToLoad.count else {
-                owsFailDebug("Loading threads failed.")
-                try loadWithoutCache()
-                return buildRenderState()
-            }
+        for batch in Array(threadsToLoad).chunked(by: DatabaseChangeObserver.kMaxIncrementalRowChanges) {
+            let loadedThreads = try ThreadFinder().threads(withThreadIds: Set(batch), transaction: transaction)
             for thread in loadedThreads {
                 threadIdToModelMap[thread.uniqueId] = thread
             }
         }
 
-        guard threadIds.count == threadIdToModelMap.count else {
-            owsFailDebug("Missing threads.")
-            try loadWithoutCache()
-            return buildRenderState()
+        return threadIdToModelMap
+    }
+
+    /// Appends the next page of unpinned threads to `lastRenderState`.
+    static func loadRenderStateWithNextPage(lastRenderState: CLVRenderState,
+                                            viewInfo: CLVViewInfo,
+                                            transaction: SDSAnyReadTransaction) -> CLVLoadResult {
+        guard lastRenderState.hasMoreUnpinnedThreads, let lastThread = lastRenderState.unpinnedThreads.last else {
+            return .noChanges
         }
 
-        // 4. Build the ordered list of threads.
-        for threadId in threadIds {
-            guard let thread = threadIdToModelMap[threadId] else {
-                owsFailDebug("Couldn't read thread: \(threadId)")
-                try loadWithoutCache()
-                return buildRenderState()
+        do {
+            let isViewingArchive = viewInfo.chatListMode == .archive
+            let pinnedThreadIds: [String]
+            if isViewingArchive {
+                pinnedThreadIds = []
+            } else {
+                pinnedThreadIds = DependenciesBridge.shared.pinnedThreadStore.pinnedThreadIds(tx: transaction.asV2Read)
             }
 
-            if !isViewingArchive && pinnedThreadIds.contains(thread.uniqueId) {
-                pinnedThreads.append(thread)
+            var threadIds = try ThreadFinder().visibleThreadIds(isArchived: isViewingArchive,
+                                                                excludingThreadIds: pinnedThreadIds,
+                                                                after: lastThread,
+                                                                limit: pageSize + 1,
+                                                                transaction: transaction)
+            let hasMoreUnpinnedThreads = threadIds.count > pageSize
+            threadIds = Array(threadIds.prefix(pageSize))
+            // The page is keyed on the last thread as of the last load; if it
+            // has moved since, the pages can overlap.
+            let existingThreadIds = Set(lastRenderState.unpinnedThreads.map { $0.uniqueId })
+            threadIds.removeAll { existingThreadIds.contains($0) }
+
+            let threadIdToModelMap = try loadThreads(threadIds: threadIds, transaction: transaction)
+            guard threadIds.count == threadIdToModelMap.count else {
+                throw OWSAssertionError("Missing threads.")
+            }
+            let newThreads = threadIds.compactMap { threadIdToModelMap[$0] }
+
+            let newRenderState = CLVRenderState(viewInfo: viewInfo,
+                                                pinnedThreads: lastRenderState.pinnedThreads,
+                                                unpinnedThreads: lastRenderState.unpinnedThreads + newThreads,
+                                                hasMoreUnpinnedThreads: hasMoreUnpinnedThreads)
+            let firstNewRow = lastRenderState.unpinnedThreads.count
+            let rowChanges = newThreads.enumerated().map { (offset, thread) in
+                CLVRowChange(type: .insert(newIndexPath: IndexPath(row: firstNewRow + offset,
+                                                                   section: ChatListSection.unpinned.rawValue)),
+                             threadUniqueId: thread.uniqueId)
+            }
+            if rowChanges.isEmpty {
+                return .renderStateWithoutRowChanges(renderState: newRenderState)
             } else {
-                threads.append(thread)
+                return .renderStateWithRowChanges(renderState: newRenderState, rowChanges: rowChanges)
             }
+        } catch {
+            owsFailDebug("Error: \(error)")
+            return loadRenderStateForReset(viewInfo: viewInfo,
+                                           unpinnedThreadLimit: lastRenderState.unpinnedThreads.count + pageSize,
+                                           transaction: transaction)
         }
-
-        return buildRenderState()
     }
 
     static func loadRenderStateAndDiff(viewInfo: CLVViewInfo,
                                        updatedItemIds: Set<String>,
                                        lastRenderState: CLVRenderState,
+                                       unpinnedThreadLimit: Int,
                                        transaction: SDSAnyReadTransaction) -> CLVLoadResult {
         do {
             return try loadRenderStateAndDiffInternal(viewInfo: viewInfo,
                                                       updatedItemIds: updatedItemIds,
                                                       lastRenderState: lastRenderState,
+                                                      unpinnedThreadLimit: unpinnedThreadLimit,
                                                       transaction: transaction)
         } catch {
             owsFailDebug("Error: \(error)")
             // Fail over to reloading the table view with a new render state.
-            return loadRenderStateForReset(viewInfo: viewInfo, transaction: transaction)
+            return loadRenderStateForReset(viewInfo: viewInfo,
+                                           unpinnedThreadLimit: unpinnedThreadLimit,
+                                           transaction: transaction)
         }
     }
 
     private static func loadRenderStateAndDiffInternal(viewInfo: CLVViewInfo,
                                                        updatedItemIds allUpdatedItemIds: Set<String>,
                                                        lastRenderState: CLVRenderState,
+                                                       unpinnedThreadLimit: Int,
                                                        transaction: SDSAnyReadTransaction) throws -> CLVLoadResult {
 
-        // Ignore updates to non-visible threads.
-        var updatedItemIds = Set<String>()
-        for threadId in allUpdatedItemIds {
-            guard let thread = TSThread.anyFetch(uniqueId: threadId, transaction: transaction) else {
-                // Missing thread, it was deleted and should no longer be visible.
-                continue
-            }
-            if thread.shouldThreadBeVisible {
-                updatedItemIds.insert(threadId)
-            }
-        }
-
-        let newRenderState = try Self.loadRenderStateInternal(viewInfo: viewInfo, transaction: transaction)
+        // Updates to threads that aren't visible (or aren't loaded yet) are
+        // ignored by the diff below, which only considers changed threads
+        // that are in the new render state.
+        let newRenderState = try Self.loadRenderStateInternal(viewInfo: viewInfo,
+                                                              unpinnedThreadLimit: unpinnedThreadLimit,
+                                                              transaction: transaction)
 
         let oldPinnedThreadIds: [String] = lastRenderState.pinnedThreads.orderedKeys
         let oldUnpinnedThreadIds: [String] = lastRenderState.unpinnedThreads.map { $0.uniqueId }
@@ -11,6 +11,9 @@ public class CLVRenderState {
 
     let pinnedThreads: OrderedDictionary<String, TSThread>
     let unpinnedThreads: [TSThread]
+    /// Unpinned threads are loaded a page at a time; this is set if there are
+    /// more threads after `unpinnedThreads`.
+    let hasMoreUnpinnedThreads: Bool
 
     var archiveCount: UInt { viewInfo.archiveCount }
     var inboxCount: UInt { viewInfo.inboxCount }
@@ -24,16 +27,19 @@ public class CLVRenderState {
 
     public init(viewInfo: CLVViewInfo,
                 pinnedThreads: OrderedDictionary<String, TSThread>,
-                unpinnedThreads: [TSThread]) {
+                unpinnedThreads: [TSThread],
+                hasMoreUnpinnedThreads: Bool) {
         self.viewInfo = viewInfo
         self.pinnedThreads = pinnedThreads
         self.unpinnedThreads = unpinnedThreads
+        self.hasMoreUnpinnedThreads = hasMoreUnpinnedThreads
     }
 
     public static var empty: CLVRenderState {
         CLVRenderState(viewInfo: .empty,
                       pinnedThreads: OrderedDictionary(),
-                      unpinnedThreads: [])
+                      unpinnedThreads: [],
+                      hasMoreUnpinnedThreads: false)
     }
 
     public var hasPinnedAndUnpinnedThreads: Bool {
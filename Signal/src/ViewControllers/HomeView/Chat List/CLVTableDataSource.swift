@@ -483,6 +483,18 @@ extension CLVTableDataSource: UITableViewDelegate {
         viewController?.updateCellVisibility(cell: cell, isCellVisible: true)
 
         preloadCellsIfNecessary()
+        loadNextPageIfNecessary(displayedIndexPath: indexPath)
+    }
+
+    private func loadNextPageIfNecessary(displayedIndexPath indexPath: IndexPath) {
+        guard
+            renderState.hasMoreUnpinnedThreads,
+            indexPath.section == ChatListSection.unpinned.rawValue,
+            indexPath.row >= renderState.unpinnedThreads.count - CLVLoader.pageSize / 2
+        else {
+            return
+        }
+        viewController?.loadCoordinator.scheduleLoadNextPage()
     }
 
     public func tableView(
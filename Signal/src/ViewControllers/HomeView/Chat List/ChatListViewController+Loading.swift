@@ -57,14 +57,27 @@ extension ChatListViewController {
     // MARK: -
 
     fileprivate func loadRenderStateForReset(viewInfo: CLVViewInfo,
+                                             unpinnedThreadLimit: Int,
                                              transaction: SDSAnyReadTransaction) -> CLVLoadResult {
         AssertIsOnMainThread()
 
-        return CLVLoader.loadRenderStateForReset(viewInfo: viewInfo, transaction: transaction)
+        return CLVLoader.loadRenderStateForReset(viewInfo: viewInfo,
+                                                 unpinnedThreadLimit: unpinnedThreadLimit,
+                                                 transaction: transaction)
+    }
+
+    fileprivate func loadNewRenderStateWithNextPage(viewInfo: CLVViewInfo,
+                                                    transaction: SDSAnyReadTransaction) -> CLVLoadResult {
+        AssertIsOnMainThread()
+
+        return CLVLoader.loadRenderStateWithNextPage(lastRenderState: renderState,
+                                                     viewInfo: viewInfo,
+                                                     transaction: transaction)
     }
 
     fileprivate func loadNewRenderStateWithDiff(viewInfo: CLVViewInfo,
                                                 updatedThreadIds: Set<String>,
+                                                unpinnedThreadLimit: Int,
                                                 transaction: SDSAnyReadTransaction) -> CLVLoadResult {
         AssertIsOnMainThread()
 
@@ -77,6 +90,7 @@ extension ChatListViewController {
         return CLVLoader.loadRenderStateAndDiff(viewInfo: viewInfo,
                                                updatedItemIds: updatedThreadIds,
                                                lastRenderState: renderState,
+                                               unpinnedThreadLimit: unpinnedThreadLimit,
                                                transaction: transaction)
     }
 
@@ -201,6 +215,7 @@ extension ChatListViewController {
 private enum CLVLoadType {
     case resetAll
     case incrementalDiff(updatedThreadIds: Set<String>)
+    case nextPage
     case reloadTableOnly
     case none
 }
@@ -214,33 +229,52 @@ public class CLVLoadCoordinator: Dependencies {
     private struct CLVLoadInfo {
         let viewInfo: CLVViewInfo
         let loadType: CLVLoadType
+        /// How many unpinned threads a reset or diff should load.
+        let unpinnedThreadLimit: Int
     }
     private class CLVLoadInfoBuilder {
         var shouldResetAll = false
+        var shouldLoadNextPage = false
         var updatedThreadIds = Set<String>()
 
         func build(chatListMode: ChatListMode,
                    hasVisibleReminders: Bool,
                    canApplyRowChanges: Bool,
                    lastViewInfo: CLVViewInfo,
+                   lastUnpinnedThreadCount: Int,
                    transaction: SDSAnyReadTransaction) -> CLVLoadInfo {
             let viewInfo = CLVViewInfo.build(chatListMode: chatListMode,
                                             hasVisibleReminders: hasVisibleReminders,
                                             transaction: transaction)
+            // Keep however many threads are already loaded, unless we're
+            // switching between the inbox and the archive.
+            let unpinnedThreadLimit: Int
+            if viewInfo.chatListMode != lastViewInfo.chatListMode {
+                unpinnedThreadLimit = CLVLoader.pageSize
+            } else {
+                let nextPageSize = shouldLoadNextPage ? CLVLoader.pageSize : 0
+                unpinnedThreadLimit = max(CLVLoader.pageSize, lastUnpinnedThreadCount + nextPageSize)
+            }
+            func loadInfo(_ loadType: CLVLoadType) -> CLVLoadInfo {
+                CLVLoadInfo(viewInfo: viewInfo, loadType: loadType, unpinnedThreadLimit: unpinnedThreadLimit)
+            }
+
             if shouldResetAll ||
                 viewInfo.hasArchivedThreadsRow != lastViewInfo.hasArchivedThreadsRow ||
                 viewInfo.hasVisibleReminders != lastViewInfo.hasVisibleReminders {
-                return CLVLoadInfo(viewInfo: viewInfo, loadType: .resetAll)
+                return loadInfo(.resetAll)
             } else if !updatedThreadIds.isEmpty {
                 if canApplyRowChanges {
-                    return CLVLoadInfo(viewInfo: viewInfo, loadType: .incrementalDiff(updatedThreadIds: updatedThreadIds))
+                    return loadInfo(.incrementalDiff(updatedThreadIds: updatedThreadIds))
                 } else {
-                    return CLVLoadInfo(viewInfo: viewInfo, loadType: .resetAll)
+                    return loadInfo(.resetAll)
                 }
             } else if viewInfo != lastViewInfo {
-                return CLVLoadInfo(viewInfo: viewInfo, loadType: .reloadTableOnly)
+                return loadInfo(.reloadTableOnly)
+            } else if shouldLoadNextPage {
+                return loadInfo(.nextPage)
             } else {
-                return CLVLoadInfo(viewInfo: viewInfo, loadType: .none)
+                return loadInfo(.none)
             }
         }
     }
@@ -267,6 +301,23 @@ public class CLVLoadCoordinator: Dependencies {
         loadIfNecessary()
     }
 
+    /// Loads the next page of threads, if there is one. Called as the user
+    /// scrolls towards the end of the loaded threads.
+    public func scheduleLoadNextPage() {
+        AssertIsOnMainThread()
+
+        guard !loadInfoBuilder.shouldLoadNextPage else {
+            return
+        }
+        loadInfoBuilder.shouldLoadNextPage = true
+
+        // This is requested while the table view is displaying cells, so
+        // don't change its contents until that's done.
+        DispatchQueue.main.async {
+            self.loadIfNecessary(suppressAnimations: true)
+        }
+    }
+
     public func ensureFirstLoad() {
         AssertIsOnMainThread()
 
@@ -328,6 +379,7 @@ public class CLVLoadCoordinator: Dependencies {
                                                  hasVisibleReminders: hasVisibleReminders,
                                                  canApplyRowChanges: canApplyRowChanges,
                                                  lastViewInfo: viewController.renderState.viewInfo,
+                                                 lastUnpinnedThreadCount: viewController.renderState.unpinnedThreads.count,
                                                  transaction: transaction)
             // Reset the builder.
             loadInfoBuilder = CLVLoadInfoBuilder()
@@ -338,12 +390,17 @@ public class CLVLoadCoordinator: Dependencies {
             switch loadInfo.loadType {
             case .resetAll:
                 return viewController.loadRenderStateForReset(viewInfo: loadInfo.viewInfo,
+                                                              unpinnedThreadLimit: loadInfo.unpinnedThreadLimit,
                                                               transaction: transaction)
             case .incrementalDiff(let updatedThreadIds):
                 owsAssertDebug(!updatedThreadIds.isEmpty)
                 return viewController.loadNewRenderStateWithDiff(viewInfo: loadInfo.viewInfo,
                                                                  updatedThreadIds: updatedThreadIds,
+                                                                 unpinnedThreadLimit: loadInfo.unpinnedThreadLimit,
                                                                  transaction: transaction)
+            case .nextPage:
+                return viewController.loadNewRenderStateWithNextPage(viewInfo: loadInfo.viewInfo,
+                                                                     transaction: transaction)
             case .reloadTableOnly:
                 return .reloadTable
             case .none:
@@ -153,7 +153,10 @@ extension ChatListViewController {
                 target: self,
                 action: #selector(performReadAll)
             )
-            readButton.isEnabled = hasUnreadEntry(threads: Array(renderState.pinnedThreads.orderedValues)) || hasUnreadEntry(threads: Array(renderState.unpinnedThreads))
+            // Not every thread is necessarily loaded, so ask the database.
+            readButton.isEnabled = !databaseStorage.read { tx in
+                InteractionFinder.unreadThreadIds(isArchived: chatListMode == .archive, transaction: tx)
+            }.isEmpty
         }
 
         let deleteBtn = UIBarButtonItem(title: CommonStrings.deleteButton, style: .plain, target: self, action: #selector(performDelete))
@@ -169,17 +172,6 @@ extension ChatListViewController {
         toolbar?.setItems(entries, animated: false)
     }
 
-    private func hasUnreadEntry(threads: [TSThread]? = nil) -> Bool {
-        if let entries = threads {
-            for entry in entries {
-                if tableDataSource.threadViewModel(forThread: entry).hasUnreadMessages {
-                    return true
-                }
-            }
-        }
-        return false
-    }
-
     private func hideToolbar() {
         AssertIsOnMainThread()
 
@@ -246,8 +238,21 @@ extension ChatListViewController {
     @objc
     func performReadAll() {
         var entries: [ThreadViewModel] = []
-        var threads = Array(renderState.pinnedThreads.orderedValues)
-        threads.append(contentsOf: renderState.unpinnedThreads)
+        // Threads are loaded a page at a time, so the unread threads might
+        // not all be loaded yet.
+        let threads: [TSThread] = databaseStorage.read { tx in
+            let threadIds = InteractionFinder.unreadThreadIds(isArchived: chatListMode == .archive, transaction: tx)
+            var threads = [TSThread]()
+            // Stay well below SQLite's limit on the length of a statement.
+            for threadIdBatch in threadIds.chunked(by: 500) {
+                do {
+                    threads += try ThreadFinder().threads(withThreadIds: Set(threadIdBatch), transaction: tx)
+                } catch {
+                    owsFailDebug("Couldn't load unread threads: \(error)")
+                }
+            }
+            return threads
+        }
         for t in threads {
             let thread = tableDataSource.threadViewModel(forThread: t)
             if thread.hasUnreadMessages {
@@ -110,15 +110,42 @@ class MediaGalleryItem: Equatable, Hashable, MediaGallerySectionItem {
 
     var attachmentId: MediaGalleryResourceId { attachmentStream.reference.mediaGalleryResourceId }
 
+    /// Recently loaded small thumbnails, so that thumbnails prefetched while
+    /// scrolling are ready by the time their cells are displayed.
+    private static let thumbnailCache = LRUCache<MediaGalleryResourceId, UIImage>(
+        maxSize: 256,
+        shouldEvacuateInBackground: true
+    )
+
     typealias AsyncThumbnailBlock = @MainActor (UIImage) -> Void
     func thumbnailImage(completion: @escaping AsyncThumbnailBlock) {
-        Task { [attachmentStream] in
-            if let image = await attachmentStream.attachmentStream.thumbnailImage(quality: .small) {
+        Task {
+            if let image = await loadThumbnailImage() {
                 await completion(image)
             }
         }
     }
 
+    func prefetchThumbnailImage() {
+        guard Self.thumbnailCache.get(key: attachmentId) == nil else {
+            return
+        }
+        Task {
+            _ = await loadThumbnailImage()
+        }
+    }
+
+    private func loadThumbnailImage() async -> UIImage? {
+        if let image = Self.thumbnailCache.get(key: attachmentId) {
+            return image
+        }
+        guard let image = await attachmentStream.attachmentStream.thumbnailImage(quality: .small) else {
+            return nil
+        }
+        Self.thumbnailCache.set(key: attachmentId, value: image)
+        return image
+    }
+
     func thumbnailImageSync() -> UIImage? {
         return attachmentStream.attachmentStream.thumbnailImageSync(quality: .small)
     }
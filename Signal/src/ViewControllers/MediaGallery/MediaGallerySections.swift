@@ -847,6 +847,9 @@ internal struct MediaGallerySections<Loader: MediaGallerySectionLoader, UpdateUs
         // It's important that this lock be fair so that synchronous mutations run as soon as possible.
         private let lock = NSLock()
 
+        private let syncMutationMetric = PerformanceMetrics.shared.histogram("mediaGallery.syncMutation")
+        private let asyncMutationMetric = PerformanceMetrics.shared.histogram("mediaGallery.asyncMutation")
+
         var state: State {
             dispatchPrecondition(condition: .onQueue(.main))
             return snapshot
@@ -882,7 +885,7 @@ internal struct MediaGallerySections<Loader: MediaGallerySectionLoader, UpdateUs
 
         func mutate<T>(userData: UpdateUserData?, _ block: (inout State) -> (T)) -> T {
             dispatchPrecondition(condition: .onQueue(.main))
-            return Bench(title: "Sync mutation [\(depthReport)]", logIfLongerThan: 0.1, logInProduction: true) {
+            return Bench(title: "Sync mutation [\(depthReport)]", metric: syncMutationMetric, logIfLongerThan: 0.1, logInProduction: true) {
                 return self._mutate(userData: userData, block)
             }
         }
@@ -917,7 +920,11 @@ internal struct MediaGallerySections<Loader: MediaGallerySectionLoader, UpdateUs
                     return
                 }
                 dispatchPrecondition(condition: .onQueue(self.queue))
-                Bench(title: "Async mutation of \(title ?? "untitled") [\(self.depthReport)]", logInProduction: true) {
+                Bench(
+                    title: "Async mutation of \(title ?? "untitled") [\(self.depthReport)]",
+                    metric: self.asyncMutationMetric,
+                    logInProduction: true
+                ) {
                     let result = self._mutate(userData: userData, block)
                     DispatchQueue.main.async {
                         completion(result)
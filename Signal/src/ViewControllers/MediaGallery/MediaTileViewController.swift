@@ -244,6 +244,7 @@ class MediaTileViewController: UICollectionViewController, MediaGalleryDelegate,
             withReuseIdentifier: MediaGalleryEmptyContentView.reuseIdentifier
         )
         collectionView.delegate = self
+        collectionView.prefetchDataSource = self
         collectionView.alwaysBounceVertical = true
         collectionView.preservesSuperviewLayoutMargins = true
         collectionView.backgroundColor = UIColor(dynamicProvider: { _ in Theme.tableView2PresentedBackgroundColor })
@@ -1213,6 +1214,36 @@ class MediaTileViewController: UICollectionViewController, MediaGalleryDelegate,
     }
 }
 
+// MARK: - UICollectionViewDataSourcePrefetching
+
+extension MediaTileViewController: UICollectionViewDataSourcePrefetching {
+
+    // The collection view asks for the items just beyond the visible ones in
+    // the direction of scrolling. Load those items (in batches, as for
+    // visible cells) and warm their thumbnails so that fast scrolling through
+    // a large gallery doesn't show placeholders.
+    func collectionView(_ collectionView: UICollectionView, prefetchItemsAt indexPaths: [IndexPath]) {
+        guard mediaCategory == .photoVideo, !mediaGallery.galleryDates.isEmpty else {
+            return
+        }
+        var hasRequestedLoad = false
+        for indexPath in indexPaths {
+            switch indexPath.section {
+            case kLoadOlderSectionIdx, loadNewerSectionIdx:
+                continue
+            default:
+                if let galleryItem = mediaGallery.galleryItem(at: mediaGalleryIndexPath(indexPath)) {
+                    galleryItem.prefetchThumbnailImage()
+                } else if !hasRequestedLoad {
+                    // One batch covers the rest of the prefetched paths.
+                    hasRequestedLoad = true
+                    _ = galleryItem(at: indexPath, loadAsync: true)
+                }
+            }
+        }
+    }
+}
+
 extension MediaTileViewController: MediaPresentationContextProvider {
 
     func mediaPresentationContext(item: Media, in coordinateSpace: UICoordinateSpace) -> MediaPresentationContext? {
@@ -0,0 +1,63 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+/// Simulates scrolling the chat list without AvatarBuilder's cache: the same
+/// handful of avatars are decoded over and over, at cell size.
+class AvatarPerfTest: PerformanceBaseTest {
+
+    private let avatarCount = 20
+    private let scrollPassCount = DebugFlags.fastPerfTests ? 2 : 20
+    // A 56pt avatar on a 3x screen.
+    private let diameterPixels: CGFloat = 168
+
+    func testScrolling_fullDecode() {
+        setUpIteration()
+
+        let avatars = buildAvatars()
+
+        measure {
+            for _ in 0..<scrollPassCount {
+                for avatarData in avatars {
+                    let image = UIImage(data: avatarData)!.resizedImage(toFillPixelSize: .square(diameterPixels))
+                    XCTAssertEqual(image.pixelWidth, Int(diameterPixels))
+                }
+            }
+        }
+    }
+
+    func testScrolling_downsampledDecode() {
+        setUpIteration()
+
+        let avatars = buildAvatars()
+
+        measure {
+            for _ in 0..<scrollPassCount {
+                for avatarData in avatars {
+                    let image = AvatarImageDecoder.decodeImage(data: avatarData, fillPixelSize: diameterPixels)!
+                    XCTAssertEqual(image.pixelWidth, Int(diameterPixels))
+                }
+            }
+        }
+    }
+
+    private func buildAvatars() -> [Data] {
+        let format = UIGraphicsImageRendererFormat()
+        format.scale = 1
+        let renderer = UIGraphicsImageRenderer(size: CGSize(square: 1024), format: format)
+        return (0..<avatarCount).map { index in
+            renderer.jpegData(withCompressionQuality: 0.9) { context in
+                UIColor(hue: CGFloat(index) / CGFloat(avatarCount), saturation: 0.8, brightness: 0.8, alpha: 1).setFill()
+                context.fill(CGRect(origin: .zero, size: CGSize(square: 1024)))
+                UIColor.white.setFill()
+                context.cgContext.fillEllipse(in: CGRect(x: 256, y: 256, width: 512, height: 512))
+            }
+        }
+    }
+}
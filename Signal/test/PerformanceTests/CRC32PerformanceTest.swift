@@ -0,0 +1,62 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import QuartzCore
+import SignalServiceKit
+import XCTest
+
+class CRC32PerformanceTest: PerformanceBaseTest {
+
+    private let byteCount = DebugFlags.fastPerfTests ? 16 * 1024 * 1024 : 256 * 1024 * 1024
+
+    private lazy var data = Randomness.generateRandomBytes(Int32(byteCount))
+
+    func testPerf_serial() {
+        let data = self.data
+        measureThroughput {
+            var crc = CRC32()
+            crc.append(data)
+            return crc.value
+        }
+    }
+
+    func testPerf_parallel() {
+        let data = self.data
+        measureThroughput {
+            CRC32.checksum(of: data).value
+        }
+    }
+
+    /// Many small updates, like checksumming PNG chunks one at a time.
+    func testPerf_smallUpdates() {
+        let data = self.data
+        let updateSize = 4096
+        measureThroughput {
+            data.withUnsafeBytes { bytes in
+                var crc = CRC32()
+                var start = 0
+                while start < bytes.count {
+                    let end = min(start + updateSize, bytes.count)
+                    crc.append(UnsafeRawBufferPointer(rebasing: bytes[start..<end]))
+                    start = end
+                }
+                return crc.value
+            }
+        }
+    }
+
+    /// Measures `block`, which should checksum all of `data`, and logs the
+    /// throughput in GB/s.
+    private func measureThroughput(_ block: () -> UInt32) {
+        let expected = CRC32().update(with: data).value
+        measure {
+            let startTime = CACurrentMediaTime()
+            XCTAssertEqual(block(), expected)
+            let duration = CACurrentMediaTime() - startTime
+            Logger.info(String(format: "%.2f GB/s", Double(byteCount) / duration / 1_000_000_000))
+        }
+    }
+}
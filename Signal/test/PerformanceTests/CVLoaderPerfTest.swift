@@ -0,0 +1,185 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import LibSignalClient
+import XCTest
+
+@testable import Signal
+@testable import SignalServiceKit
+import SignalUI
+
+/// Measures building the render items for a full load window.
+class CVLoaderPerfTest: PerformanceBaseTest {
+
+    private let messageCount: UInt = DebugFlags.fastPerfTests ? 50 : 500
+    // A typical update: a few new messages arrive.
+    private let newMessageCount = 3
+
+    // The first load, or a load after the conversation style changed.
+    func testBuildRenderItems_cold() {
+        setUpIteration()
+
+        let (itemModels, conversationStyle) = buildItemModels()
+
+        measure {
+            let renderItems = CVLoader.buildRenderItems(itemModels: itemModels,
+                                                        conversationStyle: conversationStyle,
+                                                        measurementCache: CVMeasurementCache())
+            XCTAssertEqual(renderItems.count, itemModels.count)
+        }
+    }
+
+    // A load after a few new messages arrived. The other items' component
+    // states are rebuilt but unchanged, as they are after e.g. a group update.
+    func testBuildRenderItems_typicalUpdate() {
+        setUpIteration()
+
+        let (itemModels, conversationStyle) = buildItemModels()
+        let (updatedItemModels, _) = buildItemModels()
+
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let measurementCache = CVMeasurementCache()
+            _ = CVLoader.buildRenderItems(itemModels: Array(itemModels.dropLast(newMessageCount)),
+                                          conversationStyle: conversationStyle,
+                                          measurementCache: measurementCache)
+
+            startMeasuring()
+            let renderItems = CVLoader.buildRenderItems(itemModels: updatedItemModels,
+                                                        conversationStyle: conversationStyle,
+                                                        measurementCache: measurementCache)
+            stopMeasuring()
+
+            XCTAssertEqual(renderItems.count, updatedItemModels.count)
+            for (renderItem, itemModel) in zip(renderItems, itemModels) {
+                let uncachedRenderItem = CVLoader.buildRenderItems(itemModels: [itemModel],
+                                                                   conversationStyle: conversationStyle,
+                                                                   measurementCache: CVMeasurementCache())
+                XCTAssertEqual(renderItem.cellMeasurement, uncachedRenderItem.first?.cellMeasurement)
+            }
+        }
+    }
+
+    // MARK: - Prefetch
+
+    func testBuildComponentStates_withoutPrefetch() {
+        measureBuildComponentStates(usePrefetch: false)
+    }
+
+    func testBuildComponentStates_withPrefetch() {
+        measureBuildComponentStates(usePrefetch: true)
+    }
+
+    private func measureBuildComponentStates(usePrefetch: Bool) {
+        setUpIteration()
+
+        let threadFactory = ContactThreadFactory()
+        threadFactory.messageCount = messageCount
+        let thread = databaseStorage.write { transaction in
+            let thread = threadFactory.create(transaction: transaction)
+            // Every other message has a reaction.
+            for (index, interaction) in TSInteraction.anyFetchAll(transaction: transaction).enumerated() where index % 2 == 0 {
+                OWSReaction(
+                    uniqueMessageId: interaction.uniqueId,
+                    emoji: "👍",
+                    reactor: Aci.randomForTesting(),
+                    sentAtTimestamp: interaction.timestamp,
+                    receivedAtTimestamp: interaction.timestamp
+                ).anyInsert(transaction: transaction)
+            }
+            return thread
+        }
+
+        let queryCount = AtomicValue<Int>(0, lock: .init())
+
+        measure {
+            databaseStorage.read { transaction in
+                let interactions = TSInteraction.anyFetchAll(transaction: transaction)
+                let coreState = CVCoreState(
+                    conversationStyle: ConversationStyle(
+                        type: .`default`,
+                        thread: thread,
+                        viewWidth: 390,
+                        hasWallpaper: false,
+                        isWallpaperPhoto: false,
+                        chatColor: ChatColors.resolvedChatColor(for: thread, tx: transaction)
+                    ),
+                    mediaCache: CVMediaCache()
+                )
+                let database = transaction.unwrapGrdbRead.database
+                queryCount.set(0)
+                database.trace { _ in queryCount.update { $0 += 1 } }
+                defer { database.trace() }
+
+                let itemBuildingContext = CVItemBuildingContextImpl(
+                    threadViewModel: ThreadViewModel(thread: thread, forChatList: false, transaction: transaction),
+                    viewStateSnapshot: CVViewStateSnapshot.mockSnapshotForStandaloneItems(
+                        coreState: coreState,
+                        spoilerReveal: SpoilerRenderState().revealState
+                    ),
+                    transaction: transaction,
+                    avatarBuilder: CVAvatarBuilder(transaction: transaction),
+                    prefetch: usePrefetch ? CVLoadPrefetch.build(
+                        interactionsToBuild: interactions,
+                        threadUniqueId: thread.uniqueId,
+                        transaction: transaction
+                    ) : nil
+                )
+                for interaction in interactions {
+                    XCTAssertNoThrow(try CVComponentState.build(interaction: interaction,
+                                                                itemBuildingContext: itemBuildingContext))
+                }
+            }
+            Logger.info("Built \(messageCount) component states with \(queryCount.get()) queries.")
+        }
+    }
+
+    // MARK: -
+
+    private var thread: TSContactThread?
+
+    private func buildItemModels() -> ([CVItemModel], ConversationStyle) {
+        if thread == nil {
+            let threadFactory = ContactThreadFactory()
+            threadFactory.messageCount = messageCount
+            thread = databaseStorage.write { threadFactory.create(transaction: $0) }
+        }
+        let thread = thread!
+
+        return databaseStorage.read { transaction in
+            let chatColor = ChatColors.resolvedChatColor(for: thread, tx: transaction)
+            let conversationStyle = ConversationStyle(
+                type: .`default`,
+                thread: thread,
+                viewWidth: 390,
+                hasWallpaper: false,
+                isWallpaperPhoto: false,
+                chatColor: chatColor
+            )
+            let coreState = CVCoreState(conversationStyle: conversationStyle, mediaCache: CVMediaCache())
+            let threadViewModel = ThreadViewModel(thread: thread, forChatList: false, transaction: transaction)
+            let threadAssociatedData = ThreadAssociatedData.fetchOrDefault(for: thread, transaction: transaction)
+            let itemBuildingContext = CVItemBuildingContextImpl(
+                threadViewModel: threadViewModel,
+                viewStateSnapshot: CVViewStateSnapshot.mockSnapshotForStandaloneItems(
+                    coreState: coreState,
+                    spoilerReveal: SpoilerRenderState().revealState
+                ),
+                transaction: transaction,
+                avatarBuilder: CVAvatarBuilder(transaction: transaction)
+            )
+            let itemModels = TSInteraction.anyFetchAll(transaction: transaction).compactMap { interaction in
+                CVItemModelBuilder.buildStandaloneItem(interaction: interaction,
+                                                       thread: thread,
+                                                       threadAssociatedData: threadAssociatedData,
+                                                       threadViewModel: threadViewModel,
+                                                       itemBuildingContext: itemBuildingContext,
+                                                       transaction: transaction)
+            }
+            XCTAssertEqual(itemModels.count, Int(messageCount))
+            return (itemModels, conversationStyle)
+        }
+    }
+}
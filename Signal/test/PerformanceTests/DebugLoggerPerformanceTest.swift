@@ -0,0 +1,83 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import CocoaLumberjack
+import Foundation
+import QuartzCore
+import XCTest
+@testable import SignalServiceKit
+
+/// Measures how long logging a line takes on the thread doing the logging.
+///
+/// DDLog hands lines to the loggers asynchronously, but only lets so many
+/// build up; past that, the logging thread waits for the loggers to catch up.
+class DebugLoggerPerformanceTest: PerformanceBaseTest {
+
+    private let lineCount = DebugFlags.fastPerfTests ? 1_000 : 50_000
+
+    private var logsDirectory: String!
+
+    override func setUp() {
+        super.setUp()
+        logsDirectory = OWSTemporaryDirectory().appendingPathComponent(UUID().uuidString)
+        OWSFileSystem.ensureDirectoryExists(logsDirectory)
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(logsDirectory)
+        super.tearDown()
+    }
+
+    func testPerf_fileLogger() {
+        measureLogging {
+            let logger = DDFileLogger(logFileManager: DDLogFileManagerDefault(logsDirectory: logsDirectory))
+            logger.logFormatter = ScrubbingLogFormatter()
+            return logger
+        }
+    }
+
+    func testPerf_batchingFileLogger() {
+        measureLogging {
+            let logger = BatchingFileLogger(logFileManager: DDLogFileManagerDefault(logsDirectory: logsDirectory))
+            logger.lineFormatter = ScrubbingLogFormatter()
+            return logger
+        }
+    }
+
+    private func measureLogging(makeLogger: () -> DDLogger) {
+        // Spread the lines over a few files, so they aren't rate limited.
+        let messages = (0..<lineCount).map { index in
+            DDLogMessage(
+                message: "Processed envelope \(index) of batch, timestamp: \(Date.ows_millisecondTimestamp())",
+                level: .all,
+                flag: .info,
+                context: 0,
+                file: "MessageProcessor\(index % 200).swift",
+                function: "drainNextBatch()",
+                line: 123,
+                tag: nil,
+                options: [],
+                timestamp: Date()
+            )
+        }
+
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let ddLog = DDLog()
+            ddLog.add(makeLogger())
+            defer { ddLog.removeAllLoggers() }
+
+            let startTime = CACurrentMediaTime()
+            startMeasuring()
+            for message in messages {
+                ddLog.log(asynchronous: true, message: message)
+            }
+            stopMeasuring()
+            let duration = CACurrentMediaTime() - startTime
+            Logger.info(String(format: "%.0f ns per line", duration / Double(lineCount) * 1_000_000_000))
+
+            ddLog.flushLog()
+        }
+    }
+}
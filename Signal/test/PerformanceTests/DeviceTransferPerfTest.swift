@@ -0,0 +1,111 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import QuartzCore
+import XCTest
+@testable import Signal
+import SignalServiceKit
+
+/// Compares sending small files one at a time with sending them in batches.
+///
+/// The session is replaced by a loopback stand-in that copies each resource
+/// into an "incoming" directory, so these measure the per-resource work both
+/// devices do (hashing, archiving, moving files into place), not the network.
+class DeviceTransferPerfTest: PerformanceBaseTest {
+
+    private let fileCount = DebugFlags.fastPerfTests ? 100 : 5000
+    private let fileSize = 16 * 1024
+
+    private var baseDirectory: URL!
+    private var files = [DeviceTransferProtoFile]()
+
+    override func setUp() {
+        super.setUp()
+        baseDirectory = URL(fileURLWithPath: OWSTemporaryDirectory()).appendingPathComponent(UUID().uuidString, isDirectory: true)
+        OWSFileSystem.ensureDirectoryExists(baseDirectory.appendingPathComponent("files").path)
+        files = (0..<fileCount).map { index in
+            let identifier = UUID().uuidString
+            let relativePath = "files/\(identifier)"
+            // Half of the files are compressible, like JSON or text; the
+            // rest are like already-compressed media.
+            let contents = index % 2 == 0
+                ? Data(String(repeating: "{\"key\": \(index)}", count: fileSize / 12).utf8.prefix(fileSize))
+                : Randomness.generateRandomBytes(Int32(fileSize))
+            try! contents.write(to: baseDirectory.appendingPathComponent(relativePath))
+            return DeviceTransferProtoFile.builder(
+                identifier: identifier,
+                relativePath: relativePath,
+                estimatedSize: UInt64(contents.count)
+            ).buildInfallibly()
+        }
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(baseDirectory.path)
+        super.tearDown()
+    }
+
+    func testPerf_individualFiles() {
+        measureTransfer { incomingDirectory, receivedDirectory in
+            for file in files {
+                let url = URL(fileURLWithPath: file.relativePath, relativeTo: baseDirectory)
+                let hash = try Cryptography.computeSHA256DigestOfFile(at: url)
+                let incomingUrl = try loopbackSend(url: url, to: incomingDirectory)
+                XCTAssertEqual(try Cryptography.computeSHA256DigestOfFile(at: incomingUrl), hash)
+                try FileManager.default.moveItem(at: incomingUrl, to: receivedDirectory.appendingPathComponent(file.identifier))
+            }
+        }
+    }
+
+    func testPerf_batchedFiles() {
+        let (batches, unbatchedFiles) = DeviceTransferBatch.makeBatches(files: files)
+        XCTAssertTrue(unbatchedFiles.isEmpty)
+
+        measureTransfer { incomingDirectory, receivedDirectory in
+            for batch in batches {
+                let archiveUrl = OWSFileSystem.temporaryFileUrl()
+                defer { OWSFileSystem.deleteFileIfExists(archiveUrl.path) }
+                try batch.writeArchive(baseDirectory: baseDirectory, to: archiveUrl)
+                let hash = try Cryptography.computeSHA256DigestOfFile(at: archiveUrl)
+                let incomingUrl = try loopbackSend(url: archiveUrl, to: incomingDirectory)
+                XCTAssertEqual(try Cryptography.computeSHA256DigestOfFile(at: incomingUrl), hash)
+                let result = try DeviceTransferBatch.extractArchive(at: incomingUrl, to: receivedDirectory)
+                XCTAssertEqual(result.receivedFileIds.count, batch.files.count)
+            }
+        }
+    }
+
+    // MARK: - Utilities
+
+    /// Stands in for `MCSession.sendResource`, which delivers a copy of the
+    /// file to the other device.
+    private func loopbackSend(url: URL, to incomingDirectory: URL) throws -> URL {
+        let incomingUrl = incomingDirectory.appendingPathComponent(UUID().uuidString)
+        try FileManager.default.copyItem(at: url, to: incomingUrl)
+        return incomingUrl
+    }
+
+    private func measureTransfer(_ block: (_ incomingDirectory: URL, _ receivedDirectory: URL) throws -> Void) {
+        let totalSize = files.reduce(0) { $0 + $1.estimatedSize }
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let incomingDirectory = baseDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+            let receivedDirectory = baseDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+            OWSFileSystem.ensureDirectoryExists(incomingDirectory.path)
+            OWSFileSystem.ensureDirectoryExists(receivedDirectory.path)
+            defer {
+                OWSFileSystem.deleteFileIfExists(incomingDirectory.path)
+                OWSFileSystem.deleteFileIfExists(receivedDirectory.path)
+            }
+
+            let startTime = CACurrentMediaTime()
+            startMeasuring()
+            XCTAssertNoThrow(try block(incomingDirectory, receivedDirectory))
+            stopMeasuring()
+            let duration = CACurrentMediaTime() - startTime
+            Logger.info(String(format: "%.1f MB/s", Double(totalSize) / duration / 1_000_000))
+        }
+    }
+}
@@ -0,0 +1,62 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import LibSignalClient
+import XCTest
+
+@testable import SignalServiceKit
+
+class DisplayNameSortingPerfTest: XCTestCase {
+
+    private let recipientCount = DebugFlags.fastPerfTests ? 100 : 10_000
+
+    private let config = DisplayName.ComparableValue.Config(
+        displayNameConfig: DisplayName.Config(shouldUseSystemContactNicknames: false),
+        shouldSortByGivenName: true
+    )
+
+    func testSort() {
+        let displayNames = Self.buildDisplayNames(count: recipientCount)
+        let addresses = displayNames.map { _ in SignalServiceAddress(Aci.randomForTesting()) }
+
+        measure {
+            let comparableNames = zip(addresses, displayNames).map {
+                ComparableDisplayName(address: $0, displayName: $1, config: config)
+            }
+            let sortedNames = comparableNames.sorted(by: <)
+            XCTAssertEqual(sortedNames.count, recipientCount)
+        }
+    }
+
+    func testSort_collationIndex() {
+        let displayNames = Self.buildDisplayNames(count: recipientCount)
+        let addresses = displayNames.map { _ in SignalServiceAddress(Aci.randomForTesting()) }
+        let collationIndex = DisplayNameCollationIndex()
+
+        measure {
+            let comparableNames = zip(addresses, displayNames).map {
+                ComparableDisplayName(address: $0, displayName: $1, config: config)
+            }
+            // After the first iteration, every name already has a key.
+            let sortedNames = ComparableDisplayName.sorted(comparableNames, collationIndex: collationIndex)
+            XCTAssertEqual(sortedNames.count, recipientCount)
+        }
+    }
+
+    private static func buildDisplayNames(count: Int) -> [DisplayName] {
+        let givenNames = ["Émile", "ada", "Zoë", "Björn", "Mariana", "Øystein", "Jean-Luc", "ana", "Ángel", "Chloé"]
+        let familyNames = ["Müller", "Smith", "O'Brien", "García", "Nguyễn", "kowalski", "Søndergaard", nil]
+        return (0..<count).map { index in
+            if index % 10 == 9 {
+                return .phoneNumber(E164("+1313555\(String(format: "%04d", index % 10_000))")!)
+            }
+            var nameComponents = PersonNameComponents()
+            nameComponents.givenName = "\(givenNames[index % givenNames.count])\(index / 7)"
+            nameComponents.familyName = familyNames[index % familyNames.count]
+            return .profileName(nameComponents)
+        }
+    }
+}
@@ -26,6 +26,61 @@ class GroupsPerfTest: PerformanceBaseTest {
         }
     }
 
+    func testLargeMembershipDeserialization_1k() {
+        measureLargeMembershipDeserialization(memberCount: 1_000)
+    }
+
+    func testLargeMembershipDeserialization_10k() {
+        measureLargeMembershipDeserialization(memberCount: 10_000)
+    }
+
+    func testLargeMembershipLookups_1k() {
+        measureLargeMembershipLookups(memberCount: 1_000)
+    }
+
+    func testLargeMembershipLookups_10k() {
+        measureLargeMembershipLookups(memberCount: 10_000)
+    }
+
+    private func measureLargeMembershipDeserialization(memberCount: Int) {
+        setUpIteration()
+
+        let data = try! Self.serialize(membership: Self.buildLargeMembership(acis: Self.randomAcis(count: memberCount)))
+
+        measure {
+            let membership = try! Self.deserialize(data: data)
+            // Thread fetches typically check the local user's membership.
+            XCTAssertFalse(membership.isFullMember(Aci.randomForTesting()))
+        }
+    }
+
+    private func measureLargeMembershipLookups(memberCount: Int) {
+        setUpIteration()
+
+        let acis = Self.randomAcis(count: memberCount)
+        let membership = Self.buildLargeMembership(acis: acis)
+
+        measure {
+            for aci in acis {
+                XCTAssertNotNil(membership.role(for: aci))
+                XCTAssertTrue(membership.isFullMember(aci))
+            }
+            XCTAssertEqual(membership.fullMembers.count, memberCount)
+        }
+    }
+
+    private static func randomAcis(count: Int) -> [Aci] {
+        return (0..<count).map { _ in Aci.randomForTesting() }
+    }
+
+    static func buildLargeMembership(acis: [Aci]) -> GroupMembership {
+        var builder = GroupMembership.Builder()
+        for (index, aci) in acis.enumerated() {
+            builder.addFullMember(aci, role: index % 100 == 0 ? .administrator : .normal)
+        }
+        return builder.build()
+    }
+
     static func buildMembership() -> GroupMembership {
         let memberCount: UInt = 32
 
@@ -0,0 +1,121 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+import SignalServiceKit
+
+class MediaGalleryPerformanceTest: PerformanceBaseTest {
+
+    private let batchSize = 100
+
+    func testPerf_scrollBackThroughAllMedia() {
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            setUpIteration()
+            scrollBackThroughAllMedia()
+        }
+    }
+
+    /// Loads every item in a large gallery the way All Media does when the user
+    /// scrolls from the most recent media back to the oldest: a batch of
+    /// timestamps at a time, plus the remainder of each batch's oldest month.
+    private func scrollBackThroughAllMedia() {
+        let mediaCount = DebugFlags.fastPerfTests ? 1_000 : 50_000
+        let thread = insertThreadWithMedia(count: mediaCount)
+        let finder = MediaGalleryRecordFinder(thread: thread, filter: .allPhotoVideoCategory)
+
+        read { transaction in
+            self.startMeasuring()
+            var loadedCount = 0
+            var earliestDate = Date.distantFutureForMillisecondTimestamp
+            while true {
+                var batchEarliestDate: Date?
+                let result = finder.enumerateTimestamps(
+                    before: earliestDate,
+                    excluding: [],
+                    count: self.batchSize,
+                    transaction: transaction.unwrapGrdbRead
+                ) { datedId in
+                    loadedCount += 1
+                    batchEarliestDate = datedId.date
+                }
+                guard result == .finished, let batchEarliestDate else {
+                    break
+                }
+                let monthStart = Calendar.current.dateInterval(of: .month, for: batchEarliestDate)!.start
+                let remainder = finder.rowIdsAndDates(
+                    in: DateInterval(start: monthStart, end: batchEarliestDate),
+                    excluding: [],
+                    offset: 0,
+                    ascending: false,
+                    transaction: transaction.unwrapGrdbRead
+                )
+                loadedCount += remainder.count
+                earliestDate = monthStart
+            }
+            self.stopMeasuring()
+
+            XCTAssertEqual(loadedCount, mediaCount)
+        }
+    }
+
+    /// Inserts a thread with `count` single-image messages, one an hour going
+    /// back from now. The attachment rows are written directly; only the
+    /// columns the gallery queries need are populated.
+    private func insertThreadWithMedia(count: Int) -> TSThread {
+        var thread: TSThread!
+        write { transaction in
+            thread = ContactThreadFactory().create(transaction: transaction)
+        }
+
+        let messageFactory = IncomingMessageFactory()
+        messageFactory.threadCreator = { _ in thread }
+        var remainingCount = count
+        while remainingCount > 0 {
+            let chunkSize = min(remainingCount, 1_000)
+            write { transaction in
+                _ = messageFactory.create(count: UInt(chunkSize), transaction: transaction)
+            }
+            remainingCount -= chunkSize
+        }
+
+        write { transaction in
+            let database = transaction.unwrapGrdbWrite.database
+            let nowMs = Date.ows_millisecondTimestamp()
+            let hourMs = UInt64(kHourInMs)
+            try! database.execute(
+                sql: """
+                    UPDATE model_TSInteraction
+                    SET receivedAtTimestamp = ? - id * ?
+                    WHERE uniqueThreadId = ?
+                """,
+                arguments: [nowMs, hourMs, thread.uniqueId]
+            )
+            try! database.execute(
+                sql: """
+                    INSERT INTO model_TSAttachment
+                        (recordType, uniqueId, attachmentType, byteCount, contentType, serverId, albumMessageId)
+                    SELECT ?, 'perf-' || id, 0, 0, 'image/jpeg', 0, uniqueId
+                    FROM model_TSInteraction
+                    WHERE uniqueThreadId = ?
+                """,
+                arguments: [SDSRecordType.attachmentStream.rawValue, thread.uniqueId]
+            )
+            try! database.execute(
+                sql: """
+                    INSERT INTO media_gallery_items
+                        (attachmentId, albumMessageId, threadId, originalAlbumOrder, receivedAtTimestamp)
+                    SELECT attachment.id, interaction.id, ?, 0, interaction.receivedAtTimestamp
+                    FROM model_TSAttachment AS attachment
+                    INNER JOIN model_TSInteraction AS interaction
+                        ON attachment.albumMessageId = interaction.uniqueId
+                    WHERE interaction.uniqueThreadId = ?
+                """,
+                arguments: [thread.sqliteRowId!, thread.uniqueId]
+            )
+        }
+        return thread
+    }
+}
@@ -0,0 +1,74 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+@testable import Signal
+import SignalServiceKit
+
+class OrphanDataFileManifestPerfTest: PerformanceBaseTest {
+
+    /// Attachments are stored in a directory each.
+    private let directoryCount = DebugFlags.fastPerfTests ? 100 : 50_000
+    private let filesPerDirectory = 2
+
+    private var rootPath: String!
+    private var manifestUrl: URL!
+
+    override func setUp() {
+        super.setUp()
+        rootPath = (OWSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        manifestUrl = OWSFileSystem.temporaryFileUrl(fileExtension: "json")
+        for directoryIndex in 0..<directoryCount {
+            let directoryPath = rootPath.appendingPathComponent("\(directoryIndex)")
+            OWSFileSystem.ensureDirectoryExists(directoryPath)
+            for fileIndex in 0..<filesPerDirectory {
+                FileManager.default.createFile(atPath: directoryPath.appendingPathComponent("\(fileIndex)"), contents: nil)
+            }
+        }
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(rootPath)
+        OWSFileSystem.deleteFileIfExists(manifestUrl.path)
+        super.tearDown()
+    }
+
+    /// The first audit, which lists every directory.
+    func testPerf_coldScan() {
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            OWSFileSystem.deleteFileIfExists(manifestUrl.path)
+
+            startMeasuring()
+            scan(expectedListedDirectoryCount: directoryCount + 1)
+            stopMeasuring()
+        }
+    }
+
+    /// Later audits, after a few attachments have been added.
+    func testPerf_warmScan() {
+        scan(expectedListedDirectoryCount: directoryCount + 1)
+
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            for directoryIndex in 0..<10 {
+                let directoryPath = rootPath.appendingPathComponent("\(directoryIndex)")
+                FileManager.default.createFile(atPath: directoryPath.appendingPathComponent(UUID().uuidString), contents: nil)
+            }
+
+            startMeasuring()
+            scan(expectedListedDirectoryCount: 10)
+            stopMeasuring()
+        }
+    }
+
+    private func scan(expectedListedDirectoryCount: Int) {
+        // Pretend the files were all created long ago, so that every
+        // directory is remembered.
+        let manifest = OrphanDataFileManifest(manifestUrl: manifestUrl, dateProvider: { Date().addingTimeInterval(60) })
+        let filePaths = manifest.filePaths(inDirectory: rootPath, shouldContinue: { true })
+        XCTAssertGreaterThanOrEqual(filePaths?.count ?? 0, directoryCount * filesPerDirectory)
+        XCTAssertEqual(manifest.listedDirectoryCount, expectedListedDirectoryCount)
+    }
+}
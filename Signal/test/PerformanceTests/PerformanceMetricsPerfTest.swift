@@ -0,0 +1,50 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import QuartzCore
+import XCTest
+import SignalServiceKit
+
+/// Metrics are recorded on hot paths, so recording should cost well under a
+/// microsecond.
+class PerformanceMetricsPerfTest: PerformanceBaseTest {
+
+    private let iterationCount = DebugFlags.fastPerfTests ? 100 : 1000 * 1000
+
+    func testPerf_recordHistogram() {
+        let histogram = LatencyHistogram()
+        measureIterations { index in
+            histogram.record(TimeInterval(index % 1000) / 1_000_000)
+        }
+    }
+
+    func testPerf_span() {
+        let metrics = PerformanceMetrics.shared
+        measureIterations { _ in
+            metrics.measure("perfTest.span") {}
+        }
+    }
+
+    func testPerf_counter() {
+        let counter = PerformanceMetrics.shared.counter("perfTest.counter")
+        measureIterations { _ in
+            counter.increment()
+        }
+    }
+
+    private func measureIterations(_ block: (Int) -> Void) {
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let startTime = CACurrentMediaTime()
+            startMeasuring()
+            for index in 0..<iterationCount {
+                block(index)
+            }
+            stopMeasuring()
+            let duration = CACurrentMediaTime() - startTime
+            Logger.info(String(format: "%.0f ns per call", duration / Double(iterationCount) * 1_000_000_000))
+        }
+    }
+}
@@ -0,0 +1,60 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class PhoneNumberParsingPerfTest: XCTestCase {
+
+    private let phoneNumberCount = DebugFlags.fastPerfTests ? 100 : 10_000
+
+    private let phoneNumberUtil = PhoneNumberUtil(swiftValues: PhoneNumberUtilSwiftValues())
+    private let localPhoneNumber = "+13233214321"
+
+    func testPerf_parseIndividually() {
+        let userSpecifiedTexts = Self.buildUserSpecifiedTexts(count: phoneNumberCount)
+
+        measure {
+            let results = userSpecifiedTexts.map {
+                phoneNumberUtil.parsePhoneNumbers(userSpecifiedText: $0, localPhoneNumber: localPhoneNumber)
+            }
+            XCTAssertEqual(results.count, phoneNumberCount)
+        }
+    }
+
+    func testPerf_parseBatch() {
+        let userSpecifiedTexts = Self.buildUserSpecifiedTexts(count: phoneNumberCount)
+
+        measure {
+            let results = phoneNumberUtil.parsePhoneNumbers(
+                userSpecifiedTexts: userSpecifiedTexts,
+                localPhoneNumber: localPhoneNumber
+            )
+            XCTAssertEqual(results.count, phoneNumberCount)
+        }
+    }
+
+    /// A mix of local, national & international formats, like you might find
+    /// in an address book for someone with contacts in several countries.
+    static func buildUserSpecifiedTexts(count: Int) -> [String] {
+        let formats = [
+            "555-%04d",
+            "(323) 555-%04d",
+            "+1 570 555 %04d",
+            "+44 20 7946 %04d",
+            "+49 30 1234%04d",
+            "+33 1 70 39 %04d",
+            "+55 21 9 8765-%04d",
+            "+52 1 55 1234 %04d",
+            "+91 98765 4%04d",
+            "+81 3-1234-%04d",
+        ]
+        return (0..<count).map { index in
+            return String(format: formats[index % formats.count], index % 10_000)
+        }
+    }
+}
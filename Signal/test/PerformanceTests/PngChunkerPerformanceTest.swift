@@ -0,0 +1,99 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import SignalServiceKit
+import XCTest
+
+class PngChunkerPerformanceTest: PerformanceBaseTest {
+
+    private let frameCount = DebugFlags.fastPerfTests ? 10 : 300
+    private let corpusSize = DebugFlags.fastPerfTests ? 2 : 20
+
+    /// Animated PNGs the size of large stickers: 512x512 with a 64KB frame
+    /// every 100ms.
+    private lazy var corpus: [Data] = (0..<corpusSize).map { _ in makeApng() }
+
+    func testPerf_iterateChunks() {
+        let corpus = self.corpus
+        measure {
+            for data in corpus {
+                let chunker = try! PngChunker(data: data)
+                var chunkCount = 0
+                while try! chunker.next() != nil {
+                    chunkCount += 1
+                }
+                XCTAssertEqual(chunkCount, 2 * frameCount + 3)
+            }
+        }
+    }
+
+    func testPerf_isAnimated() {
+        let corpus = self.corpus
+        measure {
+            for _ in 0..<100 {
+                for data in corpus {
+                    XCTAssertTrue(try! PngChunker.isAnimated(data: data))
+                }
+            }
+        }
+    }
+
+    func testPerf_iterateMappedFiles() {
+        let fileUrls = corpus.map { data -> URL in
+            let fileUrl = OWSFileSystem.temporaryFileUrl(fileExtension: "png")
+            try! data.write(to: fileUrl)
+            return fileUrl
+        }
+        defer {
+            fileUrls.forEach { try? OWSFileSystem.deleteFileIfExists(url: $0) }
+        }
+
+        measure {
+            for fileUrl in fileUrls {
+                // Like imageMetadata(withPath:), map the file rather than read it.
+                let chunker = try! PngChunker(data: Data(contentsOf: fileUrl, options: .mappedIfSafe))
+                var byteCount = PngChunker.pngSignature.count
+                while let chunk = try! chunker.next() {
+                    byteCount += chunk.allBytes().count
+                }
+                XCTAssertEqual(byteCount, corpus[0].count)
+            }
+        }
+    }
+
+    // MARK: - Utilities
+
+    /// Builds an APNG with valid chunk structure. Its frame data is random, so
+    /// it can be chunked but not decoded.
+    private func makeApng() -> Data {
+        var result = PngChunker.pngSignature
+        result += chunk(type: "IHDR", data: uint32(512) + uint32(512) + Data([8, 6, 0, 0, 0]))
+        result += chunk(type: "acTL", data: uint32(UInt32(frameCount)) + uint32(0))
+        for index in 0..<frameCount {
+            let sequenceNumber = UInt32(2 * index)
+            let frameControl = uint32(sequenceNumber) + Randomness.generateRandomBytes(22)
+            result += chunk(type: "fcTL", data: frameControl)
+            let frameData = Randomness.generateRandomBytes(64 * 1024)
+            if index == 0 {
+                result += chunk(type: "IDAT", data: frameData)
+            } else {
+                result += chunk(type: "fdAT", data: uint32(sequenceNumber + 1) + frameData)
+            }
+        }
+        result += chunk(type: "IEND", data: Data())
+        return result
+    }
+
+    private func chunk(type: String, data: Data) -> Data {
+        let typeBytes = type.data(using: .ascii)!
+        let crc = CRC32().update(with: typeBytes).update(with: data)
+        return uint32(UInt32(data.count)) + typeBytes + data + uint32(crc.value)
+    }
+
+    private func uint32(_ value: UInt32) -> Data {
+        return withUnsafeBytes(of: value.bigEndian) { Data($0) }
+    }
+}
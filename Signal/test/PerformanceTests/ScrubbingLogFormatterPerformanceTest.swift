@@ -0,0 +1,54 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import QuartzCore
+import XCTest
+@testable import SignalServiceKit
+
+class ScrubbingLogFormatterPerformanceTest: PerformanceBaseTest {
+
+    private let repetitionCount = DebugFlags.fastPerfTests ? 100 : 10_000
+
+    private let formatter = ScrubbingLogFormatter()
+
+    /// Most log lines have nothing to redact.
+    func testPerf_plainLines() {
+        measureLines([
+            "Processing batch of 12 envelopes",
+            "Starting message fetch",
+            "Finished fetching messages",
+            "App will enter foreground",
+            "Skipping read receipt, not enabled",
+        ])
+    }
+
+    /// Lines like those logged while processing messages.
+    func testPerf_sensitiveLines() {
+        let timestamp = Date.ows_millisecondTimestamp()
+        measureLines([
+            "Sending message: TSOutgoingMessage, timestamp: \(timestamp)",
+            "attempting to send message: TSOutgoingMessage, timestamp: \(timestamp), recipient: <SignalServiceAddress phoneNumber: +12345550123, uuid: BAF1768C-2A25-4D8F-83B7-A89C59C98748>",
+            "Received envelope with source device 2, groupId: gAHf1fZBcZG+NX87lJ/7emLpP9AebR/k7lxMh8EyL3XE=",
+            "Connecting to 2001:db8:3:4::192.0.2.33 and 127.0.0.1",
+            "Decrypted data: {length = 32, bytes = 0x0123456789a23def2323456789ab1234}",
+        ])
+    }
+
+    private func measureLines(_ lines: [String]) {
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            let startTime = CACurrentMediaTime()
+            startMeasuring()
+            for _ in 0..<repetitionCount {
+                for line in lines {
+                    _ = formatter.redactMessage(line)
+                }
+            }
+            stopMeasuring()
+            let duration = CACurrentMediaTime() - startTime
+            Logger.info(String(format: "%.0f lines/s", Double(repetitionCount * lines.count) / duration))
+        }
+    }
+}
@@ -0,0 +1,56 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import SignalServiceKit
+import SignalUI
+import XCTest
+import YYImage
+
+class StickerPerformanceTest: PerformanceBaseTest {
+
+    private let packSize = DebugFlags.fastPerfTests ? 20 : 200
+    private let cellCount = DebugFlags.fastPerfTests ? 5 : 50
+
+    /// Installs a pack's worth of downloaded stickers, as happens once all of
+    /// a pack's stickers have been fetched.
+    func testPerf_installPack() {
+        measureMetrics(XCTestCase.defaultPerformanceMetrics, automaticallyStartMeasuring: false) {
+            setUpIteration()
+
+            let packId = Randomness.generateRandomBytes(16)
+            let packKey = Randomness.generateRandomBytes(Int32(StickerManager.packKeyLength))
+            let downloadedStickers = (0..<packSize).map { stickerId -> StickerManager.DownloadedSticker in
+                let stickerUrl = OWSFileSystem.temporaryFileUrl()
+                try! Randomness.generateRandomBytes(16 * 1024).write(to: stickerUrl)
+                return StickerManager.DownloadedSticker(
+                    stickerInfo: StickerInfo(packId: packId, packKey: packKey, stickerId: UInt32(stickerId)),
+                    stickerUrl: stickerUrl,
+                    contentType: MimeType.imageWebp.rawValue,
+                    emojiString: "🌼"
+                )
+            }
+
+            startMeasuring()
+            let installedCount = StickerManager.installStickers(downloadedStickers)
+            stopMeasuring()
+
+            XCTAssertEqual(installedCount, packSize)
+        }
+    }
+
+    /// Loads the same animated sticker for many cells, as a conversation with
+    /// the sticker sent over and over does while it scrolls.
+    func testPerf_renderAnimatedSticker() {
+        let fileUrl = Bundle(for: Self.self).url(forResource: "test-gif", withExtension: "gif")!
+        measure {
+            let frameCache = StickerFrameCache()
+            for _ in 0..<cellCount {
+                let image = frameCache.image(stickerKey: "test-gif", fileUrl: fileUrl, pointSize: 175)
+                XCTAssertGreaterThan((image as? YYAnimatedImage)?.animatedImageFrameCount() ?? 0, 1)
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Contacts
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class SystemContactsPerfTest: XCTestCase {
+
+    private let contactCount = DebugFlags.fastPerfTests ? 100 : 10_000
+
+    private let phoneNumberUtil = PhoneNumberUtil(swiftValues: PhoneNumberUtilSwiftValues())
+    private let localPhoneNumber = "+12125550100"
+
+    func testPerf_parseAllContacts() {
+        let systemContacts = Self.buildSystemContacts(count: contactCount)
+
+        measure {
+            let fetchedSystemContacts = FetchedSystemContacts.parseContacts(
+                systemContacts,
+                phoneNumberUtil: phoneNumberUtil,
+                localPhoneNumber: localPhoneNumber
+            )
+            XCTAssertEqual(fetchedSystemContacts.cnContactIdToContact.count, contactCount)
+        }
+    }
+
+    func testPerf_parseAfterSingleEdit() {
+        var systemContacts = Self.buildSystemContacts(count: contactCount)
+        let priorFetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: localPhoneNumber
+        )
+        let editedContact = CNMutableContact()
+        editedContact.givenName = "Edited"
+        editedContact.phoneNumbers = [CNLabeledValue(label: CNLabelPhoneNumberMobile, value: CNPhoneNumber(stringValue: "+1 (313) 555-0199"))]
+        systemContacts[contactCount / 2] = SystemContact(cnContact: editedContact)
+
+        measure {
+            let fetchedSystemContacts = FetchedSystemContacts.parseContacts(
+                systemContacts,
+                phoneNumberUtil: phoneNumberUtil,
+                localPhoneNumber: localPhoneNumber,
+                priorFetchedSystemContacts: priorFetchedSystemContacts
+            )
+            XCTAssertEqual(fetchedSystemContacts.cnContactIdToContact.count, contactCount)
+        }
+    }
+
+    func testPerf_parseWithColdCache() {
+        let systemContacts = Self.buildSystemContacts(count: contactCount)
+
+        measure {
+            let parsedPhoneNumberCache = ParsedPhoneNumberCache(localPhoneNumber: localPhoneNumber, regionCode: "US")
+            _ = FetchedSystemContacts.parseContacts(
+                systemContacts,
+                phoneNumberUtil: phoneNumberUtil,
+                localPhoneNumber: localPhoneNumber,
+                parsedPhoneNumberCache: parsedPhoneNumberCache
+            )
+            XCTAssertEqual(parsedPhoneNumberCache.hitCount, 0)
+        }
+    }
+
+    func testPerf_parseWithWarmCache() {
+        let systemContacts = Self.buildSystemContacts(count: contactCount)
+        let parsedPhoneNumberCache = ParsedPhoneNumberCache(localPhoneNumber: localPhoneNumber, regionCode: "US")
+        _ = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: localPhoneNumber,
+            parsedPhoneNumberCache: parsedPhoneNumberCache
+        )
+
+        measure {
+            parsedPhoneNumberCache.resetStatistics()
+            _ = FetchedSystemContacts.parseContacts(
+                systemContacts,
+                phoneNumberUtil: phoneNumberUtil,
+                localPhoneNumber: localPhoneNumber,
+                parsedPhoneNumberCache: parsedPhoneNumberCache
+            )
+            XCTAssertEqual(parsedPhoneNumberCache.missCount, 0)
+        }
+    }
+
+    static func buildSystemContacts(count: Int) -> [SystemContact] {
+        let formats = ["+1 (313) 555-%04d", "313-555-%04d", "+44 20 7946 %04d", "+49 30 1234%04d", "+33 1 70 39 %04d"]
+        return (0..<count).map { index in
+            let cnContact = CNMutableContact()
+            cnContact.givenName = "Contact"
+            cnContact.familyName = "\(index)"
+            let phoneNumber = String(format: formats[index % formats.count], index % 10_000)
+            cnContact.phoneNumbers = [CNLabeledValue(label: CNLabelPhoneNumberMobile, value: CNPhoneNumber(stringValue: phoneNumber))]
+            return SystemContact(cnContact: cnContact)
+        }
+    }
+}
@@ -0,0 +1,115 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import CocoaLumberjack
+import XCTest
+
+@testable import SignalServiceKit
+
+final class BatchingFileLoggerTest: XCTestCase {
+    private var logsDirectory: String!
+
+    override func setUp() {
+        super.setUp()
+        logsDirectory = OWSTemporaryDirectory().appendingPathComponent(UUID().uuidString)
+        OWSFileSystem.ensureDirectoryExists(logsDirectory)
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(logsDirectory)
+        super.tearDown()
+    }
+
+    private func makeMessage(_ message: String, flag: DDLogFlag = .info, file: String = "File.swift", timestamp: Date) -> DDLogMessage {
+        return DDLogMessage(
+            message: message,
+            level: .all,
+            flag: flag,
+            context: 0,
+            file: file,
+            function: nil,
+            line: 0,
+            tag: nil,
+            options: [],
+            timestamp: timestamp
+        )
+    }
+
+    func testWritesLinesOnFlush() throws {
+        let ddLog = DDLog()
+        let logger = BatchingFileLogger(logFileManager: DDLogFileManagerDefault(logsDirectory: logsDirectory))
+        ddLog.add(logger)
+        defer { ddLog.removeAllLoggers() }
+
+        let now = Date()
+        for index in 0..<3 {
+            ddLog.log(asynchronous: false, message: makeMessage("line \(index)", timestamp: now))
+        }
+        ddLog.flushLog()
+
+        let logFilePath = try XCTUnwrap(logger.logFileManager.sortedLogFilePaths.first)
+        let contents = try String(contentsOfFile: logFilePath)
+        XCTAssertEqual(contents, "line 0\nline 1\nline 2\n")
+    }
+
+    func testDropsLinesFromChattyFiles() throws {
+        let ddLog = DDLog()
+        let logger = BatchingFileLogger(logFileManager: DDLogFileManagerDefault(logsDirectory: logsDirectory))
+        ddLog.add(logger)
+        defer { ddLog.removeAllLoggers() }
+
+        let now = Date()
+        let lineCount = LogRateLimiter.maximumLinesPerSecond + 10
+        for index in 0..<lineCount {
+            ddLog.log(asynchronous: false, message: makeMessage("line \(index)", file: "Chatty.swift", timestamp: now))
+            ddLog.log(asynchronous: false, message: makeMessage("other \(index)", file: "Quiet.swift", timestamp: now.addingTimeInterval(Double(index))))
+        }
+        ddLog.log(asynchronous: false, message: makeMessage("warning", flag: .warning, file: "Chatty.swift", timestamp: now))
+        ddLog.flushLog()
+
+        let logFilePath = try XCTUnwrap(logger.logFileManager.sortedLogFilePaths.first)
+        let lines = try String(contentsOfFile: logFilePath).split(separator: "\n")
+        XCTAssertEqual(lines.filter { $0.hasPrefix("line ") }.count, LogRateLimiter.maximumLinesPerSecond)
+        XCTAssertEqual(lines.filter { $0.hasPrefix("other ") }.count, lineCount)
+        XCTAssertEqual(lines.suffix(2), ["Dropped 10 lines, this file logged too much.", "warning"])
+    }
+
+    func testRateLimiter() {
+        var rateLimiter = LogRateLimiter()
+        let now = Date()
+
+        for _ in 0..<LogRateLimiter.maximumLinesPerSecond {
+            XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now, isUrgent: false), .admit(droppedCount: 0))
+        }
+        XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now, isUrgent: false), .drop)
+        XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now.addingTimeInterval(0.5), isUrgent: false), .drop)
+
+        // Other files have their own limit, and warnings aren't limited.
+        XCTAssertEqual(rateLimiter.admit(fileName: "B", at: now, isUrgent: false), .admit(droppedCount: 0))
+        XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now, isUrgent: true), .admit(droppedCount: 2))
+
+        XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now.addingTimeInterval(0.9), isUrgent: false), .drop)
+        XCTAssertEqual(rateLimiter.admit(fileName: "A", at: now.addingTimeInterval(1), isUrgent: false), .admit(droppedCount: 1))
+    }
+
+    func testFormattedTimestamp() {
+        let dateFormatter = DateFormatter()
+        dateFormatter.locale = Locale(identifier: "en_US_POSIX")
+        dateFormatter.timeZone = TimeZone(secondsFromGMT: 0)
+        dateFormatter.dateFormat = "yyyy/MM/dd HH:mm:ss:SSS"
+
+        // Stay away from millisecond boundaries, where rounding might differ.
+        let dates = [
+            Date(timeIntervalSince1970: 0.0005),
+            Date(timeIntervalSince1970: 1_700_000_000.0015),
+            Date(timeIntervalSince1970: 1_700_000_000.0505),
+            Date(timeIntervalSince1970: 1_700_000_000.9995),
+            Date(timeIntervalSince1970: 1_700_000_001.1235),
+        ]
+        for date in dates {
+            XCTAssertEqual(LogFormatter.formattedTimestamp(for: date), dateFormatter.string(from: date), "\(date.timeIntervalSince1970)")
+        }
+    }
+}
@@ -0,0 +1,126 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import SignalServiceKit
+import XCTest
+
+@testable import Signal
+
+class DeviceTransferBatchTest: XCTestCase {
+    private var baseDirectory: URL!
+    private var destinationDirectory: URL!
+
+    override func setUp() {
+        super.setUp()
+        let tempDirectory = URL(fileURLWithPath: OWSTemporaryDirectory())
+        baseDirectory = tempDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        destinationDirectory = tempDirectory.appendingPathComponent(UUID().uuidString, isDirectory: true)
+        OWSFileSystem.ensureDirectoryExists(baseDirectory.path)
+        OWSFileSystem.ensureDirectoryExists(destinationDirectory.path)
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(baseDirectory.path)
+        OWSFileSystem.deleteFileIfExists(destinationDirectory.path)
+        super.tearDown()
+    }
+
+    private func makeFile(size: UInt64, contents: Data? = nil) -> DeviceTransferProtoFile {
+        let identifier = UUID().uuidString
+        let relativePath = "files/\(identifier)"
+        if let contents {
+            OWSFileSystem.ensureDirectoryExists(baseDirectory.appendingPathComponent("files").path)
+            try! contents.write(to: baseDirectory.appendingPathComponent(relativePath))
+        }
+        return DeviceTransferProtoFile.builder(
+            identifier: identifier,
+            relativePath: relativePath,
+            estimatedSize: size
+        ).buildInfallibly()
+    }
+
+    func testMakeBatches() {
+        let largeFile = makeFile(size: DeviceTransferBatch.maxBatchedFileSize + 1)
+        let smallFiles = (0..<10).map { _ in makeFile(size: DeviceTransferBatch.maxBatchedFileSize) }
+
+        let (batches, unbatchedFiles) = DeviceTransferBatch.makeBatches(files: [largeFile] + smallFiles)
+        XCTAssertEqual(unbatchedFiles.map { $0.identifier }, [largeFile.identifier])
+
+        // Each batch is filled up to the target size.
+        let filesPerBatch = Int(DeviceTransferBatch.targetBatchSize / DeviceTransferBatch.maxBatchedFileSize)
+        XCTAssertEqual(batches.map { $0.files.count }, [filesPerBatch, 10 - filesPerBatch].filter { $0 > 0 })
+        XCTAssertEqual(batches.flatMap { $0.files.map { $0.identifier } }, smallFiles.map { $0.identifier })
+        XCTAssertEqual(Set(batches.map { $0.identifier }).count, batches.count)
+        XCTAssertTrue(batches.allSatisfy { DeviceTransferBatch.isBatchIdentifier($0.identifier) })
+        XCTAssertFalse(DeviceTransferBatch.isBatchIdentifier(largeFile.identifier))
+    }
+
+    func testBatchLookup() {
+        let files = (0..<40).map { _ in makeFile(size: DeviceTransferBatch.maxBatchedFileSize / 2) }
+        let (batches, _) = DeviceTransferBatch.makeBatches(files: files)
+        XCTAssertGreaterThan(batches.count, 1)
+
+        // The new device finds the same batch the old device sent.
+        for batch in batches {
+            let found = DeviceTransferBatch.batch(identifier: batch.identifier, files: files)
+            XCTAssertEqual(found?.files.map { $0.identifier }, batch.files.map { $0.identifier })
+            XCTAssertEqual(found?.estimatedSize, batch.estimatedSize)
+        }
+        XCTAssertNil(DeviceTransferBatch.batch(identifier: "batch-\(batches.count)", files: files))
+    }
+
+    func testArchiveRoundTrip() throws {
+        let compressibleData = Data(repeating: 7, count: 10_000)
+        let incompressibleData = Randomness.generateRandomBytes(10_000)
+        let emptyData = Data()
+        let files = [
+            makeFile(size: 10_000, contents: compressibleData),
+            makeFile(size: 10_000, contents: incompressibleData),
+            makeFile(size: 1, contents: emptyData),
+        ]
+        let missingFile = makeFile(size: 100)
+        let batch = DeviceTransferBatch(identifier: "batch-0", files: files + [missingFile])
+
+        let archiveUrl = baseDirectory.appendingPathComponent("archive")
+        XCTAssertTrue(try batch.writeArchive(baseDirectory: baseDirectory, to: archiveUrl))
+
+        let result = try DeviceTransferBatch.extractArchive(at: archiveUrl, to: destinationDirectory)
+        XCTAssertEqual(result.receivedFileIds, files.map { $0.identifier })
+        XCTAssertEqual(result.missingFileIds, [missingFile.identifier])
+        for (file, expectedData) in zip(files, [compressibleData, incompressibleData, emptyData]) {
+            let data = try Data(contentsOf: destinationDirectory.appendingPathComponent(file.identifier))
+            XCTAssertEqual(data, expectedData)
+        }
+    }
+
+    func testIncompressibleArchive() throws {
+        let files = (0..<3).map { _ in makeFile(size: 10_000, contents: Randomness.generateRandomBytes(10_000)) }
+        let batch = DeviceTransferBatch(identifier: "batch-0", files: files)
+
+        let archiveUrl = baseDirectory.appendingPathComponent("archive")
+        XCTAssertFalse(try batch.writeArchive(baseDirectory: baseDirectory, to: archiveUrl))
+        let result = try DeviceTransferBatch.extractArchive(at: archiveUrl, to: destinationDirectory)
+        XCTAssertEqual(result.receivedFileIds, files.map { $0.identifier })
+    }
+
+    func testRejectsInvalidArchives() throws {
+        let archiveUrl = baseDirectory.appendingPathComponent("archive")
+
+        try Data("SGTB".utf8).write(to: archiveUrl)
+        XCTAssertThrowsError(try DeviceTransferBatch.extractArchive(at: archiveUrl, to: destinationDirectory))
+
+        // An entry whose identifier would escape the destination directory.
+        var archive = Data("SGTB".utf8) + Data([1, 0])
+        archive += Data([0, 5]) + Data("../xx".utf8) + Data([0]) + Data(count: 8)
+        try archive.write(to: archiveUrl)
+        XCTAssertThrowsError(try DeviceTransferBatch.extractArchive(at: archiveUrl, to: destinationDirectory))
+
+        // An entry that's longer than the archive.
+        archive = Data("SGTB".utf8) + Data([1, 0])
+        archive += Data([0, 1]) + Data("a".utf8) + Data([0]) + Data([0, 0, 0, 0, 0, 0, 1, 0])
+        try archive.write(to: archiveUrl)
+        XCTAssertThrowsError(try DeviceTransferBatch.extractArchive(at: archiveUrl, to: destinationDirectory))
+    }
+}
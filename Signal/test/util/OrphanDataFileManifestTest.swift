@@ -0,0 +1,111 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import XCTest
+@testable import Signal
+import SignalServiceKit
+
+final class OrphanDataFileManifestTest: XCTestCase {
+    private var rootPath: String!
+    private var manifestUrl: URL!
+    /// Pretend every directory was modified long ago, so that all of them
+    /// are remembered.
+    private var dateProvider: DateProvider { { Date().addingTimeInterval(60) } }
+
+    override func setUp() {
+        super.setUp()
+        rootPath = (OWSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        manifestUrl = OWSFileSystem.temporaryFileUrl(fileExtension: "json")
+        OWSFileSystem.ensureDirectoryExists(rootPath)
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(rootPath)
+        OWSFileSystem.deleteFileIfExists(manifestUrl.path)
+        super.tearDown()
+    }
+
+    private func makeManifest() -> OrphanDataFileManifest {
+        return OrphanDataFileManifest(manifestUrl: manifestUrl, dateProvider: dateProvider)
+    }
+
+    @discardableResult
+    private func createFile(_ relativePath: String) -> String {
+        let filePath = rootPath.appendingPathComponent(relativePath)
+        OWSFileSystem.ensureDirectoryExists((filePath as NSString).deletingLastPathComponent)
+        FileManager.default.createFile(atPath: filePath, contents: Data([1]))
+        return filePath
+    }
+
+    func testReusesUnchangedDirectories() throws {
+        let expectedPaths: Set<String> = [createFile("a"), createFile("x/b"), createFile("x/y/c"), createFile("z/d")]
+
+        let firstManifest = makeManifest()
+        XCTAssertEqual(firstManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }), expectedPaths)
+        XCTAssertEqual(firstManifest.listedDirectoryCount, 4)
+        XCTAssertEqual(firstManifest.reusedDirectoryCount, 0)
+
+        let secondManifest = makeManifest()
+        XCTAssertEqual(secondManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }), expectedPaths)
+        XCTAssertEqual(secondManifest.listedDirectoryCount, 0)
+        XCTAssertEqual(secondManifest.reusedDirectoryCount, 4)
+    }
+
+    func testListsChangedDirectories() throws {
+        createFile("a")
+        let removedPath = createFile("x/b")
+        let firstManifest = makeManifest()
+        XCTAssertNotNil(firstManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }))
+
+        let addedPath = createFile("x/c")
+        try FileManager.default.removeItem(atPath: removedPath)
+
+        let secondManifest = makeManifest()
+        let filePaths = try XCTUnwrap(secondManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }))
+        XCTAssertTrue(filePaths.contains(addedPath))
+        XCTAssertFalse(filePaths.contains(removedPath))
+        XCTAssertEqual(secondManifest.listedDirectoryCount, 1)
+        XCTAssertEqual(secondManifest.reusedDirectoryCount, 1)
+    }
+
+    func testResumesAfterAbort() throws {
+        for index in 0..<10 {
+            createFile("\(index)/file")
+        }
+
+        var remainingDirectoryCount = 5
+        let abortedManifest = makeManifest()
+        let abortedResult = abortedManifest.filePaths(inDirectory: rootPath, shouldContinue: {
+            remainingDirectoryCount -= 1
+            return remainingDirectoryCount >= 0
+        })
+        XCTAssertNil(abortedResult)
+        XCTAssertEqual(abortedManifest.listedDirectoryCount, 5)
+
+        let resumedManifest = makeManifest()
+        XCTAssertEqual(resumedManifest.filePaths(inDirectory: rootPath, shouldContinue: { true })?.count, 10)
+        XCTAssertEqual(resumedManifest.reusedDirectoryCount, 5)
+        XCTAssertEqual(resumedManifest.listedDirectoryCount, 6)
+    }
+
+    func testForgetsUnvisitedDirectories() throws {
+        createFile("x/a")
+        let otherRootPath = (OWSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        OWSFileSystem.ensureDirectoryExists(otherRootPath)
+        defer { OWSFileSystem.deleteFileIfExists(otherRootPath) }
+
+        let firstManifest = makeManifest()
+        XCTAssertNotNil(firstManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }))
+        XCTAssertNotNil(firstManifest.filePaths(inDirectory: otherRootPath, shouldContinue: { true }))
+
+        let secondManifest = makeManifest()
+        XCTAssertNotNil(secondManifest.filePaths(inDirectory: otherRootPath, shouldContinue: { true }))
+        secondManifest.forgetUnvisitedDirectories()
+
+        let thirdManifest = makeManifest()
+        XCTAssertNotNil(thirdManifest.filePaths(inDirectory: rootPath, shouldContinue: { true }))
+        XCTAssertEqual(thirdManifest.listedDirectoryCount, 2)
+    }
+}
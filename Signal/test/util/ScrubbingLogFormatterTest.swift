@@ -199,6 +199,25 @@ final class ScrubbingLogFormatterTest: XCTestCase {
         XCTAssertEqual(result, input)
     }
 
+    func testNonASCIINotScrubbed() {
+        let input = "Emoji 👍🏽 and accents éàü are left alone: +1 (555)"
+        XCTAssertEqual(format(input), input)
+    }
+
+    func testSeveralKindsScrubbedInOneLine() {
+        let input = (
+            "phone: +15557340123, uuid: BAF1768C-2A25-4D8F-83B7-A89C59C98748, "
+            + "data: <01234567 89a23def>, ip: 127.0.0.1, hex: 0102030405060708, "
+            + "base64 uuid: GW/VMbPjTiyr5cSoblKBmQ=="
+        )
+        let expectedOutput = (
+            "phone: +x…123, uuid: xxxx-xx-xx-xxx748, "
+            + "data: <01…>, ip: x.x.x.1, hex: …708, "
+            + "base64 uuid: GW/…"
+        )
+        XCTAssertEqual(format(input), expectedOutput)
+    }
+
     func testIPv4AddressesScrubbed() {
         let valueMap: [String: String] = [
             "0.0.0.0": "x.x.x.0",
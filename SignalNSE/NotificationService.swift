@@ -69,9 +69,8 @@ class NotificationService: UNNotificationServiceExtension {
 
     // This method is thread-safe.
     func completeSilently(badgeCount: BadgeCount? = nil, logger: NSELogger) {
-        defer { logger.flush() }
-
         guard let contentHandler = contentHandler.swap(nil) else {
+            logger.flush()
             return
         }
 
@@ -80,6 +79,9 @@ class NotificationService: UNNotificationServiceExtension {
         let content = UNMutableNotificationContent()
         content.badge = badgeCount.map { NSNumber(value: $0.unreadTotalCount) }
 
+        // The extension may be suspended or killed as soon as it calls the
+        // content handler, so write out any buffered log lines first.
+        logger.flush()
         contentHandler(content)
     }
 
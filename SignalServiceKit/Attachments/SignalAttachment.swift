@@ -1039,6 +1039,7 @@ public class SignalAttachment: NSObject {
         do {
             let chunker = try PngChunker(data: pngData)
             var result = PngChunker.pngSignature
+            result.reserveCapacity(pngData.count)
             while let chunk = try chunker.next() {
                 if pngChunkTypesToKeep.contains(chunk.type) {
                     result += chunk.allBytes()
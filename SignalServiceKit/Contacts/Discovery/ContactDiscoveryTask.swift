@@ -77,27 +77,31 @@ final class ContactDiscoveryTaskQueueImpl: ContactDiscoveryTaskQueue {
     ) throws -> Set<SignalRecipient> {
         var registeredRecipients = Set<SignalRecipient>()
 
-        try TimeGatedBatch.enumerateObjects(discoveryResults, db: db) { discoveryResult, tx in
+        // The response includes every number we've ever looked up (not just the
+        // ones in this request), and most of those won't have changed. Merging
+        // them in chunks lets the merger resolve those with a few queries rather
+        // than a few queries apiece.
+        try TimeGatedBatch.enumerateObjects(discoveryResults.chunked(by: 250), db: db) { discoveryResultBatch, tx in
             guard let localIdentifiers = tsAccountManager.localIdentifiers(tx: tx) else {
                 throw OWSAssertionError("Not registered.")
             }
-            let recipient = recipientMerger.applyMergeFromContactDiscovery(
+            let recipients = recipientMerger.applyMergesFromContactDiscovery(
                 localIdentifiers: localIdentifiers,
-                phoneNumber: discoveryResult.e164,
-                pni: discoveryResult.pni,
-                aci: discoveryResult.aci,
+                results: discoveryResultBatch.map { ($0.e164, $0.pni, $0.aci) },
                 tx: tx
             )
-            guard let recipient else {
-                return
-            }
-            setPhoneNumberDiscoverable(true, for: recipient, tx: tx)
-            recipientManager.markAsRegisteredAndSave(recipient, shouldUpdateStorageService: true, tx: tx)
+            for (discoveryResult, recipient) in zip(discoveryResultBatch, recipients) {
+                guard let recipient else {
+                    continue
+                }
+                setPhoneNumberDiscoverable(true, for: recipient, tx: tx)
+                recipientManager.markAsRegisteredAndSave(recipient, shouldUpdateStorageService: true, tx: tx)
 
-            // We process all the results that we were provided, but we only return the
-            // recipients that were specifically requested as part of this operation.
-            if requestedPhoneNumbers.contains(discoveryResult.e164) {
-                registeredRecipients.insert(recipient)
+                // We process all the results that we were provided, but we only return the
+                // recipients that were specifically requested as part of this operation.
+                if requestedPhoneNumbers.contains(discoveryResult.e164) {
+                    registeredRecipients.insert(recipient)
+                }
             }
         }
 
@@ -480,8 +480,12 @@ final class ContactDiscoveryV2Operation {
         var aci: Aci?
     }
 
+    /// The size of each e164/pni/aci triple in a response.
+    private static let pniAciElementSize = MemoryLayout<UInt64>.size + 2 * MemoryLayout<uuid_t>.size
+
     static func decodePniAciResult(_ data: Data) throws -> [DiscoveryResult] {
         var result = [DiscoveryResult]()
+        result.reserveCapacity(data.count / pniAciElementSize)
 
         var remainingData = data
         while !remainingData.isEmpty {
@@ -217,6 +217,29 @@ public struct ComparableDisplayName {
         )
     }
 
+    /// Sorts `names` in the same order as `<`, comparing names by their keys
+    /// in `collationIndex` rather than comparing each pair of names.
+    public static func sorted(
+        _ names: [ComparableDisplayName],
+        collationIndex: DisplayNameCollationIndex = .shared
+    ) -> [ComparableDisplayName] {
+        let collationKeys = collationIndex.collationKeys(for: names.map { name -> String? in
+            guard case .nameValue(let stringValue) = name.comparableValue else {
+                return nil
+            }
+            return stringValue
+        })
+        return zip(names, collationKeys).sorted { lhs, rhs in
+            guard let lhsKey = lhs.1, let rhsKey = rhs.1 else {
+                return lhs.0 < rhs.0
+            }
+            if lhsKey != rhsKey {
+                return lhsKey < rhsKey
+            }
+            return lhs.0.comparableIdentifier < rhs.0.comparableIdentifier
+        }.map { $0.0 }
+    }
+
     public func resolvedValue(useShortNameIfAvailable: Bool = false) -> String {
         return displayName.resolvedValue(
             config: config.displayNameConfig,
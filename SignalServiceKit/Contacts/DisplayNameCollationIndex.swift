@@ -0,0 +1,111 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Assigns name strings integer keys that order the same way as
+/// `localizedCaseInsensitiveCompare`.
+///
+/// There's no public API for ICU sort keys, so keys are positions in a
+/// sorted list of every name seen so far. A new name is placed with a
+/// binary search; a name that's already been seen costs a dictionary
+/// lookup. Names that compare as equal share a key. Keys leave gaps so
+/// that inserting a name usually doesn't change any other name's key.
+///
+/// Keys are only comparable with other keys returned by the same call to
+/// `collationKeys(for:)`, since later calls may renumber them. The index is
+/// rebuilt when the current locale changes.
+public final class DisplayNameCollationIndex {
+    public static let shared = DisplayNameCollationIndex()
+
+    /// Names that compare as equal. The key is updated when the index
+    /// renumbers.
+    private final class Entry {
+        let name: String
+        var key: UInt64
+
+        init(name: String, key: UInt64) {
+            self.name = name
+            self.key = key
+        }
+    }
+
+    private let keySpacing: UInt64
+    private let maximumNameCount: Int
+
+    private let lock = UnfairLock()
+    // These properties should only be accessed with lock.
+    private var localeIdentifier: String?
+    private var sortedEntries = [Entry]()
+    private var entryByName = [String: Entry]()
+
+    init(keySpacing: UInt64 = 1 << 32, maximumNameCount: Int = 50_000) {
+        owsAssertDebug(keySpacing >= 2)
+        self.keySpacing = keySpacing
+        self.maximumNameCount = maximumNameCount
+    }
+
+    /// Returns a key for each non-nil name.
+    public func collationKeys(for names: [String?]) -> [UInt64?] {
+        return lock.withLock {
+            let localeIdentifier = Locale.current.identifier
+            if self.localeIdentifier != localeIdentifier || entryByName.count + names.count > maximumNameCount {
+                self.localeIdentifier = localeIdentifier
+                sortedEntries = []
+                entryByName = [:]
+            }
+            // Look up every entry before reading any key; inserting a name
+            // may renumber entries returned earlier in this call.
+            let entries = names.map { $0.map { entry(forName: $0) } }
+            return entries.map { $0?.key }
+        }
+    }
+
+    private func entry(forName name: String) -> Entry {
+        if let entry = entryByName[name] {
+            return entry
+        }
+
+        var lowerBound = 0
+        var upperBound = sortedEntries.count
+        while lowerBound < upperBound {
+            let middle = (lowerBound + upperBound) / 2
+            switch name.localizedCaseInsensitiveCompare(sortedEntries[middle].name) {
+            case .orderedSame:
+                let entry = sortedEntries[middle]
+                entryByName[name] = entry
+                return entry
+            case .orderedAscending:
+                upperBound = middle
+            case .orderedDescending:
+                lowerBound = middle + 1
+            }
+        }
+
+        let index = lowerBound
+        let entry = Entry(name: name, key: 0)
+        let previousKey = index > 0 ? sortedEntries[index - 1].key : 0
+        if index == sortedEntries.count, previousKey <= UInt64.max - keySpacing {
+            entry.key = previousKey + keySpacing
+            sortedEntries.append(entry)
+        } else {
+            let nextKey = index < sortedEntries.count ? sortedEntries[index].key : UInt64.max
+            sortedEntries.insert(entry, at: index)
+            if nextKey - previousKey >= 2 {
+                entry.key = previousKey + (nextKey - previousKey) / 2
+            } else {
+                renumber()
+            }
+        }
+        entryByName[name] = entry
+        return entry
+    }
+
+    private func renumber() {
+        for (index, entry) in sortedEntries.enumerated() {
+            entry.key = UInt64(index + 1) * keySpacing
+        }
+    }
+}
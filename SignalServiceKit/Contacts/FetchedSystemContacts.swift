@@ -15,34 +15,89 @@ public struct FetchedSystemContacts {
     let phoneNumberToContactRef: [CanonicalPhoneNumber: SystemContactRef]
     let cnContactIdToContact: [String: SystemContact]
 
+    /// The inputs & outputs of parsing each contact. These are retained so
+    /// that the next fetch only needs to parse contacts that have changed.
+    private let parsedContacts: [String: ParsedContact]
+    private let localPhoneNumber: CanonicalPhoneNumber?
+
+    private struct ParsedContact {
+        let systemContactHashValue: Int
+        let parsedPhoneNumbers: [ParsedPhoneNumber]
+    }
+
     private init(
         phoneNumberToContactRef: [CanonicalPhoneNumber: SystemContactRef],
-        cnContactIdToContact: [String: SystemContact]
+        cnContactIdToContact: [String: SystemContact],
+        parsedContacts: [String: ParsedContact],
+        localPhoneNumber: CanonicalPhoneNumber?
     ) {
         self.phoneNumberToContactRef = phoneNumberToContactRef
         self.cnContactIdToContact = cnContactIdToContact
+        self.parsedContacts = parsedContacts
+        self.localPhoneNumber = localPhoneNumber
     }
 
+    /// Parses the phone numbers for `orderedContacts`.
+    ///
+    /// If `priorFetchedSystemContacts` is provided, contacts that haven't
+    /// changed since that fetch reuse its parsed phone numbers, so a single
+    /// edit in a large address book only re-parses the edited contact.
+    ///
+    /// If `parsedPhoneNumberCache` is provided, it's consulted before parsing
+    /// any other phone numbers, and it's pruned to the numbers that are still
+    /// in the address book.
     static func parseContacts(
         _ orderedContacts: [SystemContact],
         phoneNumberUtil: PhoneNumberUtil,
-        localPhoneNumber: String?
+        localPhoneNumber: String?,
+        priorFetchedSystemContacts: FetchedSystemContacts? = nil,
+        parsedPhoneNumberCache: ParsedPhoneNumberCache? = nil
     ) -> FetchedSystemContacts {
         // A given Contact may have multiple phone numbers.
         var phoneNumberToContactRef = [CanonicalPhoneNumber: SystemContactRef]()
         var cnContactIdToContact = [String: SystemContact]()
+        var parsedContacts = [String: ParsedContact]()
         let localPhoneNumber = E164(localPhoneNumber).map(CanonicalPhoneNumber.init(nonCanonicalPhoneNumber:))
-        for systemContact in orderedContacts {
-            var parsedPhoneNumbers = Self._parsePhoneNumbers(
-                for: systemContact,
-                phoneNumberUtil: phoneNumberUtil,
-                localPhoneNumber: localPhoneNumber
+        // Parsing depends on the local phone number's region, so we can't reuse
+        // the prior results if it has changed.
+        let reusableParsedContacts = (
+            priorFetchedSystemContacts?.localPhoneNumber == localPhoneNumber
+            ? priorFetchedSystemContacts?.parsedContacts
+            : nil
+        ) ?? [:]
+        let systemContactHashValues = orderedContacts.map { $0.computeSystemContactHashValue() }
+        let contactsToParse = zip(orderedContacts, systemContactHashValues).filter { (systemContact, systemContactHashValue) in
+            return reusableParsedContacts[systemContact.cnContactId]?.systemContactHashValue != systemContactHashValue
+        }.map { $0.0 }
+        var newlyParsedPhoneNumbers = [String: [ParsedPhoneNumber]]()
+        let parsedPhoneNumbersForContactsToParse = Self._parsePhoneNumbers(
+            for: contactsToParse,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: localPhoneNumber,
+            parsedPhoneNumberCache: parsedPhoneNumberCache
+        )
+        for (systemContact, parsedPhoneNumbers) in zip(contactsToParse, parsedPhoneNumbersForContactsToParse) {
+            newlyParsedPhoneNumbers[systemContact.cnContactId] = parsedPhoneNumbers
+        }
+        for (systemContact, systemContactHashValue) in zip(orderedContacts, systemContactHashValues) {
+            var parsedPhoneNumbers: [ParsedPhoneNumber]
+            if let newlyParsed = newlyParsedPhoneNumbers[systemContact.cnContactId] {
+                parsedPhoneNumbers = newlyParsed
+                // Ignore any system contact records for the local contact. For the local
+                // user we never want to show the avatar / name that you have entered for
+                // yourself in your system contacts. Instead, we always want to display
+                // your profile name and avatar.
+                parsedPhoneNumbers.removeAll(where: { $0.canonicalValue == localPhoneNumber })
+            } else if let priorParsedContact = reusableParsedContacts[systemContact.cnContactId] {
+                parsedPhoneNumbers = priorParsedContact.parsedPhoneNumbers
+            } else {
+                owsFailDebug("Missing parsed phone numbers.")
+                continue
+            }
+            parsedContacts[systemContact.cnContactId] = ParsedContact(
+                systemContactHashValue: systemContactHashValue,
+                parsedPhoneNumbers: parsedPhoneNumbers
             )
-            // Ignore any system contact records for the local contact. For the local
-            // user we never want to show the avatar / name that you have entered for
-            // yourself in your system contacts. Instead, we always want to display
-            // your profile name and avatar.
-            parsedPhoneNumbers.removeAll(where: { $0.canonicalValue == localPhoneNumber })
             if parsedPhoneNumbers.isEmpty {
                 continue
             }
@@ -59,9 +114,15 @@ public struct FetchedSystemContacts {
                 )
             }
         }
+        parsedPhoneNumberCache?.removeAll(except: Set(orderedContacts.lazy.flatMap { $0.phoneNumbers.lazy.map { $0.value } }))
+        if priorFetchedSystemContacts != nil {
+            Logger.info("Parsed phone numbers for \(newlyParsedPhoneNumbers.count) of \(orderedContacts.count) contacts")
+        }
         return FetchedSystemContacts(
             phoneNumberToContactRef: phoneNumberToContactRef,
-            cnContactIdToContact: cnContactIdToContact
+            cnContactIdToContact: cnContactIdToContact,
+            parsedContacts: parsedContacts,
+            localPhoneNumber: localPhoneNumber
         )
     }
 
@@ -71,10 +132,10 @@ public struct FetchedSystemContacts {
         localPhoneNumber: CanonicalPhoneNumber?
     ) -> [CanonicalPhoneNumber] {
         return _parsePhoneNumbers(
-            for: systemContact,
+            for: [systemContact],
             phoneNumberUtil: phoneNumberUtil,
             localPhoneNumber: localPhoneNumber
-        ).map { $0.canonicalValue }
+        )[0].map { $0.canonicalValue }
     }
 
     private struct ParsedPhoneNumber {
@@ -82,26 +143,51 @@ public struct FetchedSystemContacts {
         let userProvidedLabel: String
     }
 
+    /// Parses the phone numbers for every contact in `systemContacts` as a
+    /// single batch; see `PhoneNumberUtil.parsePhoneNumbers(userSpecifiedTexts:localPhoneNumber:)`.
+    ///
+    /// Phone numbers found in `parsedPhoneNumberCache` aren't parsed again,
+    /// and newly-parsed phone numbers are added to it.
     private static func _parsePhoneNumbers(
-        for systemContact: SystemContact,
+        for systemContacts: [SystemContact],
         phoneNumberUtil: PhoneNumberUtil,
-        localPhoneNumber: CanonicalPhoneNumber?
-    ) -> [ParsedPhoneNumber] {
-        var results = [ParsedPhoneNumber]()
-        for (phoneNumber, phoneNumberLabel) in systemContact.phoneNumbers {
-            let parsedPhoneNumbers = parsePhoneNumber(
-                phoneNumber,
-                phoneNumberUtil: phoneNumberUtil,
-                localPhoneNumber: localPhoneNumber
-            )
-            for parsedPhoneNumber in parsedPhoneNumbers {
-                results.append(ParsedPhoneNumber(
-                    canonicalValue: parsedPhoneNumber,
-                    userProvidedLabel: phoneNumberLabel ?? ""
-                ))
+        localPhoneNumber: CanonicalPhoneNumber?,
+        parsedPhoneNumberCache: ParsedPhoneNumberCache? = nil
+    ) -> [[ParsedPhoneNumber]] {
+        var parsedPhoneNumbers = [String: [CanonicalPhoneNumber]]()
+        var uncachedPhoneNumbers = [String]()
+        for systemContact in systemContacts {
+            for (phoneNumber, _) in systemContact.phoneNumbers where parsedPhoneNumbers[phoneNumber] == nil {
+                if let cachedPhoneNumbers = parsedPhoneNumberCache?.phoneNumbers(for: phoneNumber) {
+                    parsedPhoneNumbers[phoneNumber] = cachedPhoneNumbers.map(CanonicalPhoneNumber.init(nonCanonicalPhoneNumber:))
+                } else {
+                    // Mark it as seen so that we only parse it once.
+                    parsedPhoneNumbers[phoneNumber] = []
+                    uncachedPhoneNumbers.append(phoneNumber)
+                }
             }
         }
-        return results
+        let batchResults = phoneNumberUtil.parsePhoneNumbers(
+            userSpecifiedTexts: uncachedPhoneNumbers,
+            localPhoneNumber: localPhoneNumber?.rawValue.stringValue
+        )
+        for (phoneNumber, batchResult) in zip(uncachedPhoneNumbers, batchResults) {
+            let e164s = e164s(for: batchResult)
+            parsedPhoneNumberCache?.setPhoneNumbers(e164s, for: phoneNumber)
+            parsedPhoneNumbers[phoneNumber] = e164s.map(CanonicalPhoneNumber.init(nonCanonicalPhoneNumber:))
+        }
+        return systemContacts.map { systemContact in
+            var results = [ParsedPhoneNumber]()
+            for (phoneNumber, phoneNumberLabel) in systemContact.phoneNumbers {
+                for parsedPhoneNumber in parsedPhoneNumbers[phoneNumber] ?? [] {
+                    results.append(ParsedPhoneNumber(
+                        canonicalValue: parsedPhoneNumber,
+                        userProvidedLabel: phoneNumberLabel ?? ""
+                    ))
+                }
+            }
+            return results
+        }
     }
 
     public static func parsePhoneNumber(
@@ -113,13 +199,17 @@ public struct FetchedSystemContacts {
             userSpecifiedText: userTextPhoneNumber,
             localPhoneNumber: localPhoneNumber?.rawValue.stringValue
         )
-        var results = [CanonicalPhoneNumber]()
+        return e164s(for: phoneNumbers).map(CanonicalPhoneNumber.init(nonCanonicalPhoneNumber:))
+    }
+
+    private static func e164s(for phoneNumbers: [PhoneNumber]) -> [E164] {
+        var results = [E164]()
         for phoneNumberObj in phoneNumbers {
             guard let phoneNumber = E164(phoneNumberObj.toE164()) else {
                 owsFailDebug("Couldn't convert parsed phone number to E164")
                 continue
             }
-            results.append(CanonicalPhoneNumber(nonCanonicalPhoneNumber: phoneNumber))
+            results.append(phoneNumber)
         }
         return results
     }
@@ -198,6 +198,9 @@ public class OWSContactsManagerSwiftValues {
 
 private class SystemContactsCache {
     let fetchedSystemContacts = AtomicOptional<FetchedSystemContacts>(nil, lock: .init())
+
+    /// Only accessed on the intersection queue.
+    var parsedPhoneNumberCache: ParsedPhoneNumberCache?
 }
 
 // MARK: -
@@ -578,20 +581,6 @@ extension OWSContactsManager: ContactManager {
 
     // MARK: - Intersection
 
-    private func buildContactAvatarHash(for systemContact: SystemContact) -> Data? {
-        return autoreleasepool {
-            let cnContactId = systemContact.cnContactId
-            guard let contactAvatarData = avatarData(for: cnContactId) else {
-                return nil
-            }
-            guard let contactAvatarHash = Cryptography.computeSHA256Digest(contactAvatarData) else {
-                owsFailDebug("Could not digest contactAvatarData.")
-                return nil
-            }
-            return contactAvatarHash
-        }
-    }
-
     private func discoverableRecipient(for canonicalPhoneNumber: CanonicalPhoneNumber, tx: SDSAnyReadTransaction) -> SignalRecipient? {
         let recipientDatabaseTable = DependenciesBridge.shared.recipientDatabaseTable
         for phoneNumber in [canonicalPhoneNumber.rawValue] + canonicalPhoneNumber.alternatePhoneNumbers() {
@@ -639,7 +628,6 @@ extension OWSContactsManager: ContactManager {
                 userProvidedLabel: contactRef.userProvidedLabel,
                 discoverablePhoneNumberCount: discoverablePhoneNumberCount
             )
-            let contactAvatarHash = buildContactAvatarHash(for: systemContact)
             let signalAccount = SignalAccount(
                 recipientPhoneNumber: signalRecipient.phoneNumber?.stringValue,
                 recipientServiceId: serviceId,
@@ -649,7 +637,7 @@ extension OWSContactsManager: ContactManager {
                 familyName: systemContact.lastName,
                 nickname: systemContact.nickname,
                 fullName: systemContact.fullName,
-                contactAvatarHash: contactAvatarHash
+                contactAvatarHash: systemContact.avatarHash
             )
             signalAccounts.append(signalAccount)
         }
@@ -848,11 +836,26 @@ extension OWSContactsManager: ContactManager {
     private func _updateContacts(_ addressBookContacts: [SystemContact]?, isUserRequested: Bool) {
         let tsAccountManager = DependenciesBridge.shared.tsAccountManager
         let localNumber = tsAccountManager.localIdentifiersWithMaybeSneakyTransaction?.phoneNumber
+        let parsedPhoneNumberCache = loadParsedPhoneNumberCache(localNumber: localNumber)
+        let startTime = CACurrentMediaTime()
         let fetchedSystemContacts = FetchedSystemContacts.parseContacts(
             addressBookContacts ?? [],
             phoneNumberUtil: NSObject.phoneNumberUtil,
-            localPhoneNumber: localNumber
+            localPhoneNumber: localNumber,
+            priorFetchedSystemContacts: swiftValues.systemContactsCache.fetchedSystemContacts.get(),
+            parsedPhoneNumberCache: parsedPhoneNumberCache
+        )
+        let parseDuration = CACurrentMediaTime() - startTime
+        Logger.info(
+            "Parsed system contacts in \(String(format: "%0.2fms", parseDuration * 1000)); "
+            + "cache hits: \(parsedPhoneNumberCache.hitCount), misses: \(parsedPhoneNumberCache.missCount)"
         )
+        parsedPhoneNumberCache.resetStatistics()
+        if parsedPhoneNumberCache.hasUnsavedChanges {
+            databaseStorage.write { tx in
+                parsedPhoneNumberCache.saveIfNeeded(keyValueStore: keyValueStore, tx: tx)
+            }
+        }
         setFetchedSystemContacts(fetchedSystemContacts)
 
         swiftValues.cnContactCache.removeAllObjects()
@@ -870,6 +873,28 @@ extension OWSContactsManager: ContactManager {
         }
     }
 
+    private func loadParsedPhoneNumberCache(localNumber: String?) -> ParsedPhoneNumberCache {
+        assertOnQueue(swiftValues.intersectionQueue)
+
+        let regionCode = PhoneNumberUtil.defaultCountryCode()
+        if
+            let parsedPhoneNumberCache = swiftValues.systemContactsCache.parsedPhoneNumberCache,
+            parsedPhoneNumberCache.isValid(localPhoneNumber: localNumber, regionCode: regionCode)
+        {
+            return parsedPhoneNumberCache
+        }
+        let parsedPhoneNumberCache = databaseStorage.read { tx in
+            return ParsedPhoneNumberCache.load(
+                localPhoneNumber: localNumber,
+                regionCode: regionCode,
+                keyValueStore: keyValueStore,
+                tx: tx
+            )
+        }
+        swiftValues.systemContactsCache.parsedPhoneNumberCache = parsedPhoneNumberCache
+        return parsedPhoneNumberCache
+    }
+
     private func fetchPriorIntersectionPhoneNumbers(tx: SDSAnyReadTransaction) -> Set<String>? {
         keyValueStore.getObject(forKey: Constants.lastKnownContactPhoneNumbers, transaction: tx) as? Set<String>
     }
@@ -1303,13 +1328,13 @@ extension ContactManager {
         let addresses = Array(addresses)
         let displayNames = self.displayNames(for: addresses, tx: tx)
         let config = DisplayName.ComparableValue.Config.current()
-        return zip(addresses, displayNames).map { (address, displayName) in
+        return ComparableDisplayName.sorted(zip(addresses, displayNames).map { (address, displayName) in
             return ComparableDisplayName(
                 address: address,
                 displayName: displayName,
                 config: config
             )
-        }.sorted(by: <)
+        })
     }
 }
 
@@ -0,0 +1,157 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import SignalCoreKit
+
+/// Remembers the E164s that were parsed from address book phone numbers.
+///
+/// Parsing is the most expensive part of refreshing system contacts, but
+/// address book entries rarely change, so results are persisted across
+/// launches. The results depend on the local phone number (for its calling
+/// code & area code) and the device's region, so the cache starts over if
+/// either of those changes.
+///
+/// Each entry is persisted as its own row, and only the entries that changed
+/// since the last save are written.
+///
+/// Not thread-safe; it's only used on the contacts intersection queue.
+final class ParsedPhoneNumberCache {
+    private struct PersistedState: Codable {
+        var localPhoneNumber: String?
+        var regionCode: String
+    }
+
+    let localPhoneNumber: String?
+    let regionCode: String
+
+    private var phoneNumbers: [String: [String]]
+
+    /// Raw phone numbers whose entries were added, changed or removed since
+    /// the last save.
+    private var changedRawPhoneNumbers = Set<String>()
+    /// Whether every persisted entry needs to be replaced, e.g. because the
+    /// local number or region changed.
+    private var needsFullSave = false
+
+    var hasUnsavedChanges: Bool { needsFullSave || !changedRawPhoneNumbers.isEmpty }
+
+    private(set) var hitCount = 0
+    private(set) var missCount = 0
+
+    init(localPhoneNumber: String?, regionCode: String) {
+        self.localPhoneNumber = localPhoneNumber
+        self.regionCode = regionCode
+        self.phoneNumbers = [:]
+    }
+
+    private init(persistedState: PersistedState, phoneNumbers: [String: [String]]) {
+        self.localPhoneNumber = persistedState.localPhoneNumber
+        self.regionCode = persistedState.regionCode
+        self.phoneNumbers = phoneNumbers
+    }
+
+    var count: Int { phoneNumbers.count }
+
+    func isValid(localPhoneNumber: String?, regionCode: String) -> Bool {
+        return self.localPhoneNumber == localPhoneNumber && self.regionCode == regionCode
+    }
+
+    /// Returns the E164s parsed from `rawPhoneNumber`, or nil if it hasn't
+    /// been parsed before.
+    func phoneNumbers(for rawPhoneNumber: String) -> [E164]? {
+        guard let phoneNumbers = phoneNumbers[rawPhoneNumber] else {
+            missCount += 1
+            return nil
+        }
+        hitCount += 1
+        return phoneNumbers.compactMap { E164($0) }
+    }
+
+    func setPhoneNumbers(_ phoneNumbers: [E164], for rawPhoneNumber: String) {
+        let newValue = phoneNumbers.map { $0.stringValue }
+        guard self.phoneNumbers[rawPhoneNumber] != newValue else {
+            return
+        }
+        self.phoneNumbers[rawPhoneNumber] = newValue
+        changedRawPhoneNumbers.insert(rawPhoneNumber)
+    }
+
+    /// Drops entries for phone numbers that are no longer in the address book.
+    func removeAll(except rawPhoneNumbers: Set<String>) {
+        for rawPhoneNumber in phoneNumbers.keys where !rawPhoneNumbers.contains(rawPhoneNumber) {
+            phoneNumbers[rawPhoneNumber] = nil
+            changedRawPhoneNumbers.insert(rawPhoneNumber)
+        }
+    }
+
+    func resetStatistics() {
+        hitCount = 0
+        missCount = 0
+    }
+
+    // MARK: - Persistence
+
+    private static let persistedStateKey = "parsedPhoneNumberCache"
+
+    /// Entries are keyed by the raw phone number they were parsed from.
+    private static let entryStore = SDSKeyValueStore(collection: "ParsedPhoneNumberCache")
+
+    static func load(
+        localPhoneNumber: String?,
+        regionCode: String,
+        keyValueStore: SDSKeyValueStore,
+        tx: SDSAnyReadTransaction
+    ) -> ParsedPhoneNumberCache {
+        let persistedState: PersistedState? = try? keyValueStore.getCodableValue(forKey: persistedStateKey, transaction: tx)
+        guard let persistedState else {
+            let emptyResult = ParsedPhoneNumberCache(localPhoneNumber: localPhoneNumber, regionCode: regionCode)
+            emptyResult.needsFullSave = true
+            return emptyResult
+        }
+        guard
+            persistedState.localPhoneNumber == localPhoneNumber,
+            persistedState.regionCode == regionCode
+        else {
+            Logger.info("Discarding parsed phone numbers because the local number or region changed.")
+            let emptyResult = ParsedPhoneNumberCache(localPhoneNumber: localPhoneNumber, regionCode: regionCode)
+            emptyResult.needsFullSave = true
+            return emptyResult
+        }
+        let decoder = JSONDecoder()
+        var phoneNumbers = [String: [String]]()
+        for (rawPhoneNumber, data) in entryStore.allDataValuesMap(transaction: tx) {
+            phoneNumbers[rawPhoneNumber] = try? decoder.decode([String].self, from: data)
+        }
+        return ParsedPhoneNumberCache(persistedState: persistedState, phoneNumbers: phoneNumbers)
+    }
+
+    func saveIfNeeded(keyValueStore: SDSKeyValueStore, tx: SDSAnyWriteTransaction) {
+        let entryStore = Self.entryStore
+        if needsFullSave {
+            let persistedState = PersistedState(localPhoneNumber: localPhoneNumber, regionCode: regionCode)
+            do {
+                try keyValueStore.setCodable(persistedState, key: Self.persistedStateKey, transaction: tx)
+            } catch {
+                owsFailDebug("Couldn't save parsed phone numbers: \(error)")
+                return
+            }
+            entryStore.removeAll(transaction: tx)
+            for (rawPhoneNumber, phoneNumbers) in phoneNumbers {
+                try? entryStore.setCodable(phoneNumbers, key: rawPhoneNumber, transaction: tx)
+            }
+        } else {
+            for rawPhoneNumber in changedRawPhoneNumbers {
+                if let phoneNumbers = phoneNumbers[rawPhoneNumber] {
+                    try? entryStore.setCodable(phoneNumbers, key: rawPhoneNumber, transaction: tx)
+                } else {
+                    entryStore.removeValue(forKey: rawPhoneNumber, transaction: tx)
+                }
+            }
+        }
+        needsFullSave = false
+        changedRawPhoneNumbers.removeAll()
+    }
+}
@@ -288,43 +288,20 @@ extension PhoneNumberUtil {
 
     @objc
     public func parsePhoneNumbers(userSpecifiedText: String, localPhoneNumber: String?) -> [PhoneNumber] {
-        var results = parsePhoneNumbers(normalizedText: userSpecifiedText, localPhoneNumber: localPhoneNumber)
-
-        // A handful of countries (Mexico, Argentina, etc.) require a "national"
-        // prefix after their country calling code.
-        //
-        // It's a bit hacky, but we reconstruct these national prefixes from
-        // libPhoneNumber's parsing logic. It's okay if we botch this a little. The
-        // risk is that we end up with some misformatted numbers with extra
-        // non-numeric regex syntax. These erroneously parsed numbers will never be
-        // presented to the user, since they'll never survive the contacts
-        // intersection.
-        //
-        // Try to apply a "national prefix" using the phone's region and using the
-        // region that corresponds to the calling code for the local phone number.
-        let countryCodes: [String] = [
-            Self.defaultCountryCode(),
-            localPhoneNumber.flatMap { countryCode(for: $0) },
-        ].compacted().removingDuplicates(uniquingElementsBy: { $0 })
-
-        for countryCode in countryCodes {
-            guard let transformRule = nationalPrefixTransformRule(countryCode: countryCode) else {
-                continue
-            }
-            guard transformRule.contains("$1") else {
-                continue
-            }
-            let normalizedText = transformRule.replacingOccurrences(of: "$1", with: userSpecifiedText)
-            guard !normalizedText.contains("$") else {
-                continue
-            }
-            results.append(contentsOf: parsePhoneNumbers(
-                normalizedText: normalizedText,
-                localPhoneNumber: localPhoneNumber
-            ))
-        }
+        let parser = BatchParser(phoneNumberUtil: self, localPhoneNumber: localPhoneNumber)
+        return parser.parsePhoneNumbers(userSpecifiedText: userSpecifiedText)
+    }
 
-        return results
+    /// Parses many phone numbers that share the same `localPhoneNumber`.
+    ///
+    /// This returns the same results as calling
+    /// `parsePhoneNumbers(userSpecifiedText:localPhoneNumber:)` for each
+    /// element of `userSpecifiedTexts`, but everything derived from the local
+    /// phone number & region is computed once, and parse results are reused
+    /// for repeated (text, region) pairs within the batch.
+    public func parsePhoneNumbers(userSpecifiedTexts: [String], localPhoneNumber: String?) -> [[PhoneNumber]] {
+        let parser = BatchParser(phoneNumberUtil: self, localPhoneNumber: localPhoneNumber)
+        return userSpecifiedTexts.map { parser.parsePhoneNumbers(userSpecifiedText: $0) }
     }
 
     /// This will try to parse the input text as a phone number using the
@@ -332,78 +309,167 @@ extension PhoneNumberUtil {
     ///
     /// Order matters; better results will appear first.
     func parsePhoneNumbers(normalizedText: String, localPhoneNumber: String?) -> [PhoneNumber] {
-        guard let text = normalizedText.filteredAsE164.nilIfEmpty else {
-            return []
+        let parser = BatchParser(phoneNumberUtil: self, localPhoneNumber: localPhoneNumber)
+        return parser.parsePhoneNumbers(normalizedText: normalizedText)
+    }
+
+    /// Holds the state that's shared when parsing many phone numbers for the
+    /// same local phone number. Not thread-safe.
+    private final class BatchParser {
+        private let phoneNumberUtil: PhoneNumberUtil
+        private let localPhoneNumber: String?
+        private let defaultCountryCode: String
+
+        /// Rules used to reconstruct "national" prefixes for the phone's region
+        /// and the local phone number's region.
+        private let nationalPrefixTransformRules: [String]
+
+        /// Note that NBPhoneNumber uses "country code" to refer to what we call a
+        /// "calling code" (i.e. 44 in +44123123).  Within SSK we use "country code"
+        /// (and sometimes "region code") to refer to a country's ISO 2-letter code
+        /// (ISO 3166-1 alpha-2).
+        private lazy var callingCodeForLocalNumber: NSNumber? = {
+            guard let localPhoneNumber else {
+                return nil
+            }
+            return phoneNumberUtil.parseE164(localPhoneNumber)?.getCallingCode()
+        }()
+
+        private lazy var localCountryCode: String? = {
+            return callingCodeForLocalNumber.map { phoneNumberUtil.probableCountryCode(forCallingCode: "+\($0)") }
+        }()
+
+        private struct ParseKey: Hashable {
+            let text: String
+            let regionCode: String
         }
 
-        var results = [PhoneNumber]()
-        var phoneNumbers = Set<String>()
+        private var parsedPhoneNumbers = [ParseKey: PhoneNumber?]()
+
+        init(phoneNumberUtil: PhoneNumberUtil, localPhoneNumber: String?) {
+            self.phoneNumberUtil = phoneNumberUtil
+            self.localPhoneNumber = localPhoneNumber
+            self.defaultCountryCode = PhoneNumberUtil.defaultCountryCode()
 
-        func tryParsing(_ text: String, countryCode: String) {
-            guard let phoneNumber = parsePhoneNumber(text, regionCode: countryCode) else {
-                return
+            let countryCodes: [String] = [
+                defaultCountryCode,
+                localPhoneNumber.flatMap { phoneNumberUtil.countryCode(for: $0) },
+            ].compacted().removingDuplicates(uniquingElementsBy: { $0 })
+
+            self.nationalPrefixTransformRules = countryCodes.compactMap { countryCode in
+                guard let transformRule = phoneNumberUtil.nationalPrefixTransformRule(countryCode: countryCode) else {
+                    return nil
+                }
+                guard transformRule.contains("$1") else {
+                    return nil
+                }
+                return transformRule
             }
-            guard phoneNumbers.insert(phoneNumber.toE164()).inserted else {
-                return
+        }
+
+        private func parsePhoneNumber(_ text: String, regionCode: String) -> PhoneNumber? {
+            let parseKey = ParseKey(text: text, regionCode: regionCode)
+            if let phoneNumber = parsedPhoneNumbers[parseKey] {
+                return phoneNumber
             }
-            results.append(phoneNumber)
+            let phoneNumber = phoneNumberUtil.parsePhoneNumber(text, regionCode: regionCode)
+            parsedPhoneNumbers[parseKey] = phoneNumber
+            return phoneNumber
         }
 
-        let defaultCountryCode = Self.defaultCountryCode()
+        func parsePhoneNumbers(userSpecifiedText: String) -> [PhoneNumber] {
+            var results = parsePhoneNumbers(normalizedText: userSpecifiedText)
 
-        tryParsing(text, countryCode: defaultCountryCode)
+            // A handful of countries (Mexico, Argentina, etc.) require a "national"
+            // prefix after their country calling code.
+            //
+            // It's a bit hacky, but we reconstruct these national prefixes from
+            // libPhoneNumber's parsing logic. It's okay if we botch this a little. The
+            // risk is that we end up with some misformatted numbers with extra
+            // non-numeric regex syntax. These erroneously parsed numbers will never be
+            // presented to the user, since they'll never survive the contacts
+            // intersection.
+            //
+            // Try to apply a "national prefix" using the phone's region and using the
+            // region that corresponds to the calling code for the local phone number.
+            for transformRule in nationalPrefixTransformRules {
+                let normalizedText = transformRule.replacingOccurrences(of: "$1", with: userSpecifiedText)
+                guard !normalizedText.contains("$") else {
+                    continue
+                }
+                results.append(contentsOf: parsePhoneNumbers(normalizedText: normalizedText))
+            }
 
-        if text.hasPrefix("+") {
-            // If the text starts with "+", don't try prepending
-            // anything else.
             return results
         }
 
-        // Try just adding "+" and parsing it.
-        tryParsing("+" + text, countryCode: defaultCountryCode)
+        func parsePhoneNumbers(normalizedText: String) -> [PhoneNumber] {
+            guard let text = normalizedText.filteredAsE164.nilIfEmpty else {
+                return []
+            }
 
-        // Order matters; better results should appear first so prefer
-        // matches with the same country code as this client's phone number.
-        guard let localPhoneNumber else {
-            owsFailDebug("localPhoneNumber is missing")
-            return results
-        }
+            var results = [PhoneNumber]()
+            var phoneNumbers = Set<String>()
 
-        // Note that NBPhoneNumber uses "country code" to refer to what we call a
-        // "calling code" (i.e. 44 in +44123123).  Within SSK we use "country code"
-        // (and sometimes "region code") to refer to a country's ISO 2-letter code
-        // (ISO 3166-1 alpha-2).
-        guard let callingCodeForLocalNumber = parseE164(localPhoneNumber)?.getCallingCode() else {
-            owsFailDebug("callingCodeForLocalNumber is missing")
-            return results
-        }
+            func tryParsing(_ text: String, countryCode: String) {
+                guard let phoneNumber = parsePhoneNumber(text, regionCode: countryCode) else {
+                    return
+                }
+                guard phoneNumbers.insert(phoneNumber.toE164()).inserted else {
+                    return
+                }
+                results.append(phoneNumber)
+            }
 
-        let callingCodePrefix = "+\(callingCodeForLocalNumber)"
+            tryParsing(text, countryCode: defaultCountryCode)
 
-        tryParsing(callingCodePrefix + text, countryCode: defaultCountryCode)
+            if text.hasPrefix("+") {
+                // If the text starts with "+", don't try prepending
+                // anything else.
+                return results
+            }
 
-        // Try to determine what the country code is for the local phone number and
-        // also try parsing the phone number using that country code if it differs
-        // from the device's region code.
-        //
-        // For example, a French person living in Italy might have an Italian phone
-        // number but use French region/language for their phone. They're likely to
-        // have both Italian and French contacts.
-        let localCountryCode = probableCountryCode(forCallingCode: callingCodePrefix)
-        if localCountryCode != defaultCountryCode {
-            tryParsing(callingCodePrefix + text, countryCode: localCountryCode)
-        }
+            // Try just adding "+" and parsing it.
+            tryParsing("+" + text, countryCode: defaultCountryCode)
 
-        let phoneNumberWithAreaCodeIfMissing = Self.phoneNumberWithAreaCodeIfMissing(
-            normalizedText: text,
-            localCallingCode: callingCodeForLocalNumber,
-            localPhoneNumber: localPhoneNumber
-        )
-        if let phoneNumberWithAreaCodeIfMissing {
-            tryParsing(phoneNumberWithAreaCodeIfMissing, countryCode: localCountryCode)
-        }
+            // Order matters; better results should appear first so prefer
+            // matches with the same country code as this client's phone number.
+            guard let localPhoneNumber else {
+                owsFailDebug("localPhoneNumber is missing")
+                return results
+            }
 
-        return results
+            guard let callingCodeForLocalNumber, let localCountryCode else {
+                owsFailDebug("callingCodeForLocalNumber is missing")
+                return results
+            }
+
+            let callingCodePrefix = "+\(callingCodeForLocalNumber)"
+
+            tryParsing(callingCodePrefix + text, countryCode: defaultCountryCode)
+
+            // Try to determine what the country code is for the local phone number and
+            // also try parsing the phone number using that country code if it differs
+            // from the device's region code.
+            //
+            // For example, a French person living in Italy might have an Italian phone
+            // number but use French region/language for their phone. They're likely to
+            // have both Italian and French contacts.
+            if localCountryCode != defaultCountryCode {
+                tryParsing(callingCodePrefix + text, countryCode: localCountryCode)
+            }
+
+            let phoneNumberWithAreaCodeIfMissing = PhoneNumberUtil.phoneNumberWithAreaCodeIfMissing(
+                normalizedText: text,
+                localCallingCode: callingCodeForLocalNumber,
+                localPhoneNumber: localPhoneNumber
+            )
+            if let phoneNumberWithAreaCodeIfMissing {
+                tryParsing(phoneNumberWithAreaCodeIfMissing, countryCode: localCountryCode)
+            }
+
+            return results
+        }
     }
 
     /// Adds the local user's area code to `normalizedText` if it doesn't have its own.
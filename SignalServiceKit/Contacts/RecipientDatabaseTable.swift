@@ -10,6 +10,7 @@ public protocol RecipientDatabaseTable {
     func fetchRecipient(rowId: Int64, tx: DBReadTransaction) -> SignalRecipient?
     func fetchRecipient(serviceId: ServiceId, transaction: DBReadTransaction) -> SignalRecipient?
     func fetchRecipient(phoneNumber: String, transaction: DBReadTransaction) -> SignalRecipient?
+    func fetchRecipients(phoneNumbers: [String], transaction: DBReadTransaction) -> [SignalRecipient]
 
     func enumerateAll(tx: DBReadTransaction, block: (SignalRecipient) -> Void)
 
@@ -68,6 +69,10 @@ public class RecipientDatabaseTableImpl: RecipientDatabaseTable {
         SignalRecipientFinder().signalRecipientForPhoneNumber(phoneNumber, tx: SDSDB.shimOnlyBridge(tx))
     }
 
+    public func fetchRecipients(phoneNumbers: [String], transaction tx: DBReadTransaction) -> [SignalRecipient] {
+        SignalRecipientFinder().signalRecipients(forPhoneNumbers: phoneNumbers, tx: SDSDB.shimOnlyBridge(tx))
+    }
+
     public func enumerateAll(tx: DBReadTransaction, block: (SignalRecipient) -> Void) {
         SignalRecipient.anyEnumerate(transaction: SDSDB.shimOnlyBridge(tx), block: { recipient, _ in block(recipient) })
     }
@@ -103,6 +108,14 @@ class MockRecipientDatabaseTable: RecipientDatabaseTable {
         return recipientTable.values.first(where: { $0.phoneNumber?.stringValue == phoneNumber })?.copyRecipient() ?? nil
     }
 
+    var fetchRecipientsCallCount = 0
+
+    func fetchRecipients(phoneNumbers: [String], transaction: DBReadTransaction) -> [SignalRecipient] {
+        fetchRecipientsCallCount += 1
+        let phoneNumbers = Set(phoneNumbers)
+        return recipientTable.values.filter({ $0.phoneNumber.map { phoneNumbers.contains($0.stringValue) } ?? false }).map { $0.copyRecipient() }
+    }
+
     func enumerateAll(tx: DBReadTransaction, block: (SignalRecipient) -> Void) {
         recipientTable.forEach({ block($0.value) })
     }
@@ -42,6 +42,17 @@ public protocol RecipientMerger {
         tx: DBWriteTransaction
     ) -> SignalRecipient?
 
+    /// We've learned about many associations from CDS.
+    ///
+    /// Equivalent to calling ``applyMergeFromContactDiscovery`` for each
+    /// result, in order, but results that are already reflected in the
+    /// database are resolved with a handful of batched queries.
+    func applyMergesFromContactDiscovery(
+        localIdentifiers: LocalIdentifiers,
+        results: [(phoneNumber: E164, pni: Pni, aci: Aci?)],
+        tx: DBWriteTransaction
+    ) -> [SignalRecipient?]
+
     /// We've learned about an association from a Sealed Sender message. These
     /// always come from an ACI, but they might not have a phone number if phone
     /// number sharing is disabled.
@@ -376,6 +387,73 @@ class RecipientMergerImpl: RecipientMerger {
         return mergeAlways(phoneNumber: phoneNumber, pni: pni, isLocalRecipient: false, tx: tx)
     }
 
+    func applyMergesFromContactDiscovery(
+        localIdentifiers: LocalIdentifiers,
+        results: [(phoneNumber: E164, pni: Pni, aci: Aci?)],
+        tx: DBWriteTransaction
+    ) -> [SignalRecipient?] {
+        // Nearly every result matches what's already in the database, and those
+        // merges don't change anything. Fetch the recipients for all the phone
+        // numbers at once so that we can identify them without any more queries.
+        var phoneNumberRecipients = [String: SignalRecipient]()
+        let phoneNumbers = results.map { $0.phoneNumber.stringValue }
+        for recipient in recipientDatabaseTable.fetchRecipients(phoneNumbers: phoneNumbers, transaction: tx) {
+            if let phoneNumber = recipient.phoneNumber?.stringValue {
+                phoneNumberRecipients[phoneNumber] = recipient
+            }
+        }
+
+        // Any other result is merged as usual. Those merges may modify every
+        // recipient that holds one of their identifiers, so we stop trusting
+        // the prefetched copy of any such recipient.
+        var modifiedPhoneNumbers = Set<String>()
+        var modifiedServiceIds = Set<ServiceId>()
+        func isUnmodified(_ recipient: SignalRecipient) -> Bool {
+            if let phoneNumber = recipient.phoneNumber?.stringValue, modifiedPhoneNumbers.contains(phoneNumber) {
+                return false
+            }
+            if let aci = recipient.aci, modifiedServiceIds.contains(aci) {
+                return false
+            }
+            if let pni = recipient.pni, modifiedServiceIds.contains(pni) {
+                return false
+            }
+            return true
+        }
+
+        var unchangedCount = 0
+        let mergedRecipients = results.map { result -> SignalRecipient? in
+            if
+                !localIdentifiers.containsAnyOf(aci: result.aci, phoneNumber: result.phoneNumber, pni: result.pni),
+                let recipient = phoneNumberRecipients[result.phoneNumber.stringValue],
+                recipient.pni == result.pni,
+                result.aci == nil || recipient.aci == result.aci,
+                isUnmodified(recipient)
+            {
+                // This is the same early return that both `mergeAlways` calls in
+                // `applyMergeFromContactDiscovery` would take.
+                unchangedCount += 1
+                return recipient
+            }
+            modifiedPhoneNumbers.insert(result.phoneNumber.stringValue)
+            modifiedServiceIds.insert(result.pni)
+            if let aci = result.aci {
+                modifiedServiceIds.insert(aci)
+            }
+            return applyMergeFromContactDiscovery(
+                localIdentifiers: localIdentifiers,
+                phoneNumber: result.phoneNumber,
+                pni: result.pni,
+                aci: result.aci,
+                tx: tx
+            )
+        }
+        if unchangedCount < results.count {
+            Logger.info("Merged \(results.count - unchangedCount) of \(results.count) CDS results")
+        }
+        return mergedRecipients
+    }
+
     func splitUnregisteredRecipientIfNeeded(
         localIdentifiers: LocalIdentifiers,
         unregisteredRecipient: SignalRecipient,
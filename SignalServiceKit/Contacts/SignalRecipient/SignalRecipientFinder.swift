@@ -4,6 +4,7 @@
 //
 
 import Foundation
+import GRDB
 import LibSignalClient
 import SignalCoreKit
 
@@ -29,6 +30,21 @@ public class SignalRecipientFinder {
         return SignalRecipient.anyFetch(sql: sql, arguments: [phoneNumber], transaction: tx)
     }
 
+    /// Fetches the recipients for `phoneNumbers` using as few queries as
+    /// possible. Phone numbers without a recipient are omitted.
+    public func signalRecipients(forPhoneNumbers phoneNumbers: [String], tx: SDSAnyReadTransaction) -> [SignalRecipient] {
+        var result = [SignalRecipient]()
+        // Stay well below SQLite's limit on the number of bound arguments.
+        for phoneNumberBatch in phoneNumbers.chunked(by: 500) {
+            let placeholders = Array(repeating: "?", count: phoneNumberBatch.count).joined(separator: ",")
+            let sql = "SELECT * FROM \(SignalRecipient.databaseTableName) WHERE \(signalRecipientColumn: .phoneNumber) IN (\(placeholders))"
+            SignalRecipient.anyEnumerate(transaction: tx, sql: sql, arguments: StatementArguments(Array(phoneNumberBatch))) { signalRecipient, _ in
+                result.append(signalRecipient)
+            }
+        }
+        return result
+    }
+
     public func signalRecipient(for address: SignalServiceAddress, tx: SDSAnyReadTransaction) -> SignalRecipient? {
         if let recipient = signalRecipientForServiceId(address.serviceId, tx: tx) {
             return recipient
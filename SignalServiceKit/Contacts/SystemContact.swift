@@ -19,6 +19,10 @@ public struct SystemContact {
     public let fullName: String
     public let phoneNumbers: [(value: String, label: String?)]
     public let emailAddresses: [String]
+    /// The SHA-256 digest of the contact's avatar, if the avatar was fetched
+    /// along with the contact. Computing it here avoids a separate
+    /// `CNContactStore` fetch per contact when building `SignalAccount`s.
+    public let avatarHash: Data?
 
     public init(cnContact: CNContact) {
         if cnContact.phoneNumbers.count > Constants.maxPhoneNumbers {
@@ -45,6 +49,9 @@ public struct SystemContact {
         self.fullName = Self.formattedFullName(for: cnContact)
         self.phoneNumbers = phoneNumbers
         self.emailAddresses = emailAddresses
+        self.avatarHash = Self.prefetchedAvatarData(for: cnContact).flatMap {
+            Cryptography.computeSHA256Digest($0)
+        }
     }
 
     /// This method is used to de-bounce system contact fetch notifications by
@@ -58,6 +65,7 @@ public struct SystemContact {
         hasher.combine(nickname)
         hasher.combine(phoneNumbers.map { $0.value })
         hasher.combine(phoneNumbers.map { $0.label })
+        hasher.combine(avatarHash)
         // Don't include "emails" because it doesn't impact system contacts.
         return hasher.finalize()
     }
@@ -69,6 +77,18 @@ public struct SystemContact {
         return cnContact.thumbnailImageData ?? cnContact.imageData
     }
 
+    /// Like `avatarData(for:)`, but only consults keys that were included in
+    /// the fetch request (e.g., the NSE doesn't fetch avatars).
+    private static func prefetchedAvatarData(for cnContact: CNContact) -> Data? {
+        if cnContact.isKeyAvailable(CNContactThumbnailImageDataKey), let thumbnailImageData = cnContact.thumbnailImageData {
+            return thumbnailImageData
+        }
+        if cnContact.isKeyAvailable(CNContactImageDataKey), let imageData = cnContact.imageData {
+            return imageData
+        }
+        return nil
+    }
+
     // MARK: - vCards
 
     public static func parseVCardData(_ vCardData: Data) throws -> CNContact {
@@ -0,0 +1,174 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import CocoaLumberjack
+import Foundation
+
+/// A file logger that writes lines in batches.
+///
+/// `DDFileLogger` writes each line to its file as soon as it's logged, which
+/// costs a couple of system calls per line. While catching up on messages we
+/// can log thousands of lines a second; the logger falls behind, DDLog's
+/// queue fills up, and the threads doing the logging have to wait for it.
+///
+/// This logger formats each line as it arrives, but only writes once
+/// `maximumBufferSize` bytes have built up or `maximumBufferDelay` has passed.
+/// Warnings and errors are written straight away, in case the app is about
+/// to crash. Files that log too much are rate limited (see `LogRateLimiter`).
+final class BatchingFileLogger: DDFileLogger {
+    static let maximumBufferSize = 64 * 1024
+    static let maximumBufferDelay: TimeInterval = 1
+
+    /// Formats each line. Unlike `logFormatter`, which must stay nil so that
+    /// batches are written as they are, this is safe to use on the logger's
+    /// queue. Set it before adding the logger.
+    var lineFormatter: DDLogFormatter?
+
+    // These are only accessed on `loggerQueue`.
+    private var buffer = ""
+    private var bufferSize = 0
+    private var isFlushScheduled = false
+    private var rateLimiter = LogRateLimiter()
+
+    override func log(message logMessage: DDLogMessage) {
+        let isUrgent = !logMessage.flag.isDisjoint(with: [.error, .warning])
+
+        switch rateLimiter.admit(fileName: logMessage.fileName, at: logMessage.timestamp, isUrgent: isUrgent) {
+        case .drop:
+            return
+        case .admit(let droppedCount):
+            if droppedCount > 0 {
+                appendLine(for: droppedLinesMessage(count: droppedCount, for: logMessage))
+            }
+            appendLine(for: logMessage)
+        }
+
+        if isUrgent || bufferSize >= Self.maximumBufferSize {
+            writeBuffer()
+        } else {
+            scheduleFlush()
+        }
+    }
+
+    override func flush() {
+        guard isOnInternalLoggerQueue else {
+            // Like DDFileLogger, hop onto our queue if called from elsewhere.
+            DDLog.loggingQueue.sync { loggerQueue.sync { flush() } }
+            return
+        }
+        writeBuffer()
+        super.flush()
+    }
+
+    private func appendLine(for logMessage: DDLogMessage) {
+        let line: String?
+        if let lineFormatter {
+            line = lineFormatter.format(message: logMessage)
+        } else {
+            line = logMessage.message
+        }
+        guard let line else {
+            return
+        }
+        buffer.append(line)
+        buffer.append("\n")
+        bufferSize += line.utf8.count + 1
+    }
+
+    private func scheduleFlush() {
+        guard !isFlushScheduled else {
+            return
+        }
+        isFlushScheduled = true
+        // This is weak so that a removed logger is released, rather than
+        // writing to its file after it's been disabled.
+        loggerQueue.asyncAfter(deadline: .now() + Self.maximumBufferDelay) { [weak self] in
+            self?.writeBuffer()
+        }
+    }
+
+    private func writeBuffer() {
+        isFlushScheduled = false
+        guard !buffer.isEmpty else {
+            return
+        }
+        // DDFileLogger adds the final newline.
+        buffer.removeLast()
+        super.log(message: DDLogMessage(
+            message: buffer,
+            level: .all,
+            flag: .info,
+            context: 0,
+            file: "",
+            function: nil,
+            line: 0,
+            tag: nil,
+            options: [],
+            timestamp: nil
+        ))
+        buffer = ""
+        bufferSize = 0
+    }
+
+    private func droppedLinesMessage(count: Int, for logMessage: DDLogMessage) -> DDLogMessage {
+        return DDLogMessage(
+            message: "Dropped \(count) lines, this file logged too much.",
+            level: logMessage.level,
+            flag: .warning,
+            context: 0,
+            file: logMessage.file,
+            function: nil,
+            line: 0,
+            tag: nil,
+            options: [],
+            timestamp: logMessage.timestamp
+        )
+    }
+}
+
+// MARK: -
+
+/// Limits how many lines each source file can log per second.
+///
+/// A loop that logs every iteration can fill the log files in minutes, and
+/// push out everything that came before it. Lines past the limit are dropped,
+/// and the next line that's allowed through is preceded by a count of them.
+/// Warnings and errors are never dropped.
+struct LogRateLimiter {
+    static let maximumLinesPerSecond = 500
+
+    enum Decision: Equatable {
+        case drop
+        /// The line should be logged, after noting the lines dropped since
+        /// the last one from the same file.
+        case admit(droppedCount: Int)
+    }
+
+    private struct Window {
+        var startTime: Date
+        var lineCount: Int
+        var droppedCount: Int
+    }
+
+    private var windows = [String: Window]()
+
+    mutating func admit(fileName: String, at timestamp: Date, isUrgent: Bool) -> Decision {
+        var window = windows[fileName] ?? Window(startTime: timestamp, lineCount: 0, droppedCount: 0)
+        if timestamp.timeIntervalSince(window.startTime) >= 1 {
+            window.startTime = timestamp
+            window.lineCount = 0
+        }
+        defer { windows[fileName] = window }
+
+        window.lineCount += 1
+        guard isUrgent || window.lineCount <= Self.maximumLinesPerSecond else {
+            window.droppedCount += 1
+            return .drop
+        }
+        let droppedCount = window.droppedCount
+        window.droppedCount = 0
+        return .admit(droppedCount: droppedCount)
+    }
+}
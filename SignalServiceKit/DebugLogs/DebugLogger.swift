@@ -162,17 +162,21 @@ public final class DebugLogger {
         // file size). Keep extra log files in internal builds.
         logFileManager.maximumNumberOfLogFiles = DebugFlags.extraDebugLogs ? 32 : 3
 
-        let fileLogger = DDFileLogger(logFileManager: logFileManager)
+        let fileLogger = BatchingFileLogger(logFileManager: logFileManager)
         fileLogger.rollingFrequency = kDayInterval
         fileLogger.maximumFileSize = 3 * 1024 * 1024
-        fileLogger.logFormatter = ScrubbingLogFormatter()
+        fileLogger.lineFormatter = ScrubbingLogFormatter()
 
         self.fileLogger = fileLogger
         DDLog.add(fileLogger)
+
+        PerformanceMetrics.shared.startLoggingSnapshots()
     }
 
     public func disableFileLogging() {
         guard let fileLogger else { return }
+        // Write out anything the logger is holding on to before removing it.
+        DDLog.flushLog()
         DDLog.remove(fileLogger)
         self.fileLogger = nil
     }
@@ -12,7 +12,7 @@ final class LogFormatter: NSObject, DDLogFormatter {
     }
 
     static func formatLogMessage(_ logMessage: DDLogMessage, modifiedMessage: String?) -> String {
-        let timestamp = dateFormatter.string(from: logMessage.timestamp)
+        let timestamp = formattedTimestamp(for: logMessage.timestamp)
         let level = Self.formattedLevel(for: logMessage.flag)
         let location = Self.formattedLocation(logMessage: logMessage)
         let message = modifiedMessage ?? logMessage.message
@@ -26,10 +26,37 @@ final class LogFormatter: NSObject, DDLogFormatter {
         formatter.formatterBehavior = .behavior10_4
         formatter.locale = Locale(identifier: "en_US_POSIX")
         formatter.timeZone = TimeZone(secondsFromGMT: 0)
-        formatter.dateFormat = "yyyy/MM/dd HH:mm:ss:SSS"
+        formatter.dateFormat = "yyyy/MM/dd HH:mm:ss"
         return formatter
     }()
 
+    /// The last second that was formatted, and its formatted value.
+    ///
+    /// Formatting dates is one of the slowest parts of logging a line, and
+    /// most lines are logged in the same second as the one before, so only
+    /// the milliseconds are formatted for each line.
+    private static let timestampCache = AtomicValue<(second: Int, formattedSecond: String)?>(nil, lock: .init())
+
+    static func formattedTimestamp(for date: Date) -> String {
+        let timeInterval = date.timeIntervalSince1970
+        let second = Int(timeInterval.rounded(.down))
+        let millisecond = min(999, max(0, Int((timeInterval - Double(second)) * 1000)))
+
+        let formattedSecond: String
+        if let cached = timestampCache.get(), cached.second == second {
+            formattedSecond = cached.formattedSecond
+        } else {
+            formattedSecond = dateFormatter.string(from: Date(timeIntervalSince1970: TimeInterval(second)))
+            timestampCache.set((second, formattedSecond))
+        }
+
+        switch millisecond {
+        case 0..<10: return "\(formattedSecond):00\(millisecond)"
+        case 10..<100: return "\(formattedSecond):0\(millisecond)"
+        default: return "\(formattedSecond):\(millisecond)"
+        }
+    }
+
     private static func formattedLevel(for flag: DDLogFlag) -> String {
         if flag.contains(.error) { return "❤️" }
         if flag.contains(.warning) { return "🧡" }
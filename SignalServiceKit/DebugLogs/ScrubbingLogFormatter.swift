@@ -8,14 +8,98 @@ import Foundation
 import SignalCoreKit
 
 class ScrubbingLogFormatter: NSObject, DDLogFormatter {
+    /// Features of a log line that some replacement needs in order to match.
+    ///
+    /// Every line is scanned once for all of them, and only the replacements
+    /// whose features are present are run. Most lines have nothing to redact,
+    /// and skip the regular expressions entirely.
+    ///
+    /// Replacements never introduce a feature that a later replacement needs
+    /// (or lengthen a run of hex digits), so the features of the original line
+    /// are enough to decide which replacements to run.
+    private struct Features: OptionSet {
+        let rawValue: UInt16
+
+        /// "+" followed by at least 10 digits.
+        static let plusAndDigits = Features(rawValue: 1 << 0)
+        static let letterG = Features(rawValue: 1 << 1)
+        static let equals = Features(rawValue: 1 << 2)
+        static let doubleEquals = Features(rawValue: 1 << 3)
+        static let hyphen = Features(rawValue: 1 << 4)
+        static let lessThan = Features(rawValue: 1 << 5)
+        static let openBrace = Features(rawValue: 1 << 6)
+        static let colon = Features(rawValue: 1 << 7)
+        static let period = Features(rawValue: 1 << 8)
+        /// At least 12 consecutive hex digits, like the end of a UUID.
+        static let hexRun12 = Features(rawValue: 1 << 9)
+        /// At least 14 consecutive hex digits.
+        static let hexRun14 = Features(rawValue: 1 << 10)
+
+        init(rawValue: UInt16) {
+            self.rawValue = rawValue
+        }
+
+        init(scanning string: String) {
+            var features: Features = []
+            var hexRunLength = 0
+            var digitsAfterPlus: Int?
+            var previousByte: UInt8 = 0
+
+            for byte in string.utf8 {
+                switch byte {
+                // `\d` matches digits from every script, so treat any
+                // non-ASCII byte as if it might be part of a digit.
+                case UInt8(ascii: "0")...UInt8(ascii: "9"), 0x80...0xFF:
+                    hexRunLength += 1
+                    if let count = digitsAfterPlus {
+                        digitsAfterPlus = count + 1
+                        if count + 1 >= 10 {
+                            features.insert(.plusAndDigits)
+                        }
+                    }
+                case UInt8(ascii: "a")...UInt8(ascii: "f"), UInt8(ascii: "A")...UInt8(ascii: "F"):
+                    hexRunLength += 1
+                    digitsAfterPlus = nil
+                default:
+                    hexRunLength = 0
+                    digitsAfterPlus = nil
+                    switch byte {
+                    case UInt8(ascii: "+"): digitsAfterPlus = 0
+                    case UInt8(ascii: "g"): features.insert(.letterG)
+                    case UInt8(ascii: "="):
+                        features.insert(.equals)
+                        if previousByte == UInt8(ascii: "=") {
+                            features.insert(.doubleEquals)
+                        }
+                    case UInt8(ascii: "-"): features.insert(.hyphen)
+                    case UInt8(ascii: "<"): features.insert(.lessThan)
+                    case UInt8(ascii: "{"): features.insert(.openBrace)
+                    case UInt8(ascii: ":"): features.insert(.colon)
+                    case UInt8(ascii: "."): features.insert(.period)
+                    default: break
+                    }
+                }
+                if hexRunLength >= 12 {
+                    features.insert(hexRunLength >= 14 ? [.hexRun12, .hexRun14] : .hexRun12)
+                }
+                previousByte = byte
+            }
+
+            self = features
+        }
+    }
+
     private struct Replacement {
         let regex: NSRegularExpression
         let replacementTemplate: String
+        /// Features that every match of `regex` contains.
+        let requiredFeatures: Features
 
         init(
             pattern: String,
             options: NSRegularExpression.Options = [],
-            replacementTemplate: String
+            replacementTemplate: String,
+            requiredFeatures: Features
         ) {
             do {
                 self.regex = try .init(pattern: pattern, options: options)
@@ -24,6 +108,7 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
             }
 
             self.replacementTemplate = replacementTemplate
+            self.requiredFeatures = requiredFeatures
         }
 
         static func groupId(length: Int) -> Replacement {
@@ -48,25 +133,29 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
 
             return Replacement(
                 pattern: "(^|[^\(base64Character)])\(prefix)[\(base64Character)]{\(redactedLength)}([\(base64Character)]{\(unredactedLength)}\(paddingCharacter){\(base64Padding)})",
-                replacementTemplate: "$1g…$2"
+                replacementTemplate: "$1g…$2",
+                requiredFeatures: [.letterG, .equals]
             )
         }
 
         static let phoneNumber: Replacement = Replacement(
             pattern: #"\+\d{7,12}(\d{3})"#,
-            replacementTemplate: "+x…$1"
+            replacementTemplate: "+x…$1",
+            requiredFeatures: .plusAndDigits
         )
 
         static let uuid: Replacement = Replacement(
             pattern: #"[\da-f]{8}\-[\da-f]{4}\-[\da-f]{4}\-[\da-f]{4}\-[\da-f]{9}([\da-f]{3})"#,
             options: .caseInsensitive,
-            replacementTemplate: "xxxx-xx-xx-xxx$1"
+            replacementTemplate: "xxxx-xx-xx-xxx$1",
+            requiredFeatures: [.hyphen, .hexRun12]
         )
 
         static let data: Replacement = Replacement(
             pattern: #"<([\da-f]{2})[\da-f]{0,6}( [\da-f]{2,8})*>"#,
             options: .caseInsensitive,
-            replacementTemplate: "<$1…>"
+            replacementTemplate: "<$1…>",
+            requiredFeatures: .lessThan
         )
 
         /// On iOS 13, when built with the 13 SDK, NSData's description has changed and needs to be
@@ -76,7 +165,8 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
         static let iOS13Data: Replacement = Replacement(
             pattern: #"\{length = \d+, bytes = 0x([\da-f]{2})[\.\da-f ]*\}"#,
             options: .caseInsensitive,
-            replacementTemplate: "<$1…>"
+            replacementTemplate: "<$1…>",
+            requiredFeatures: .openBrace
         )
 
         /// IPv6 addresses are _hard_.
@@ -98,18 +188,21 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
                + "::([fF]{4}(:0{1,4}){0,1}:){0,1}([0-9]{1,3}\\.){3,3}[0-9]{1,3}|"
                + ":((:[0-9a-fA-F]{1,4}){1,7}|:)"
             ),
-            replacementTemplate: "[IPV6]"
+            replacementTemplate: "[IPV6]",
+            requiredFeatures: .colon
         )
 
         static let ipv4Address: Replacement = Replacement(
             pattern: "\\d+\\.\\d+\\.\\d+\\.(\\d+)",
-            replacementTemplate: "x.x.x.$1"
+            replacementTemplate: "x.x.x.$1",
+            requiredFeatures: .period
         )
 
         static let hex: Replacement = Replacement(
             pattern: "[\\da-f]{11,}([\\da-f]{3})",
             options: .caseInsensitive,
-            replacementTemplate: "…$1"
+            replacementTemplate: "…$1",
+            requiredFeatures: .hexRun14
         )
 
         /// Redact base64 encoded UUIDs.
@@ -133,7 +226,8 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
                 // Match the trailing padding
                 + #"=="#
             ),
-            replacementTemplate: "$1$2…"
+            replacementTemplate: "$1$2…",
+            requiredFeatures: .doubleEquals
         )
     }
 
@@ -157,20 +251,31 @@ class ScrubbingLogFormatter: NSObject, DDLogFormatter {
     }
 
     func redactMessage(_ logString: String) -> String {
-        var logString = logString
-
         if logString.contains("/Attachments/") {
             return "[USER_PATH]"
         }
 
-        for replacement in replacements {
-            logString = replacement.regex.stringByReplacingMatches(
-                in: logString,
-                range: logString.entireRange,
+        let features = Features(scanning: logString)
+        guard !features.isEmpty else {
+            return logString
+        }
+
+        // Replace matches in place, rather than making a new string for
+        // every replacement.
+        var mutableLogString: NSMutableString?
+        for replacement in replacements where features.isSuperset(of: replacement.requiredFeatures) {
+            let string = mutableLogString ?? NSMutableString(string: logString)
+            mutableLogString = string
+            replacement.regex.replaceMatches(
+                in: string,
+                range: NSRange(location: 0, length: string.length),
                 withTemplate: replacement.replacementTemplate
             )
         }
 
-        return logString
+        guard let mutableLogString else {
+            return logString
+        }
+        return mutableLogString as String
     }
 }
@@ -0,0 +1,243 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Refreshes groups in the background.
+///
+/// Groups are refreshed in priority order:
+///
+/// 1. Groups that we know are behind the service because we saw a newer
+///    revision (e.g., on an incoming message) that we couldn't apply.
+/// 2. Groups that we've never refreshed.
+/// 3. Groups that haven't been refreshed in a week, most recently active
+///    first.
+///
+/// There's no separate persisted queue. Refresh dates and known revisions
+/// are persisted, and the queue is rebuilt from them on launch, so work
+/// that's interrupted picks up where it left off.
+public class GroupAutoRefreshScheduler {
+
+    public struct Candidate {
+        public let groupId: Data
+        public let groupSecretParamsData: Data
+        public let localRevision: UInt32
+        /// The latest revision we've seen mentioned for this group, if it's
+        /// newer than the revision we had at the time.
+        public let knownRevision: UInt32?
+        public let lastRefreshDate: Date?
+        /// Used as a proxy for recent activity; larger is more recent.
+        public let lastInteractionRowId: UInt64
+
+        public init(
+            groupId: Data,
+            groupSecretParamsData: Data,
+            localRevision: UInt32,
+            knownRevision: UInt32?,
+            lastRefreshDate: Date?,
+            lastInteractionRowId: UInt64
+        ) {
+            self.groupId = groupId
+            self.groupSecretParamsData = groupSecretParamsData
+            self.localRevision = localRevision
+            self.knownRevision = knownRevision
+            self.lastRefreshDate = lastRefreshDate
+            self.lastInteractionRowId = lastInteractionRowId
+        }
+
+        public var isKnownToBeStale: Bool {
+            guard let knownRevision else {
+                return false
+            }
+            return knownRevision > localRevision
+        }
+    }
+
+    /// Don't auto-refresh groups more than once a week unless we know they're
+    /// stale.
+    public static let minRefreshInterval: TimeInterval = kWeekInterval
+
+    /// Refreshes go through the same serial queue as other immediate group
+    /// updates, so this bounds how many wait in it. It's kept small so that
+    /// user-initiated updates don't wait behind many auto-refreshes, but
+    /// above one so that the queue doesn't idle between refreshes.
+    public static let maxConcurrentRefreshes = 2
+
+    /// Limits the load a single launch puts on the service. Whatever's left
+    /// over is picked up on the next launch.
+    public static let maxRefreshesPerLaunch = 100
+
+    /// Returns the candidates that are due for a refresh, highest priority
+    /// first.
+    public static func prioritize(_ candidates: [Candidate], now: Date = Date()) -> [Candidate] {
+        func tier(_ candidate: Candidate) -> Int? {
+            if candidate.isKnownToBeStale {
+                return 0
+            }
+            guard let lastRefreshDate = candidate.lastRefreshDate else {
+                return 1
+            }
+            guard abs(now.timeIntervalSince(lastRefreshDate)) > minRefreshInterval else {
+                return nil
+            }
+            return 2
+        }
+
+        return candidates
+            .compactMap { candidate in tier(candidate).map { (tier: $0, candidate: candidate) } }
+            .sorted { lhs, rhs in
+                if lhs.tier != rhs.tier {
+                    return lhs.tier < rhs.tier
+                }
+                if lhs.tier == 0 {
+                    // Prefer the groups that are furthest behind.
+                    let lhsGap = lhs.candidate.knownRevision! - lhs.candidate.localRevision
+                    let rhsGap = rhs.candidate.knownRevision! - rhs.candidate.localRevision
+                    if lhsGap != rhsGap {
+                        return lhsGap > rhsGap
+                    }
+                }
+                return lhs.candidate.lastInteractionRowId > rhs.candidate.lastInteractionRowId
+            }
+            .map { $0.candidate }
+    }
+
+    // MARK: - Refreshing
+
+    private let maxConcurrentRefreshes: Int
+    private let performRefresh: (Candidate) async throws -> Void
+
+    public init(
+        maxConcurrentRefreshes: Int = GroupAutoRefreshScheduler.maxConcurrentRefreshes,
+        refreshGroup: @escaping (Candidate) async throws -> Void
+    ) {
+        owsAssertDebug(maxConcurrentRefreshes > 0)
+        self.maxConcurrentRefreshes = max(1, maxConcurrentRefreshes)
+        self.performRefresh = refreshGroup
+    }
+
+    private enum RefreshResult {
+        case success
+        case failure
+        case networkFailure
+    }
+
+    /// Refreshes `candidates` in order, with at most `maxConcurrentRefreshes`
+    /// in flight. Stops starting new refreshes after a network failure, since
+    /// the rest would most likely fail too.
+    ///
+    /// - Returns: The number of groups that were refreshed successfully.
+    @discardableResult
+    public func refresh(_ candidates: [Candidate]) async -> Int {
+        let startDate = Date()
+        var remainingCandidates = candidates[...]
+        var successCount = 0
+        var didHitNetworkFailure = false
+
+        await withTaskGroup(of: RefreshResult.self) { taskGroup in
+            var inFlightCount = 0
+            while true {
+                while
+                    !didHitNetworkFailure,
+                    inFlightCount < maxConcurrentRefreshes,
+                    let candidate = remainingCandidates.popFirst()
+                {
+                    inFlightCount += 1
+                    taskGroup.addTask { await self.refreshGroup(candidate: candidate) }
+                }
+                guard let result = await taskGroup.next() else {
+                    break
+                }
+                inFlightCount -= 1
+                switch result {
+                case .success:
+                    successCount += 1
+                case .failure:
+                    break
+                case .networkFailure:
+                    didHitNetworkFailure = true
+                }
+            }
+        }
+
+        let duration = -startDate.timeIntervalSinceNow
+        Logger.info("Auto-refreshed \(successCount)/\(candidates.count) groups in \(String(format: "%.1f", duration))s.")
+        return successCount
+    }
+
+    private func refreshGroup(candidate: Candidate) async -> RefreshResult {
+        do {
+            try await performRefresh(candidate)
+            return .success
+        } catch {
+            let groupIdString = candidate.groupId.hexadecimalString
+            if error.isNetworkFailureOrTimeout {
+                Logger.warn("Auto-refresh of group \(groupIdString) failed: \(error)")
+                return .networkFailure
+            }
+            if case GroupsV2Error.localUserNotInGroup = error {
+                Logger.warn("Auto-refresh of group \(groupIdString) failed: \(error)")
+            } else {
+                owsFailDebug("Auto-refresh of group \(groupIdString) failed: \(error)")
+            }
+            return .failure
+        }
+    }
+
+    // MARK: - Persistence
+
+    // This tracks the last time that groups were updated to the current
+    // revision.
+    private static let groupRefreshStore = SDSKeyValueStore(collection: "groupRefreshStore")
+
+    // This tracks revisions we've heard about but haven't caught up to.
+    private static let knownRevisionStore = SDSKeyValueStore(collection: "groupKnownRevisionStore")
+
+    /// Records that `groupId` has reached at least `revision` on the service.
+    /// If we can't catch up right away, the group is refreshed with high
+    /// priority the next time auto-refresh runs.
+    public static func noteKnownRevision(_ revision: UInt32, groupId: Data, transaction: SDSAnyWriteTransaction) {
+        let storeKey = groupId.hexadecimalString
+        if let knownRevision = knownRevisionStore.getUInt32(storeKey, transaction: transaction), knownRevision >= revision {
+            return
+        }
+        knownRevisionStore.setUInt32(revision, key: storeKey, transaction: transaction)
+    }
+
+    public static func didUpdateGroupToCurrentRevision(groupId: Data, transaction: SDSAnyWriteTransaction) {
+        let storeKey = groupId.hexadecimalString
+        groupRefreshStore.setDate(Date(), key: storeKey, transaction: transaction)
+        knownRevisionStore.removeValue(forKey: storeKey, transaction: transaction)
+    }
+
+    /// Returns every group that's due for a refresh, highest priority first.
+    public static func fetchCandidates(transaction: SDSAnyReadTransaction) -> [Candidate] {
+        var candidates = [Candidate]()
+        TSGroupThread.anyEnumerate(
+            transaction: transaction,
+            batched: true
+        ) { (thread, _) in
+            guard
+                let groupThread = thread as? TSGroupThread,
+                let groupModel = groupThread.groupModel as? TSGroupModelV2,
+                groupModel.groupMembership.isLocalUserFullOrInvitedMember
+            else {
+                // Refreshing a group we're not a member of will throw errors
+                return
+            }
+
+            let storeKey = groupThread.groupId.hexadecimalString
+            candidates.append(Candidate(
+                groupId: groupThread.groupId,
+                groupSecretParamsData: groupModel.secretParamsData,
+                localRevision: groupModel.revision,
+                knownRevision: knownRevisionStore.getUInt32(storeKey, transaction: transaction),
+                lastRefreshDate: groupRefreshStore.getDate(storeKey, transaction: transaction),
+                lastInteractionRowId: groupThread.lastInteractionRowId
+            ))
+        }
+        return prioritize(candidates)
+    }
+}
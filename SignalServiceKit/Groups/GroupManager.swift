@@ -1089,6 +1089,58 @@ public class GroupManager: NSObject {
         spamReportingMetadata: GroupUpdateSpamReportingMetadata,
         transaction: SDSAnyWriteTransaction
     ) throws -> TSGroupThread {
+        return try updateExistingGroupThreadInDatabaseAndCreateInfoMessages(
+            updates: [
+                ExistingGroupThreadUpdate(
+                    newGroupModel: newGroupModel,
+                    newDisappearingMessageToken: newDisappearingMessageToken,
+                    newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
+                    groupUpdateSource: groupUpdateSource
+                )
+            ],
+            infoMessagePolicy: infoMessagePolicy,
+            localIdentifiers: localIdentifiers,
+            spamReportingMetadata: spamReportingMetadata,
+            transaction: transaction
+        )
+    }
+
+    public struct ExistingGroupThreadUpdate {
+        let newGroupModel: TSGroupModel
+        let newDisappearingMessageToken: DisappearingMessageToken?
+        let newlyLearnedPniToAciAssociations: [Pni: Aci]
+        let groupUpdateSource: GroupUpdateSource
+
+        public init(
+            newGroupModel: TSGroupModel,
+            newDisappearingMessageToken: DisappearingMessageToken?,
+            newlyLearnedPniToAciAssociations: [Pni: Aci],
+            groupUpdateSource: GroupUpdateSource
+        ) {
+            self.newGroupModel = newGroupModel
+            self.newDisappearingMessageToken = newDisappearingMessageToken
+            self.newlyLearnedPniToAciAssociations = newlyLearnedPniToAciAssociations
+            self.groupUpdateSource = groupUpdateSource
+        }
+    }
+
+    /// Applies consecutive updates to the same group.
+    ///
+    /// Each update gets the info message it would get if it were applied on
+    /// its own, but the thread (and its member records) are written once, with
+    /// the last model. Applying a long run of revisions therefore doesn't
+    /// archive the whole group model once per revision.
+    public static func updateExistingGroupThreadInDatabaseAndCreateInfoMessages(
+        updates: [ExistingGroupThreadUpdate],
+        infoMessagePolicy: InfoMessagePolicy = .always,
+        localIdentifiers: LocalIdentifiers,
+        spamReportingMetadata: GroupUpdateSpamReportingMetadata,
+        transaction: SDSAnyWriteTransaction
+    ) throws -> TSGroupThread {
+        guard let groupId = updates.first?.newGroupModel.groupId else {
+            throw OWSAssertionError("Missing group updates.")
+        }
+
         // Step 1: First reload latest thread state. This ensures:
         //
         // * The thread (still) exists in the database.
@@ -1096,100 +1148,57 @@ public class GroupManager: NSObject {
         //
         // We always have the groupThread at the call sites of this method, but this
         // future-proofs us against bugs.
-        guard let groupThread = TSGroupThread.fetch(groupId: newGroupModel.groupId, transaction: transaction) else {
+        guard let groupThread = TSGroupThread.fetch(groupId: groupId, transaction: transaction) else {
             throw OWSAssertionError("Missing groupThread.")
         }
 
-        guard
-            let newGroupModel = newGroupModel as? TSGroupModelV2,
-            let oldGroupModel = groupThread.groupModel as? TSGroupModelV2
-        else {
+        guard let initialGroupModel = groupThread.groupModel as? TSGroupModelV2 else {
             owsFail("[GV1] Should be impossible to update a V1 group!")
         }
 
-        // Step 2: Update DM configuration in database, if necessary.
-        let updateDMResult: UpdateDMConfigurationResult
-        if let newDisappearingMessageToken = newDisappearingMessageToken {
-            // shouldInsertInfoMessage is false because we only want to insert a
-            // single info message if we update both DM config and thread model.
-            updateDMResult = updateDisappearingMessagesInDatabaseAndCreateMessages(
-                token: newDisappearingMessageToken,
-                thread: groupThread,
-                shouldInsertInfoMessage: false,
-                changeAuthor: groupUpdateSource,
-                transaction: transaction
-            )
-        } else {
-            let dmConfigurationStore = DependenciesBridge.shared.disappearingMessagesConfigurationStore
-            let dmConfiguration = dmConfigurationStore.fetchOrBuildDefault(for: .thread(groupThread), tx: transaction.asV2Read)
-            updateDMResult = UpdateDMConfigurationResult(oldConfiguration: dmConfiguration, newConfiguration: dmConfiguration)
+        struct InfoMessageToInsert {
+            let oldGroupModel: TSGroupModelV2
+            let newGroupModel: TSGroupModelV2
+            let updateDMResult: UpdateDMConfigurationResult
+            let update: ExistingGroupThreadUpdate
         }
 
-        // Step 3: If any member was removed, make sure we rotate our sender key
-        // session.
-        //
-        // If *we* were removed, check if the group contained any blocked
-        // members and make a best-effort attempt to rotate our profile key if
-        // this was our only mutual group with them.
-        do {
-            let oldMembers = oldGroupModel.membership.allMembersOfAnyKindServiceIds
-            let newMembers = newGroupModel.membership.allMembersOfAnyKindServiceIds
+        var oldGroupModel = initialGroupModel
+        var didRemoveAnyMember = false
+        var infoMessagesToInsert = [InfoMessageToInsert]()
 
-            if oldMembers.subtracting(newMembers).isEmpty == false {
-                senderKeyStore.resetSenderKeySession(for: groupThread, transaction: transaction)
+        for update in updates {
+            guard
+                let newGroupModel = update.newGroupModel as? TSGroupModelV2,
+                newGroupModel.groupId == groupId
+            else {
+                owsFail("[GV1] Should be impossible to update a V1 group!")
             }
 
-            if
-                DependenciesBridge.shared.tsAccountManager.registrationState(tx: transaction.asV2Read).isPrimaryDevice ?? true,
-                let localAci = DependenciesBridge.shared.tsAccountManager.localIdentifiers(tx: transaction.asV2Read)?.aci,
-                oldGroupModel.membership.hasProfileKeyInGroup(serviceId: localAci),
-                !newGroupModel.membership.hasProfileKeyInGroup(serviceId: localAci)
-            {
-                // If our profile key is no longer exposed to the group - for
-                // example, we've left the group - check if the group had any
-                // blocked users to whom our profile key was exposed.
-                var shouldRotateProfileKey = false
-                for member in oldMembers {
-                    let memberAddress = SignalServiceAddress(member)
-
-                    if
-                        (
-                            blockingManager.isAddressBlocked(memberAddress, transaction: transaction)
-                            || DependenciesBridge.shared.recipientHidingManager.isHiddenAddress(memberAddress, tx: transaction.asV2Read)
-                        ),
-                        newGroupModel.membership.canViewProfileKeys(serviceId: member)
-                    {
-                        // Make a best-effort attempt to find other groups with
-                        // this blocked user in which our profile key is
-                        // exposed.
-                        //
-                        // We can only efficiently query for groups in which
-                        // they are a full member, although that may not be all
-                        // the groups in which they can see your profile key.
-                        // Best effort.
-                        let mutualGroupThreads = Self.mutualGroupThreads(
-                            with: member,
-                            localAci: localAci,
-                            tx: transaction
-                        )
-
-                        // If there is exactly one group, it's the one we are leaving!
-                        // We should rotate, as it's the last group we have in common.
-                        if mutualGroupThreads.count == 1 {
-                            shouldRotateProfileKey = true
-                            break
-                        }
-                    }
-                }
+            // Step 2: Update DM configuration in database, if necessary.
+            let updateDMResult: UpdateDMConfigurationResult
+            if let newDisappearingMessageToken = update.newDisappearingMessageToken {
+                // shouldInsertInfoMessage is false because we only want to insert a
+                // single info message if we update both DM config and thread model.
+                updateDMResult = updateDisappearingMessagesInDatabaseAndCreateMessages(
+                    token: newDisappearingMessageToken,
+                    thread: groupThread,
+                    shouldInsertInfoMessage: false,
+                    changeAuthor: update.groupUpdateSource,
+                    transaction: transaction
+                )
+            } else {
+                let dmConfigurationStore = DependenciesBridge.shared.disappearingMessagesConfigurationStore
+                let dmConfiguration = dmConfigurationStore.fetchOrBuildDefault(for: .thread(groupThread), tx: transaction.asV2Read)
+                updateDMResult = UpdateDMConfigurationResult(oldConfiguration: dmConfiguration, newConfiguration: dmConfiguration)
+            }
 
-                if shouldRotateProfileKey {
-                    profileManager.forceRotateLocalProfileKeyForGroupDeparture(with: transaction)
-                }
+            let oldMembers = oldGroupModel.membership.allMembersOfAnyKindServiceIds
+            let newMembers = newGroupModel.membership.allMembersOfAnyKindServiceIds
+            if oldMembers.subtracting(newMembers).isEmpty == false {
+                didRemoveAnyMember = true
             }
-        }
 
-        // Step 4: Update group in database, if necessary.
-        let hasUserFacingUpdate: Bool = {
             guard newGroupModel.revision > oldGroupModel.revision else {
                 /// Local group state must never revert to an earlier revision.
                 ///
@@ -1201,13 +1210,13 @@ public class GroupManager: NSObject {
                 /// the group models each codepath constructs for that revision
                 /// should be equivalent.
                 Logger.warn("Skipping redundant update for V2 group.")
-                return false
+                continue
             }
 
             autoWhitelistGroupIfNecessary(
                 oldGroupModel: oldGroupModel,
                 newGroupModel: newGroupModel,
-                groupUpdateSource: groupUpdateSource,
+                groupUpdateSource: update.groupUpdateSource,
                 localIdentifiers: localIdentifiers,
                 tx: transaction
             )
@@ -1217,34 +1226,104 @@ public class GroupManager: NSObject {
             )
             let hasDMUpdate = updateDMResult.newConfiguration != updateDMResult.oldConfiguration
 
-            let hasUserFacingUpdate = hasUserFacingGroupModelChange || hasDMUpdate
-            groupThread.update(
-                with: newGroupModel,
-                shouldUpdateChatListUi: hasUserFacingUpdate,
-                transaction: transaction
-            )
+            if hasUserFacingGroupModelChange || hasDMUpdate {
+                infoMessagesToInsert.append(InfoMessageToInsert(
+                    oldGroupModel: oldGroupModel,
+                    newGroupModel: newGroupModel,
+                    updateDMResult: updateDMResult,
+                    update: update
+                ))
+            }
 
-            return hasUserFacingUpdate
-        }()
+            oldGroupModel = newGroupModel
+        }
+
+        let finalGroupModel = oldGroupModel
 
-        guard hasUserFacingUpdate else {
+        // Step 3: If any member was removed, make sure we rotate our sender key
+        // session.
+        if didRemoveAnyMember {
+            senderKeyStore.resetSenderKeySession(for: groupThread, transaction: transaction)
+        }
+
+        // If *we* were removed, check if the group contained any blocked
+        // members and make a best-effort attempt to rotate our profile key if
+        // this was our only mutual group with them.
+        if
+            DependenciesBridge.shared.tsAccountManager.registrationState(tx: transaction.asV2Read).isPrimaryDevice ?? true,
+            let localAci = DependenciesBridge.shared.tsAccountManager.localIdentifiers(tx: transaction.asV2Read)?.aci,
+            initialGroupModel.membership.hasProfileKeyInGroup(serviceId: localAci),
+            !finalGroupModel.membership.hasProfileKeyInGroup(serviceId: localAci)
+        {
+            // If our profile key is no longer exposed to the group - for
+            // example, we've left the group - check if the group had any
+            // blocked users to whom our profile key was exposed.
+            var shouldRotateProfileKey = false
+            for member in initialGroupModel.membership.allMembersOfAnyKindServiceIds {
+                let memberAddress = SignalServiceAddress(member)
+
+                if
+                    (
+                        blockingManager.isAddressBlocked(memberAddress, transaction: transaction)
+                        || DependenciesBridge.shared.recipientHidingManager.isHiddenAddress(memberAddress, tx: transaction.asV2Read)
+                    ),
+                    finalGroupModel.membership.canViewProfileKeys(serviceId: member)
+                {
+                    // Make a best-effort attempt to find other groups with
+                    // this blocked user in which our profile key is
+                    // exposed.
+                    //
+                    // We can only efficiently query for groups in which
+                    // they are a full member, although that may not be all
+                    // the groups in which they can see your profile key.
+                    // Best effort.
+                    let mutualGroupThreads = Self.mutualGroupThreads(
+                        with: member,
+                        localAci: localAci,
+                        tx: transaction
+                    )
+
+                    // If there is exactly one group, it's the one we are leaving!
+                    // We should rotate, as it's the last group we have in common.
+                    if mutualGroupThreads.count == 1 {
+                        shouldRotateProfileKey = true
+                        break
+                    }
+                }
+            }
+
+            if shouldRotateProfileKey {
+                profileManager.forceRotateLocalProfileKeyForGroupDeparture(with: transaction)
+            }
+        }
+
+        // Step 4: Update group in database, if necessary.
+        guard finalGroupModel !== initialGroupModel else {
             return groupThread
         }
 
+        groupThread.update(
+            with: finalGroupModel,
+            shouldUpdateChatListUi: !infoMessagesToInsert.isEmpty,
+            transaction: transaction
+        )
+
         switch infoMessagePolicy {
         case .always, .updatesOnly:
-            insertGroupUpdateInfoMessage(
-                groupThread: groupThread,
-                oldGroupModel: oldGroupModel,
-                newGroupModel: newGroupModel,
-                oldDisappearingMessageToken: updateDMResult.oldConfiguration.asToken,
-                newDisappearingMessageToken: updateDMResult.newConfiguration.asToken,
-                newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
-                groupUpdateSource: groupUpdateSource,
-                localIdentifiers: localIdentifiers,
-                spamReportingMetadata: spamReportingMetadata,
-                transaction: transaction
-            )
+            for infoMessage in infoMessagesToInsert {
+                insertGroupUpdateInfoMessage(
+                    groupThread: groupThread,
+                    oldGroupModel: infoMessage.oldGroupModel,
+                    newGroupModel: infoMessage.newGroupModel,
+                    oldDisappearingMessageToken: infoMessage.updateDMResult.oldConfiguration.asToken,
+                    newDisappearingMessageToken: infoMessage.updateDMResult.newConfiguration.asToken,
+                    newlyLearnedPniToAciAssociations: infoMessage.update.newlyLearnedPniToAciAssociations,
+                    groupUpdateSource: infoMessage.update.groupUpdateSource,
+                    localIdentifiers: localIdentifiers,
+                    spamReportingMetadata: spamReportingMetadata,
+                    transaction: transaction
+                )
+            }
         default:
             break
         }
@@ -102,11 +102,16 @@ extension GroupMemberState: Codable {
         case .fullMember(let role, let didJoinFromInviteLink, let didJoinFromAcceptedJoinRequest):
             try container.encode(TypeKey.fullMember, forKey: .typeKey)
             try container.encode(role, forKey: .role)
-            try container.encode(didJoinFromInviteLink, forKey: .didJoinFromInviteLink)
-            try container.encode(
-                didJoinFromAcceptedJoinRequest,
-                forKey: .didJoinFromAcceptedJoinRequest
-            )
+            // These decode as false when they're missing.
+            if didJoinFromInviteLink {
+                try container.encode(didJoinFromInviteLink, forKey: .didJoinFromInviteLink)
+            }
+            if didJoinFromAcceptedJoinRequest {
+                try container.encode(
+                    didJoinFromAcceptedJoinRequest,
+                    forKey: .didJoinFromAcceptedJoinRequest
+                )
+            }
         case .invited(let role, let addedByAci):
             try container.encode(TypeKey.invited, forKey: .typeKey)
             try container.encode(role, forKey: .role)
@@ -127,6 +132,77 @@ extension GroupMemberState: CustomStringConvertible {
     }
 }
 
+// MARK: - SortedServiceIdMemberStates
+
+/// Members keyed by ServiceId, kept in an array sorted by the ServiceId's
+/// binary form. Archives list members in this order, so decoding them
+/// doesn't need to sort or hash anything, and lookups are a binary search.
+private struct SortedServiceIdMemberStates {
+    struct Entry {
+        let serviceIdBinary: Data
+        let serviceId: ServiceId
+        let memberState: GroupMemberState
+
+        init(serviceId: ServiceId, memberState: GroupMemberState) {
+            self.serviceIdBinary = Data(serviceId.serviceIdBinary)
+            self.serviceId = serviceId
+            self.memberState = memberState
+        }
+    }
+
+    let entries: [Entry]
+
+    init() {
+        self.entries = []
+    }
+
+    /// Entries that are already sorted, as they are when decoded, are only
+    /// checked. If a ServiceId appears more than once, its first entry wins.
+    init(_ entries: [Entry]) {
+        let isSorted = zip(entries, entries.dropFirst()).allSatisfy {
+            $0.serviceIdBinary.lexicographicallyPrecedes($1.serviceIdBinary)
+        }
+        if isSorted {
+            self.entries = entries
+            return
+        }
+        // Stable sort, so the first of any duplicates stays first.
+        let sortedEntries = entries.enumerated().sorted {
+            if $0.element.serviceIdBinary == $1.element.serviceIdBinary {
+                return $0.offset < $1.offset
+            }
+            return $0.element.serviceIdBinary.lexicographicallyPrecedes($1.element.serviceIdBinary)
+        }
+        var uniqueEntries = [Entry]()
+        uniqueEntries.reserveCapacity(sortedEntries.count)
+        for (_, entry) in sortedEntries where uniqueEntries.last?.serviceIdBinary != entry.serviceIdBinary {
+            uniqueEntries.append(entry)
+        }
+        self.entries = uniqueEntries
+    }
+
+    var count: Int { entries.count }
+
+    subscript(serviceId: ServiceId) -> GroupMemberState? {
+        let serviceIdBinary = Data(serviceId.serviceIdBinary)
+        var lowerBound = 0
+        var upperBound = entries.count
+        while lowerBound < upperBound {
+            let middle = (lowerBound + upperBound) / 2
+            let entry = entries[middle]
+            if entry.serviceIdBinary == serviceIdBinary {
+                return entry.memberState
+            }
+            if entry.serviceIdBinary.lexicographicallyPrecedes(serviceIdBinary) {
+                lowerBound = middle + 1
+            } else {
+                upperBound = middle
+            }
+        }
+        return nil
+    }
+}
+
 // MARK: -
 
 @objc
@@ -144,17 +220,29 @@ public class GroupMembership: MTLModel {
 
     // MARK: Init
 
-    fileprivate var memberStates: MemberStateMap
+    /// Every member that has a ServiceId, which is every member of a V2 group.
+    ///
+    /// Membership checks for a ServiceId search this directly, so they don't
+    /// need to build (and register) a SignalServiceAddress.
+    private let serviceIdMemberStates: SortedServiceIdMemberStates
+    /// Members without a ServiceId. These only exist in legacy groups.
+    private let phoneNumberMemberStates: MemberStateMap
     public fileprivate(set) var bannedMembers: BannedMembersMap
     private var invalidInviteMap: InvalidInviteMap
 
+    /// Values derived from the member states. Group models are decoded every
+    /// time their thread is fetched, but most of them are only asked about a
+    /// handful of members, so these are built the first time they're needed.
+    private let derivedValues = DerivedValues()
+
     public var invalidInviteUserIds: [Data] {
         return Array(invalidInviteMap.keys)
     }
 
     @objc
     public override init() {
-        self.memberStates = [:]
+        self.serviceIdMemberStates = SortedServiceIdMemberStates()
+        self.phoneNumberMemberStates = [:]
         self.bannedMembers = [:]
         self.invalidInviteMap = [:]
 
@@ -171,15 +259,34 @@ public class GroupMembership: MTLModel {
         }
 
         if let memberStatesData = aDecoder.decodeObject(forKey: Self.memberStatesKey) as? Data {
+            do {
+                let archivedMemberStates = try JSONDecoder().decode(ArchivedMemberStates.self, from: memberStatesData)
+                self.serviceIdMemberStates = SortedServiceIdMemberStates(archivedMemberStates.serviceIdEntries)
+                self.phoneNumberMemberStates = archivedMemberStates.phoneNumberMemberStates
+            } catch {
+                owsFailDebug("Could not decode member states: \(error)")
+                return nil
+            }
+        } else if let serviceIdMemberStatesData = aDecoder.decodeObject(forKey: Self.serviceIdMemberStatesKey) as? Data {
+            // Written by builds that stored ServiceId members separately.
             let decoder = JSONDecoder()
             do {
-                self.memberStates = try decoder.decode(MemberStateMap.self, from: memberStatesData)
+                self.serviceIdMemberStates = try Self.decodeServiceIdMemberStates(serviceIdMemberStatesData, decoder: decoder)
+                if let phoneNumberMemberStatesData = aDecoder.decodeObject(forKey: Self.phoneNumberMemberStatesKey) as? Data {
+                    self.phoneNumberMemberStates = try decoder.decode(ArchivedMemberStates.self, from: phoneNumberMemberStatesData).phoneNumberMemberStates
+                } else {
+                    self.phoneNumberMemberStates = [:]
+                }
             } catch {
                 owsFailDebug("Could not decode member states: \(error)")
                 return nil
             }
         } else if let legacyMemberStateMap = aDecoder.decodeObject(forKey: Self.legacyMemberStatesKey) as? LegacyMemberStateMap {
-            self.memberStates = Self.convertLegacyMemberStateMap(legacyMemberStateMap)
+            let partitionedMemberStates = Self.partition(
+                Self.convertLegacyMemberStateMap(legacyMemberStateMap)
+            )
+            self.serviceIdMemberStates = partitionedMemberStates.serviceIdMemberStates
+            self.phoneNumberMemberStates = partitionedMemberStates.phoneNumberMemberStates
         } else {
             owsFailDebug("Could not decode legacy member states.")
             return nil
@@ -197,6 +304,8 @@ public class GroupMembership: MTLModel {
         super.init()
     }
 
+    private static var serviceIdMemberStatesKey: String { "serviceIdMemberStates" }
+    private static var phoneNumberMemberStatesKey: String { "phoneNumberMemberStates" }
     private static var memberStatesKey: String { "memberStates" }
     private static var legacyMemberStatesKey: String { "memberStateMap" }
     private static var bannedMembersKey: String { "bannedMembers" }
@@ -204,8 +313,15 @@ public class GroupMembership: MTLModel {
 
     public override func encode(with aCoder: NSCoder) {
         let encoder = JSONEncoder()
+        // Addresses are keyed containers; sort their keys so that identical
+        // memberships produce identical archives.
+        encoder.outputFormatting = .sortedKeys
         do {
-            let memberStatesData = try encoder.encode(self.memberStates)
+            let memberStatesData = try Self.encodeMemberStates(
+                serviceIdMemberStates: serviceIdMemberStates,
+                phoneNumberMemberStates: phoneNumberMemberStates,
+                encoder: encoder
+            )
             aCoder.encode(memberStatesData, forKey: Self.memberStatesKey)
         } catch {
             owsFailDebug("Error: \(error)")
@@ -225,7 +341,9 @@ public class GroupMembership: MTLModel {
         bannedMembers: BannedMembersMap,
         invalidInviteMap: InvalidInviteMap
     ) {
-        self.memberStates = memberStates
+        let partitionedMemberStates = Self.partition(memberStates)
+        self.serviceIdMemberStates = partitionedMemberStates.serviceIdMemberStates
+        self.phoneNumberMemberStates = partitionedMemberStates.phoneNumberMemberStates
         self.bannedMembers = bannedMembers
         self.invalidInviteMap = invalidInviteMap
 
@@ -236,7 +354,9 @@ public class GroupMembership: MTLModel {
     init(v1Members: [SignalServiceAddress]) {
         var builder = Builder()
         builder.addFullMembers(Set(v1Members), role: .normal)
-        self.memberStates = builder.memberStates
+        let partitionedMemberStates = Self.partition(builder.memberStates)
+        self.serviceIdMemberStates = partitionedMemberStates.serviceIdMemberStates
+        self.phoneNumberMemberStates = partitionedMemberStates.phoneNumberMemberStates
         self.bannedMembers = [:]
         self.invalidInviteMap = [:]
 
@@ -251,6 +371,184 @@ public class GroupMembership: MTLModel {
     }
     #endif
 
+    // MARK: - Storage
+
+    private static func partition(
+        _ memberStates: MemberStateMap
+    ) -> (serviceIdMemberStates: SortedServiceIdMemberStates, phoneNumberMemberStates: MemberStateMap) {
+        var serviceIdEntries = [SortedServiceIdMemberStates.Entry]()
+        serviceIdEntries.reserveCapacity(memberStates.count)
+        var phoneNumberMemberStates = MemberStateMap()
+        for (address, memberState) in memberStates {
+            if let serviceId = address.serviceId {
+                serviceIdEntries.append(.init(serviceId: serviceId, memberState: memberState))
+            } else {
+                phoneNumberMemberStates[address] = memberState
+            }
+        }
+        return (SortedServiceIdMemberStates(serviceIdEntries), phoneNumberMemberStates)
+    }
+
+    /// How an address is archived. It's the same format `SignalServiceAddress`
+    /// uses, so older builds can decode it, but without building an address.
+    private struct ArchivedAddress: Codable {
+        var backingUuid: String?
+        var backingPhoneNumber: String?
+    }
+
+    /// The "memberStates" archive: an array of alternating addresses and
+    /// states, which is how `MemberStateMap` is encoded.
+    private struct ArchivedMemberStates: Decodable {
+        var serviceIdEntries = [SortedServiceIdMemberStates.Entry]()
+        var phoneNumberMemberStates = MemberStateMap()
+
+        init(from decoder: Decoder) throws {
+            var container = try decoder.unkeyedContainer()
+            serviceIdEntries.reserveCapacity((container.count ?? 0) / 2)
+            while !container.isAtEnd {
+                let archivedAddress = try container.decode(ArchivedAddress.self)
+                let memberState = try container.decode(GroupMemberState.self)
+                if let serviceIdString = archivedAddress.backingUuid {
+                    let serviceId = try ServiceId.parseFrom(serviceIdString: serviceIdString)
+                    serviceIdEntries.append(.init(serviceId: serviceId, memberState: memberState))
+                    continue
+                }
+                // Legacy members only have a phone number. Decode them the way
+                // SignalServiceAddress does, which may find their ServiceId.
+                let address = SignalServiceAddress.legacyAddress(
+                    serviceId: nil,
+                    phoneNumber: archivedAddress.backingPhoneNumber
+                )
+                if let serviceId = address.serviceId {
+                    serviceIdEntries.append(.init(serviceId: serviceId, memberState: memberState))
+                } else {
+                    phoneNumberMemberStates[address] = memberState
+                }
+            }
+        }
+    }
+
+    /// A key or a value in the "memberStates" archive.
+    private enum ArchivedMemberStatesElement: Encodable {
+        case address(ArchivedAddress)
+        case memberState(GroupMemberState)
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.singleValueContainer()
+            switch self {
+            case .address(let address):
+                try container.encode(address)
+            case .memberState(let memberState):
+                try container.encode(memberState)
+            }
+        }
+    }
+
+    /// Encodes members in the format `MemberStateMap` decodes from, so older
+    /// builds can still read it. Members with a ServiceId come first, in the
+    /// order they're kept in, followed by any legacy members sorted by phone
+    /// number. Empty fields are left out.
+    private static func encodeMemberStates(
+        serviceIdMemberStates: SortedServiceIdMemberStates,
+        phoneNumberMemberStates: MemberStateMap,
+        encoder: JSONEncoder
+    ) throws -> Data {
+        let phoneNumberEntries = phoneNumberMemberStates.map {
+            (phoneNumber: $0.key.phoneNumber, memberState: $0.value)
+        }.sorted { ($0.phoneNumber ?? "") < ($1.phoneNumber ?? "") }
+
+        var elements = [ArchivedMemberStatesElement]()
+        elements.reserveCapacity(2 * (serviceIdMemberStates.count + phoneNumberEntries.count))
+        for entry in serviceIdMemberStates.entries {
+            elements.append(.address(ArchivedAddress(backingUuid: entry.serviceId.serviceIdUppercaseString)))
+            elements.append(.memberState(entry.memberState))
+        }
+        for entry in phoneNumberEntries {
+            elements.append(.address(ArchivedAddress(backingPhoneNumber: entry.phoneNumber)))
+            elements.append(.memberState(entry.memberState))
+        }
+        return try encoder.encode(elements)
+    }
+
+    private struct ServiceIdMemberState: Decodable {
+        var serviceId: Data
+        var memberState: GroupMemberState
+    }
+
+    private static func decodeServiceIdMemberStates(
+        _ data: Data,
+        decoder: JSONDecoder
+    ) throws -> SortedServiceIdMemberStates {
+        let entries = try decoder.decode([ServiceIdMemberState].self, from: data)
+        return SortedServiceIdMemberStates(try entries.map {
+            .init(serviceId: try ServiceId.parseFrom(serviceIdBinary: $0.serviceId), memberState: $0.memberState)
+        })
+    }
+
+    /// All members keyed by address, for the address-based accessors.
+    fileprivate var memberStates: MemberStateMap {
+        return derivedValue(\.memberStates) {
+            var result = phoneNumberMemberStates
+            result.reserveCapacity(phoneNumberMemberStates.count + serviceIdMemberStates.count)
+            for entry in serviceIdMemberStates.entries {
+                result[SignalServiceAddress(entry.serviceId)] = entry.memberState
+            }
+            return result
+        }
+    }
+
+    fileprivate func memberState(for serviceId: ServiceId) -> GroupMemberState? {
+        // Legacy members may match a ServiceId via SignalServiceAddressCache, so
+        // only address lookups find them.
+        guard phoneNumberMemberStates.isEmpty else {
+            return memberStates[SignalServiceAddress(serviceId)]
+        }
+        return serviceIdMemberStates[serviceId]
+    }
+
+    fileprivate func memberState(for address: SignalServiceAddress) -> GroupMemberState? {
+        guard phoneNumberMemberStates.isEmpty, let serviceId = address.serviceId else {
+            return memberStates[address]
+        }
+        return serviceIdMemberStates[serviceId]
+    }
+
+    fileprivate final class DerivedValues {
+        let lock = UnfairLock()
+        var memberStates: MemberStateMap?
+        var fullMemberAdministrators: Set<SignalServiceAddress>?
+        var fullMembers: Set<SignalServiceAddress>?
+        var fullMemberList: [SignalServiceAddress]?
+        var invitedMembers: Set<SignalServiceAddress>?
+        var requestingMembers: Set<SignalServiceAddress>?
+        var fullOrInvitedMembers: Set<SignalServiceAddress>?
+        var invitedOrRequestMembers: Set<SignalServiceAddress>?
+        var allMembersOfAnyKind: Set<SignalServiceAddress>?
+        var allMembersOfAnyKindServiceIds: Set<ServiceId>?
+    }
+
+    /// Returns the cached value at `keyPath`, building it if needed.
+    ///
+    /// `build` runs outside the lock because it may need other derived
+    /// values. If two threads race, both build the same value.
+    fileprivate func derivedValue<T>(_ keyPath: ReferenceWritableKeyPath<DerivedValues, T?>, build: () -> T) -> T {
+        if let value = derivedValues.lock.withLock({ derivedValues[keyPath: keyPath] }) {
+            return value
+        }
+        let value = build()
+        derivedValues.lock.withLock { derivedValues[keyPath: keyPath] = value }
+        return value
+    }
+
+    private func members(
+        _ keyPath: ReferenceWritableKeyPath<DerivedValues, Set<SignalServiceAddress>?>,
+        where isIncluded: @escaping (GroupMemberState) -> Bool
+    ) -> Set<SignalServiceAddress> {
+        return derivedValue(keyPath) {
+            Set(memberStates.lazy.filter { isIncluded($0.value) }.map { $0.key })
+        }
+    }
+
     // MARK: - Equality
 
     @objc
@@ -259,9 +557,18 @@ public class GroupMembership: MTLModel {
             return false
         }
 
+        guard
+            self.serviceIdMemberStates.count == other.serviceIdMemberStates.count,
+            zip(self.serviceIdMemberStates.entries, other.serviceIdMemberStates.entries).allSatisfy({
+                $0.serviceIdBinary == $1.serviceIdBinary && Self.memberState($0.memberState, isEqualTo: $1.memberState)
+            })
+        else {
+            return false
+        }
+
         guard Self.memberStates(
-            self.memberStates,
-            areEqualTo: other.memberStates
+            self.phoneNumberMemberStates,
+            areEqualTo: other.phoneNumberMemberStates
         ) else {
             return false
         }
@@ -281,11 +588,21 @@ public class GroupMembership: MTLModel {
     /// the service, and are only computed when a member joins a group and we add
     /// them locally. If our local membership differs from a group snapshot's
     /// only in these fields, we want to consider them equal to avoid clobbering our local state.
-    private static func memberStates(
-        _ memberStates: MemberStateMap,
-        areEqualTo otherMemberStates: MemberStateMap
+    private static func memberStates<Key>(
+        _ memberStates: [Key: GroupMemberState],
+        areEqualTo otherMemberStates: [Key: GroupMemberState]
     ) -> Bool {
+        guard memberStates.count == otherMemberStates.count else {
+            return false
+        }
 
+        return memberStates.allSatisfy { (key, value) -> Bool in
+            guard let otherValue = otherMemberStates[key] else { return false }
+            return memberState(value, isEqualTo: otherValue)
+        }
+    }
+
+    private static func memberState(_ memberState: GroupMemberState, isEqualTo otherMemberState: GroupMemberState) -> Bool {
         func hardcodeDidJoinViaInviteLink(for groupMemberState: GroupMemberState) -> GroupMemberState {
             switch groupMemberState {
             case .fullMember(let role, _, _):
@@ -299,14 +616,7 @@ public class GroupMembership: MTLModel {
             }
         }
 
-        guard memberStates.count == otherMemberStates.count else {
-            return false
-        }
-
-        return memberStates.allSatisfy { (key, value) -> Bool in
-            guard let otherValue = otherMemberStates[key] else { return false }
-            return hardcodeDidJoinViaInviteLink(for: value) == hardcodeDidJoinViaInviteLink(for: otherValue)
-        }
+        return hardcodeDidJoinViaInviteLink(for: memberState) == hardcodeDidJoinViaInviteLink(for: otherMemberState)
     }
 
     // MARK: -
@@ -343,8 +653,11 @@ public class GroupMembership: MTLModel {
 
     @objc
     public static func normalize(_ addresses: [SignalServiceAddress]) -> [SignalServiceAddress] {
-        return Array(Set(addresses))
-            .sorted(by: { (l, r) in l.compare(r) == .orderedAscending })
+        // Build each display string once rather than once per comparison.
+        return Set(addresses)
+            .map { (address: $0, sortKey: $0.stringForDisplay) }
+            .sorted(by: { (l, r) in l.sortKey.compare(r.sortKey) == .orderedAscending })
+            .map { $0.address }
     }
 
     public var asBuilder: Builder {
@@ -377,57 +690,68 @@ public class GroupMembership: MTLModel {
 public extension GroupMembership {
 
     var fullMemberAdministrators: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isAdministrator && $0.value.isFullMember }.map { $0.key })
+        return members(\.fullMemberAdministrators) { $0.isAdministrator && $0.isFullMember }
     }
 
     var fullMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isFullMember }.map { $0.key })
+        return members(\.fullMembers) { $0.isFullMember }
+    }
+
+    /// The same members as ``fullMembers``, for callers that need an array.
+    var fullMemberList: [SignalServiceAddress] {
+        return derivedValue(\.fullMemberList) { Array(fullMembers) }
     }
 
     var invitedMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isInvited }.map { $0.key })
+        return members(\.invitedMembers) { $0.isInvited }
     }
 
     var requestingMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter { $0.value.isRequesting }.map { $0.key })
+        return members(\.requestingMembers) { $0.isRequesting }
     }
 
     var fullOrInvitedMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter {
-            $0.value.isFullMember || $0.value.isInvited
-        }.map { $0.key })
+        return members(\.fullOrInvitedMembers) { $0.isFullMember || $0.isInvited }
     }
 
     var invitedOrRequestMembers: Set<SignalServiceAddress> {
-        return Set(memberStates.lazy.filter {
-            $0.value.isInvited || $0.value.isRequesting
-        }.map { $0.key })
+        return members(\.invitedOrRequestMembers) { $0.isInvited || $0.isRequesting }
     }
 
     var allMembersOfAnyKind: Set<SignalServiceAddress> {
-        return Set(memberStates.keys)
+        return derivedValue(\.allMembersOfAnyKind) { Set(memberStates.keys) }
     }
 
     var allMembersOfAnyKindServiceIds: Set<ServiceId> {
-        return Set(memberStates.keys.lazy.compactMap { $0.serviceId })
+        return derivedValue(\.allMembersOfAnyKindServiceIds) {
+            Set(serviceIdMemberStates.entries.lazy.map { $0.serviceId }).union(phoneNumberMemberStates.keys.lazy.compactMap { $0.serviceId })
+        }
     }
 }
 
 public extension GroupMembership {
 
     func role(for serviceId: ServiceId) -> TSGroupMemberRole? {
-        return role(for: SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.role
     }
 
     func role(for address: SignalServiceAddress) -> TSGroupMemberRole? {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return nil
         }
         return memberState.role
     }
 
     func isFullOrInvitedAdministrator(_ address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        return Self.isFullOrInvitedAdministrator(self.memberState(for: address))
+    }
+
+    func isFullOrInvitedAdministrator(_ serviceId: ServiceId) -> Bool {
+        return Self.isFullOrInvitedAdministrator(self.memberState(for: serviceId))
+    }
+
+    private static func isFullOrInvitedAdministrator(_ memberState: GroupMemberState?) -> Bool {
+        guard let memberState else {
             return false
         }
         switch memberState {
@@ -440,63 +764,62 @@ public extension GroupMembership {
         }
     }
 
-    func isFullOrInvitedAdministrator(_ serviceId: ServiceId) -> Bool {
-        return isFullOrInvitedAdministrator(SignalServiceAddress(serviceId))
-    }
-
     @objc
     func isFullMemberAndAdministrator(_ address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return false
         }
         return memberState.isAdministrator && memberState.isFullMember
     }
 
     func isFullMemberAndAdministrator(_ serviceId: ServiceId) -> Bool {
-        return isFullMemberAndAdministrator(SignalServiceAddress(serviceId))
+        guard let memberState = self.memberState(for: serviceId) else {
+            return false
+        }
+        return memberState.isAdministrator && memberState.isFullMember
     }
 
     @objc
     func isFullMember(_ address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return false
         }
         return memberState.isFullMember
     }
 
     func isFullMember(_ serviceId: ServiceId) -> Bool {
-        return isFullMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isFullMember ?? false
     }
 
     @objc
     func isInvitedMember(_ address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return false
         }
         return memberState.isInvited
     }
 
     func isInvitedMember(_ serviceId: ServiceId) -> Bool {
-        return isInvitedMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isInvited ?? false
     }
 
     func isRequestingMember(_ address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return false
         }
         return memberState.isRequesting
     }
 
     func isRequestingMember(_ serviceId: ServiceId) -> Bool {
-        return isRequestingMember(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId)?.isRequesting ?? false
     }
 
     func isMemberOfAnyKind(_ address: SignalServiceAddress) -> Bool {
-        return memberStates[address] != nil
+        return memberState(for: address) != nil
     }
 
     func isMemberOfAnyKind(_ serviceId: ServiceId) -> Bool {
-        return isMemberOfAnyKind(SignalServiceAddress(serviceId))
+        return memberState(for: serviceId) != nil
     }
 
     func isBannedMember(_ aci: Aci) -> Bool {
@@ -509,7 +832,7 @@ public extension GroupMembership {
 
     /// This method should only be called on invited members.
     func addedByAci(forInvitedMember address: SignalServiceAddress) -> Aci? {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             return nil
         }
         switch memberState {
@@ -527,7 +850,7 @@ public extension GroupMembership {
 
     /// This method should only be called for full members.
     func didJoinFromInviteLink(forFullMember address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             owsFailDebug("Missing member: \(address)")
             return false
         }
@@ -542,7 +865,7 @@ public extension GroupMembership {
 
     /// this method should only be called for full members.
     func didJoinFromAcceptedJoinRequest(forFullMember address: SignalServiceAddress) -> Bool {
-        guard let memberState = memberStates[address] else {
+        guard let memberState = self.memberState(for: address) else {
             owsFailDebug("Missing member: \(address)")
             return false
         }
@@ -557,7 +880,7 @@ public extension GroupMembership {
 
     /// Is this user's profile key exposed to the group?
     func hasProfileKeyInGroup(serviceId: ServiceId) -> Bool {
-        guard let memberState = memberStates[SignalServiceAddress(serviceId)] else {
+        guard let memberState = self.memberState(for: serviceId) else {
             return false
         }
 
@@ -571,7 +894,7 @@ public extension GroupMembership {
 
     /// Can this user view the profile keys in the group?
     func canViewProfileKeys(serviceId: ServiceId) -> Bool {
-        guard let memberState = memberStates[SignalServiceAddress(serviceId)] else {
+        guard let memberState = self.memberState(for: serviceId) else {
             return false
         }
 
@@ -8,10 +8,6 @@ import LibSignalClient
 
 public class GroupV2UpdatesImpl: Dependencies {
 
-    // This tracks the last time that groups were updated to the current
-    // revision.
-    private static let groupRefreshStore = SDSKeyValueStore(collection: "groupRefreshStore")
-
     private let changeCache = LRUCache<Data, ChangeCacheItem>(maxSize: 5)
     private var lastSuccessfulRefreshMap = LRUCache<Data, Date>(maxSize: 256)
 
@@ -33,117 +29,47 @@ public class GroupV2UpdatesImpl: Dependencies {
         SwiftSingletons.register(self)
 
         AppReadiness.runNowOrWhenMainAppDidBecomeReadyAsync {
-            self.autoRefreshGroupOnLaunch()
+            self.autoRefreshGroupsOnLaunch()
         }
     }
 
     // MARK: -
 
-    // On launch, we refresh a few randomly-selected groups.
-    private func autoRefreshGroupOnLaunch() {
+    // On launch, we refresh the groups that are most likely to be stale.
+    private func autoRefreshGroupsOnLaunch() {
         let tsAccountManager = DependenciesBridge.shared.tsAccountManager
         guard tsAccountManager.registrationStateWithMaybeSneakyTransaction.isRegistered else {
             return
         }
 
-        firstly(on: DispatchQueue.global()) { () -> Guarantee<Void> in
-            self.messageProcessor.waitForFetchingAndProcessing()
-        }.then(on: DispatchQueue.global()) { _ -> Promise<Void> in
-            guard let groupInfoToRefresh = Self.findGroupToAutoRefresh() else {
-                // We didn't find a group to refresh; abort.
-                return Promise.value(())
+        Task {
+            await self.messageProcessor.waitForFetchingAndProcessing().awaitable()
+
+            let candidates = self.databaseStorage.read { transaction in
+                GroupAutoRefreshScheduler.fetchCandidates(transaction: transaction)
             }
-            let groupId = groupInfoToRefresh.groupId
-            let groupSecretParamsData = groupInfoToRefresh.groupSecretParamsData
-            if let lastRefreshDate = groupInfoToRefresh.lastRefreshDate {
-                Logger.info("Auto-refreshing group: \(groupId.hexadecimalString) which hasn't been refreshed in \(-lastRefreshDate.timeIntervalSinceNow/kDayInterval) days.")
-            } else {
-                Logger.info("Auto-refreshing group: \(groupId.hexadecimalString) which has never been refreshed.")
+            guard !candidates.isEmpty else {
+                return
             }
-            return self.tryToRefreshV2GroupUpToCurrentRevisionImmediately(
-                groupId: groupId,
-                groupSecretParamsData: groupSecretParamsData
-            ).asVoid()
-        }.catch(on: DispatchQueue.global()) { error in
-            if case GroupsV2Error.localUserNotInGroup = error {
-                Logger.warn("Error: \(error)")
-            } else {
-                owsFailDebugUnlessNetworkFailure(error)
+            let candidatesToRefresh = candidates.prefix(GroupAutoRefreshScheduler.maxRefreshesPerLaunch)
+            Logger.info("Auto-refreshing \(candidatesToRefresh.count)/\(candidates.count) groups.")
+
+            let scheduler = GroupAutoRefreshScheduler { candidate in
+                _ = try await self.tryToRefreshV2GroupThread(
+                    groupId: candidate.groupId,
+                    spamReportingMetadata: .learnedByLocallyInitatedRefresh,
+                    groupSecretParamsData: candidate.groupSecretParamsData,
+                    groupUpdateMode: .upToCurrentRevisionImmediately,
+                    groupModelOptions: []
+                ).awaitable()
             }
+            await scheduler.refresh(Array(candidatesToRefresh))
         }
     }
 
     private func didUpdateGroupToCurrentRevision(groupId: Data) {
-        let storeKey = groupId.hexadecimalString
         Self.databaseStorage.write { transaction in
-            Self.groupRefreshStore.setDate(Date(), key: storeKey, transaction: transaction)
-        }
-    }
-
-    private struct GroupInfo {
-        let groupId: Data
-        let groupSecretParamsData: Data
-        let lastRefreshDate: Date?
-    }
-
-    private static func findGroupToAutoRefresh() -> GroupInfo? {
-        // Enumerate the all v2 groups, trying to find the "best" one to refresh.
-        // The "best" is the group that hasn't been refreshed in the longest
-        // time.
-        Self.databaseStorage.read { transaction in
-            var groupInfoToRefresh: GroupInfo?
-            TSGroupThread.anyEnumerate(
-                transaction: transaction,
-                batched: true
-            ) { (thread, stop) in
-                guard
-                    let groupThread = thread as? TSGroupThread,
-                    let groupModel = groupThread.groupModel as? TSGroupModelV2,
-                    groupModel.groupMembership.isLocalUserFullOrInvitedMember
-                else {
-                    // Refreshing a group we're not a member of will throw errors
-                    return
-                }
-
-                let storeKey = groupThread.groupId.hexadecimalString
-                guard let lastRefreshDate: Date = Self.groupRefreshStore.getDate(
-                    storeKey,
-                    transaction: transaction
-                ) else {
-                    // If we find a group that we have no record of refreshing,
-                    // pick that one immediately.
-                    groupInfoToRefresh = GroupInfo(
-                        groupId: groupThread.groupId,
-                        groupSecretParamsData: groupModel.secretParamsData,
-                        lastRefreshDate: nil
-                    )
-                    stop.pointee = true
-                    return
-                }
-
-                // Don't auto-refresh groups more than once a week.
-                let maxRefreshFrequencyInternal: TimeInterval = kWeekInterval
-                guard abs(lastRefreshDate.timeIntervalSinceNow) > maxRefreshFrequencyInternal else {
-                    return
-                }
-
-                if
-                    let otherGroupInfo = groupInfoToRefresh,
-                    let otherLastRefreshDate = otherGroupInfo.lastRefreshDate,
-                    otherLastRefreshDate < lastRefreshDate
-                {
-                    // We already found another group with an older refresh
-                    // date, so prefer that one.
-                    return
-                }
-
-                groupInfoToRefresh = GroupInfo(
-                    groupId: groupThread.groupId,
-                    groupSecretParamsData: groupModel.secretParamsData,
-                    lastRefreshDate: lastRefreshDate
-                )
-            }
-            return groupInfoToRefresh
+            GroupAutoRefreshScheduler.didUpdateGroupToCurrentRevision(groupId: groupId, transaction: transaction)
         }
     }
 }
@@ -170,7 +96,7 @@ extension GroupV2UpdatesImpl: GroupV2Updates {
             throw OWSAssertionError("Not registered.")
         }
         let changedGroupModel = try GroupsV2IncomingChanges.applyChangesToGroupModel(
-            groupThread: groupThread,
+            groupModel: groupThread.groupModel,
             localIdentifiers: localIdentifiers,
             changeActionsProto: changeActionsProto,
             downloadedAvatars: downloadedAvatars,
@@ -683,6 +609,13 @@ private extension GroupV2UpdatesImpl {
                 return groupThread
             }
 
+            guard var groupModel = groupThread.groupModel as? TSGroupModelV2 else {
+                throw OWSAssertionError("Invalid group model.")
+            }
+
+            // Changes are applied to an in-memory model, and the resulting updates
+            // are written together once we've gone through all of them.
+            var pendingUpdates = [GroupManager.ExistingGroupThreadUpdate]()
             var profileKeysByAci = [Aci: Data]()
             var authoritativeProfileKeysByAci = [Aci: Data]()
             for (index, groupChange) in groupChanges.enumerated() {
@@ -700,7 +633,8 @@ private extension GroupV2UpdatesImpl {
 
                 let applyResult = try autoreleasepool {
                     try self.tryToApplySingleChangeFromService(
-                        groupThread: &groupThread,
+                        groupModel: &groupModel,
+                        pendingUpdates: &pendingUpdates,
                         groupV2Params: groupV2Params,
                         groupModelOptions: groupModelOptions,
                         groupChange: groupChange,
@@ -725,6 +659,15 @@ private extension GroupV2UpdatesImpl {
                 }
             }
 
+            if !pendingUpdates.isEmpty {
+                groupThread = try GroupManager.updateExistingGroupThreadInDatabaseAndCreateInfoMessages(
+                    updates: pendingUpdates,
+                    localIdentifiers: localIdentifiers,
+                    spamReportingMetadata: spamReportingMetadata,
+                    transaction: transaction
+                )
+            }
+
             GroupManager.storeProfileKeysFromGroupProtos(
                 allProfileKeysByAci: profileKeysByAci,
                 authoritativeProfileKeysByAci: authoritativeProfileKeysByAci,
@@ -858,8 +801,12 @@ private extension GroupV2UpdatesImpl {
         let wasLocalUserAddedByChange: Bool
     }
 
+    /// Computes the group model after `groupChange` and appends the resulting
+    /// update to `pendingUpdates`. The caller is responsible for writing the
+    /// pending updates to the database.
     private func tryToApplySingleChangeFromService(
-        groupThread: inout TSGroupThread,
+        groupModel: inout TSGroupModelV2,
+        pendingUpdates: inout [GroupManager.ExistingGroupThreadUpdate],
         groupV2Params: GroupV2Params,
         groupModelOptions: TSGroupModelOptions,
         groupChange: GroupV2Change,
@@ -870,9 +817,7 @@ private extension GroupV2UpdatesImpl {
         spamReportingMetadata: GroupUpdateSpamReportingMetadata,
         transaction: SDSAnyWriteTransaction
     ) throws -> ApplySingleChangeFromServiceResult? {
-        guard let oldGroupModel = groupThread.groupModel as? TSGroupModelV2 else {
-            throw OWSAssertionError("Invalid group model.")
-        }
+        let oldGroupModel = groupModel
 
         let oldRevision = oldGroupModel.revision
         let changeRevision = groupChange.revision
@@ -918,7 +863,7 @@ private extension GroupV2UpdatesImpl {
             logger.info("Applying single revision update from change proto.")
 
             let changedGroupModel = try GroupsV2IncomingChanges.applyChangesToGroupModel(
-                groupThread: groupThread,
+                groupModel: oldGroupModel,
                 localIdentifiers: localIdentifiers,
                 changeActionsProto: changeActionsProto,
                 downloadedAvatars: groupChange.downloadedAvatars,
@@ -963,15 +908,17 @@ private extension GroupV2UpdatesImpl {
             }
         }
 
-        groupThread = try GroupManager.updateExistingGroupThreadInDatabaseAndCreateInfoMessage(
+        pendingUpdates.append(GroupManager.ExistingGroupThreadUpdate(
             newGroupModel: newGroupModel,
             newDisappearingMessageToken: newDisappearingMessageToken,
             newlyLearnedPniToAciAssociations: newlyLearnedPniToAciAssociations,
-            groupUpdateSource: groupUpdateSource,
-            localIdentifiers: localIdentifiers,
-            spamReportingMetadata: spamReportingMetadata,
-            transaction: transaction
-        )
+            groupUpdateSource: groupUpdateSource
+        ))
+        // Redundant updates are dropped when they're written, so don't let
+        // them move the in-memory model backwards either.
+        if let newGroupModel = newGroupModel as? TSGroupModelV2, newGroupModel.revision > oldGroupModel.revision {
+            groupModel = newGroupModel
+        }
 
         switch groupUpdateSource {
         case .unknown, .legacyE164, .rejectedInviteToPni, .localUser:
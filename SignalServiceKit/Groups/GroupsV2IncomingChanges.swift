@@ -56,13 +56,13 @@ public class GroupsV2IncomingChanges {
     // model, thereby deriving a new group model whose revision is
     // exactly 1 higher.
     class func applyChangesToGroupModel(
-        groupThread: TSGroupThread,
+        groupModel: TSGroupModel,
         localIdentifiers: LocalIdentifiers,
         changeActionsProto: GroupsProtoGroupChangeActions,
         downloadedAvatars: GroupV2DownloadedAvatars,
         groupModelOptions: TSGroupModelOptions
     ) throws -> ChangedGroupModel {
-        guard let oldGroupModel = groupThread.groupModel as? TSGroupModelV2 else {
+        guard let oldGroupModel = groupModel as? TSGroupModelV2 else {
             throw OWSAssertionError("Invalid group model.")
         }
         guard !oldGroupModel.isJoinRequestPlaceholder else {
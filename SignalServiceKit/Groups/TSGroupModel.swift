@@ -120,7 +120,15 @@ public class TSGroupModelV2: TSGroupModel {
 
     @objc
     public override var groupMembers: [SignalServiceAddress] {
-        return Array(groupMembership.fullMembers)
+        return groupMembership.fullMemberList
+    }
+
+    @objc
+    public override var nonLocalGroupMembers: [SignalServiceAddress] {
+        guard let localAci = DependenciesBridge.shared.tsAccountManager.localIdentifiersWithMaybeSneakyTransaction?.aci else {
+            return groupMembers
+        }
+        return groupMembers.filter { $0.serviceId != localAci }
     }
 
     public func hasUserFacingChangeCompared(
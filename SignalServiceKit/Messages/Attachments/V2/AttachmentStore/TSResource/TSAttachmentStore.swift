@@ -26,6 +26,33 @@ public class TSAttachmentStore {
         )
     }
 
+    /// Fetches the given attachments into the attachment read cache, so that
+    /// subsequent lookups of individual attachments don't hit the database.
+    public func prefetchAttachments(
+        withAttachmentIds attachmentIds: [String],
+        tx: SDSAnyReadTransaction
+    ) {
+        // Stay well below SQLite's limit on the number of bound arguments.
+        for attachmentIdBatch in attachmentIds.chunked(by: 500) {
+            let placeholders = Array(repeating: "?", count: attachmentIdBatch.count).joined(separator: ",")
+            let sql = """
+                SELECT * FROM \(AttachmentRecord.databaseTableName)
+                WHERE \(attachmentColumn: .uniqueId) IN (\(placeholders))
+            """
+            // The cursor adds each attachment to the read cache as it's read.
+            let cursor = TSAttachment.grdbFetchCursor(
+                sql: sql,
+                arguments: StatementArguments(Array(attachmentIdBatch)),
+                transaction: tx.unwrapGrdbRead
+            )
+            do {
+                while try cursor.next() != nil {}
+            } catch {
+                owsFailDebug("unexpected error \(error)")
+            }
+        }
+    }
+
     public func fetchAttachmentStream(
         uniqueId: String,
         tx: SDSAnyReadTransaction
@@ -315,6 +315,11 @@ public class OWSIncomingSentMessageTranscript: Dependencies, SentMessageTranscri
                     revision <= groupModel.revision
                 else {
                     owsFailDebug("Unexpected revision.")
+                    GroupAutoRefreshScheduler.noteKnownRevision(
+                        revision,
+                        groupId: groupId,
+                        transaction: SDSDB.shimOnlyBridge(tx)
+                    )
                     return nil
                 }
             } else {
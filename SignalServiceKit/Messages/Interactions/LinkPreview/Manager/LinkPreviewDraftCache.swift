@@ -0,0 +1,79 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Recently fetched link previews, including their images.
+///
+/// Entries are keyed by a canonical form of the URL and expire after a few
+/// minutes, so a page that changes will eventually be fetched again.
+class LinkPreviewDraftCache {
+
+    private class Entry {
+        let draft: OWSLinkPreviewDraft
+        let expirationDate: Date
+
+        init(draft: OWSLinkPreviewDraft, expirationDate: Date) {
+            self.draft = draft
+            self.expirationDate = expirationDate
+        }
+    }
+
+    private let cache: LRUCache<String, Entry>
+    private let timeToLive: TimeInterval
+    private let dateProvider: DateProvider
+
+    init(
+        maxSize: Int = 32,
+        timeToLive: TimeInterval = 10 * kMinuteInterval,
+        dateProvider: @escaping DateProvider = Date.provider
+    ) {
+        self.cache = LRUCache(maxSize: maxSize, shouldEvacuateInBackground: true)
+        self.timeToLive = timeToLive
+        self.dateProvider = dateProvider
+    }
+
+    /// Returns the key for `url`, ignoring differences that can't change the
+    /// page: the case of the scheme and host, and the fragment.
+    static func cacheKey(for url: URL) -> String? {
+        guard var components = URLComponents(url: url, resolvingAgainstBaseURL: true) else {
+            return nil
+        }
+        components.scheme = components.scheme?.lowercased()
+        components.host = components.host?.lowercased()
+        components.fragment = nil
+        if components.path.isEmpty {
+            components.path = "/"
+        }
+        return components.string
+    }
+
+    /// Returns a copy of the cached draft for `key` with its URL set to `url`.
+    func draft(forKey key: String, url: URL) -> OWSLinkPreviewDraft? {
+        guard let entry = cache.get(key: key) else {
+            return nil
+        }
+        guard entry.expirationDate > dateProvider() else {
+            cache.remove(key: key)
+            return nil
+        }
+        return entry.draft.copy(url: url)
+    }
+
+    func setDraft(_ draft: OWSLinkPreviewDraft, forKey key: String) {
+        let entry = Entry(draft: draft.copy(url: draft.url), expirationDate: dateProvider().addingTimeInterval(timeToLive))
+        cache.set(key: key, value: entry)
+    }
+}
+
+extension OWSLinkPreviewDraft {
+    /// Drafts are mutable, so cached drafts are copied on the way in and out.
+    func copy(url: URL) -> OWSLinkPreviewDraft {
+        let draft = OWSLinkPreviewDraft(url: url, title: title, imageData: imageData, imageMimeType: imageMimeType)
+        draft.previewDescription = previewDescription
+        draft.date = date
+        return draft
+    }
+}
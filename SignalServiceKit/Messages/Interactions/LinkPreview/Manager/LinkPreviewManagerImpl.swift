@@ -35,6 +35,20 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
 
     private lazy var defaultBuilder = LinkPreviewTSResourceBuilder(tsResourceManager: attachmentManager)
 
+    /// Previews for generic URLs, so that retyping or resending a URL doesn't
+    /// fetch it again.
+    private let draftCache = LinkPreviewDraftCache()
+
+    /// Fetches for generic URLs that haven't finished yet, keyed like
+    /// `draftCache`, so that concurrent requests for a URL share one fetch.
+    private var inFlightFetches = [String: Promise<OWSLinkPreviewDraft>]()
+    private let inFlightFetchesLock = UnfairLock()
+
+#if TESTABLE_BUILD
+    /// Lets tests serve pages from a stub `URLProtocol`.
+    var urlProtocolClassesForTesting: [AnyClass]?
+#endif
+
     // MARK: - Public
 
     public func areLinkPreviewsEnabled(tx: DBReadTransaction) -> Bool {
@@ -192,11 +206,37 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
     // MARK: - Private
 
     private func fetchLinkPreview(forGenericUrl url: URL) -> Promise<OWSLinkPreviewDraft> {
-        firstly(on: Self.workQueue) { () -> Promise<(URL, String)> in
-            self.fetchStringResource(from: url)
+        guard let cacheKey = LinkPreviewDraftCache.cacheKey(for: url) else {
+            return fetchUncachedLinkPreview(forGenericUrl: url)
+        }
+        if let cachedDraft = draftCache.draft(forKey: cacheKey, url: url) {
+            return Promise.value(cachedDraft)
+        }
+        let fetch = inFlightFetchesLock.withLock { () -> Promise<OWSLinkPreviewDraft> in
+            if let inFlightFetch = inFlightFetches[cacheKey] {
+                return inFlightFetch
+            }
+            let fetch = firstly(on: Self.workQueue) { () -> Promise<OWSLinkPreviewDraft> in
+                self.fetchUncachedLinkPreview(forGenericUrl: url)
+            }.map(on: Self.workQueue) { (draft: OWSLinkPreviewDraft) -> OWSLinkPreviewDraft in
+                self.draftCache.setDraft(draft, forKey: cacheKey)
+                return draft
+            }.ensure(on: Self.workQueue) {
+                self.inFlightFetchesLock.withLock { self.inFlightFetches[cacheKey] = nil }
+            }
+            inFlightFetches[cacheKey] = fetch
+            return fetch
+        }
+        // Each caller gets its own copy, for its own URL.
+        return fetch.map(on: Self.workQueue) { $0.copy(url: url) }
+    }
+
+    private func fetchUncachedLinkPreview(forGenericUrl url: URL) -> Promise<OWSLinkPreviewDraft> {
+        firstly(on: Self.workQueue) { () -> Promise<FetchedHTML> in
+            self.fetchHTMLHead(from: url)
 
-        }.then(on: Self.workQueue) { (respondingUrl, rawHTML) -> Promise<OWSLinkPreviewDraft> in
-            let content = HTMLMetadata.construct(parsing: rawHTML)
+        }.then(on: Self.workQueue) { (fetchedHTML: FetchedHTML) -> Promise<OWSLinkPreviewDraft> in
+            let content = HTMLMetadata.construct(parsing: fetchedHTML.html)
             let rawTitle = content.ogTitle ?? content.titleTag
             let normalizedTitle = rawTitle.map { LinkPreviewHelper.normalizeString($0, maxLines: 2) }
             let draft = OWSLinkPreviewDraft(url: url, title: normalizedTitle)
@@ -209,14 +249,17 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
             draft.date = content.dateForLinkPreview
 
             guard let imageUrlString = content.ogImageUrlString ?? content.faviconUrlString,
-                  let imageUrl = URL(string: imageUrlString, relativeTo: respondingUrl) else {
+                  let imageUrl = URL(string: imageUrlString, relativeTo: fetchedHTML.respondingUrl) else {
+                Self.logFetch(fetchedHTML, imageByteCount: 0)
                 return Promise.value(draft)
             }
 
+            var imageByteCount = 0
             return firstly(on: Self.workQueue) { () -> Promise<Data> in
                 self.fetchImageResource(from: imageUrl)
             }.then(on: Self.workQueue) { (imageData: Data) -> Promise<PreviewThumbnail?> in
-                Self.previewThumbnail(srcImageData: imageData, srcMimeType: nil)
+                imageByteCount = imageData.count
+                return Self.previewThumbnail(srcImageData: imageData, srcMimeType: nil)
             }.map(on: Self.workQueue) { (previewThumbnail: PreviewThumbnail?) -> OWSLinkPreviewDraft in
                 guard let previewThumbnail = previewThumbnail else {
                     return draft
@@ -226,10 +269,17 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
                 return draft
             }.recover(on: Self.workQueue) { (_) -> Promise<OWSLinkPreviewDraft> in
                 return Promise.value(draft)
+            }.ensure(on: Self.workQueue) {
+                Self.logFetch(fetchedHTML, imageByteCount: imageByteCount)
             }
         }
     }
 
+    private static func logFetch(_ fetchedHTML: FetchedHTML, imageByteCount: Int) {
+        let headOnly = fetchedHTML.stoppedAfterHead ? " (stopped after <head>)" : ""
+        Logger.info("Downloaded \(fetchedHTML.byteCount) bytes of HTML\(headOnly) and \(imageByteCount) bytes of image")
+    }
+
     // MARK: - Private, Networking
 
     private func buildOWSURLSession() -> OWSURLSessionProtocol {
@@ -243,6 +293,12 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
         let userAgentString = "WhatsApp/2"
         let extraHeaders: [String: String] = [OWSHttpHeaders.userAgentHeaderKey: userAgentString]
 
+#if TESTABLE_BUILD
+        if let urlProtocolClassesForTesting {
+            sessionConfig.protocolClasses = urlProtocolClassesForTesting
+        }
+#endif
+
         let urlSession = OWSURLSession(
             securityPolicy: OWSURLSession.defaultSecurityPolicy,
             configuration: sessionConfig,
@@ -260,24 +316,57 @@ public class LinkPreviewManagerImpl: LinkPreviewManager {
         return urlSession
     }
 
-    func fetchStringResource(from url: URL) -> Promise<(URL, String)> {
-        firstly(on: Self.workQueue) { () -> Promise<(HTTPResponse)> in
-            self.buildOWSURLSession().dataTaskPromise(url.absoluteString, method: .get)
-        }.map(on: Self.workQueue) { (response: HTTPResponse) -> (URL, String) in
+    struct FetchedHTML {
+        let respondingUrl: URL
+        /// The document's head, or the whole document if the end of the head
+        /// wasn't found.
+        let html: String
+        /// How much of the response body was downloaded.
+        let byteCount: Int
+        let stoppedAfterHead: Bool
+    }
+
+    /// Downloads an HTML document, stopping as soon as its head is complete.
+    func fetchHTMLHead(from url: URL) -> Promise<FetchedHTML> {
+        var headScanner = HTMLMetadata.HeadScanner()
+        return firstly(on: Self.workQueue) { () -> Promise<HTTPResponse> in
+            self.buildOWSURLSession().streamingDataTaskPromise(
+                url.absoluteString,
+                method: .get,
+                shouldContinue: { !headScanner.scan($0) }
+            )
+        }.map(on: Self.workQueue) { (response: HTTPResponse) -> FetchedHTML in
             let statusCode = response.responseStatusCode
             guard statusCode >= 200 && statusCode < 300 else {
                 Logger.warn("Invalid response: \(statusCode).")
                 throw LinkPreviewError.fetchFailure
             }
-            guard let string = response.responseBodyString, !string.isEmpty else {
+            guard let bodyData = response.responseBodyData else {
+                Logger.warn("Response object could not be parsed")
+                throw LinkPreviewError.invalidPreview
+            }
+            // If the download stopped early, it may have stopped partway through
+            // a character, so only decode up to the end of the head.
+            let htmlData = headScanner.headLength.map { bodyData.prefix($0) } ?? bodyData
+            let stringEncoding = (response as? HTTPResponseImpl)?.stringEncoding ?? .utf8
+            guard let html = String(data: htmlData, encoding: stringEncoding), !html.isEmpty else {
                 Logger.warn("Response object could not be parsed")
                 throw LinkPreviewError.invalidPreview
             }
 
-            return (response.requestUrl, string)
+            return FetchedHTML(
+                respondingUrl: response.requestUrl,
+                html: html,
+                byteCount: bodyData.count,
+                stoppedAfterHead: headScanner.headLength != nil
+            )
         }
     }
 
+    func fetchStringResource(from url: URL) -> Promise<(URL, String)> {
+        return fetchHTMLHead(from: url).map(on: Self.workQueue) { ($0.respondingUrl, $0.html) }
+    }
+
     private func fetchImageResource(from url: URL) -> Promise<Data> {
         firstly(on: Self.workQueue) { () -> Promise<(HTTPResponse)> in
             self.buildOWSURLSession().dataTaskPromise(url.absoluteString, method: .get)
@@ -302,6 +302,10 @@ public class MessageProcessor: NSObject {
         }
     }
 
+    private static let batchDurationMetric = PerformanceMetrics.shared.histogram("messageProcessor.batch")
+    private static let processedEnvelopesMetric = PerformanceMetrics.shared.counter("messageProcessor.envelopes")
+    private static let pendingEnvelopesMetric = PerformanceMetrics.shared.gauge("messageProcessor.pendingEnvelopes")
+
     /// Returns whether or not to continue draining the queue.
     private func drainNextBatch() -> Bool {
         assertOnQueue(serialQueue)
@@ -362,6 +366,9 @@ public class MessageProcessor: NSObject {
         }
         pendingEnvelopes.removeProcessedEnvelopes(processedEnvelopesCount)
         let endTime = CACurrentMediaTime()
+        Self.batchDurationMetric.record(endTime - startTime)
+        Self.processedEnvelopesMetric.add(processedEnvelopesCount)
+        Self.pendingEnvelopesMetric.set(Double(max(0, pendingEnvelopesCount - processedEnvelopesCount)))
         let formattedDuration = String(format: "%.1f", (endTime - startTime) * 1000)
         Logger.info("Processed \(processedEnvelopesCount) envelopes (of \(pendingEnvelopesCount) total) in \(formattedDuration)ms")
         return true
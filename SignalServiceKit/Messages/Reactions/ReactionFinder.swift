@@ -126,6 +126,44 @@ public class ReactionFinder {
         }
     }
 
+    /// Returns all reactions to the messages in a range of a thread's
+    /// interactions, keyed by message uniqueId, in the same order as
+    /// `allReactions(transaction:)`.
+    ///
+    /// This lets callers that need the reactions for many adjacent messages
+    /// (e.g. the conversation view) fetch them with a single query.
+    public static func allReactions(
+        threadUniqueId: String,
+        interactionRowIds: ClosedRange<Int64>,
+        transaction: GRDBReadTransaction
+    ) -> [String: [OWSReaction]] {
+        let sql = """
+            SELECT reaction.* FROM \(OWSReaction.databaseTableName) AS reaction
+            INNER JOIN \(InteractionRecord.databaseTableName) AS interaction
+            ON interaction.\(interactionColumn: .uniqueId) = reaction.\(OWSReaction.columnName(.uniqueMessageId))
+            WHERE interaction.\(interactionColumn: .threadUniqueId) = ?
+            AND interaction.\(interactionColumn: .id) BETWEEN ? AND ?
+            ORDER BY reaction.\(OWSReaction.columnName(.id)) DESC
+        """
+
+        var reactions = [String: [OWSReaction]]()
+
+        do {
+            let cursor = try OWSReaction.fetchCursor(
+                transaction.database,
+                sql: sql,
+                arguments: [threadUniqueId, interactionRowIds.lowerBound, interactionRowIds.upperBound]
+            )
+            while let reaction = try cursor.next() {
+                reactions[reaction.uniqueMessageId, default: []].append(reaction)
+            }
+        } catch {
+            owsFailDebug("unexpected error \(error)")
+        }
+
+        return reactions
+    }
+
     /// Delete all reaction records associated with this message
     @objc
     public func deleteAllReactions(transaction: GRDBWriteTransaction) {
@@ -386,11 +386,12 @@ public class StickerManager: NSObject {
 
         // The cover.
         let coverFetch = firstly {
-            tryToDownloadAndInstallSticker(
-                stickerPack: stickerPack,
-                item: stickerPack.cover,
-                transaction: transaction)
-        }.done { (shouldNotify: Bool) in
+            tryToDownloadStickerForInstall(stickerPack: stickerPack, item: stickerPack.cover, transaction: transaction)
+        }.map(on: DispatchQueue.global()) { (downloadedSticker: DownloadedSticker?) -> Void in
+            guard let downloadedSticker else {
+                return
+            }
+            let shouldNotify = installStickers([downloadedSticker]) > 0
             if shouldNotify {
                 stickersDidChangeEvent.requestNotify()
                 needsNotify = false
@@ -402,27 +403,43 @@ public class StickerManager: NSObject {
             return Promise.when(fulfilled: fetches)
         }
 
-        // The stickers.
-        for item in stickerPack.items {
-            fetches.append(
-                firstly {
-                    tryToDownloadAndInstallSticker(
-                        stickerPack: stickerPack,
-                        item: item,
-                        transaction: transaction)
-                }.done { shouldNotify in
-                    if shouldNotify, coverFetch.isSealed {
-                        // We should only notify for changes once we've fetched the cover
-                        // Some views will assume that an installed pack always has a cover
-                        // and faildebug otherwise
-                        stickersDidChangeEvent.requestNotify()
-                        needsNotify = false
-                    } else if shouldNotify {
-                        needsNotify = true
+        // The stickers. They're downloaded in parallel (up to the limit of
+        // stickerOperationQueue) and then installed together, so that a large
+        // pack costs one write transaction rather than one per sticker.
+        let stickerDownloads = stickerPack.items.map { item in
+            tryToDownloadStickerForInstall(stickerPack: stickerPack, item: item, transaction: transaction)
+        }
+        let stickersFetch = Guarantee.when(resolved: stickerDownloads).asPromise().map(on: DispatchQueue.global()) { (results: [Result<DownloadedSticker?, Error>]) -> Void in
+            var downloadedStickers = [DownloadedSticker]()
+            var firstError: Error?
+            for result in results {
+                switch result {
+                case .success(let downloadedSticker):
+                    if let downloadedSticker {
+                        downloadedStickers.append(downloadedSticker)
                     }
+                case .failure(let error):
+                    firstError = firstError ?? error
                 }
-            )
+            }
+
+            let shouldNotify = installStickers(downloadedStickers) > 0
+            if shouldNotify, coverFetch.isSealed {
+                // We should only notify for changes once we've fetched the cover
+                // Some views will assume that an installed pack always has a cover
+                // and faildebug otherwise
+                stickersDidChangeEvent.requestNotify()
+                needsNotify = false
+            } else if shouldNotify {
+                needsNotify = true
+            }
+
+            if let firstError {
+                throw firstError
+            }
         }
+        fetches.append(stickersFetch)
+
         return Promise.when(fulfilled: fetches).ensure {
             if needsNotify {
                 stickersDidChangeEvent.requestNotify()
@@ -654,6 +671,21 @@ public class StickerManager: NSObject {
         return InstalledSticker.anyFetch(uniqueId: uniqueId, transaction: transaction)
     }
 
+    /// A sticker that has been downloaded but not yet installed.
+    public struct DownloadedSticker {
+        public let stickerInfo: StickerInfo
+        public let stickerUrl: URL
+        public let contentType: String?
+        public let emojiString: String?
+
+        public init(stickerInfo: StickerInfo, stickerUrl: URL, contentType: String?, emojiString: String?) {
+            self.stickerInfo = stickerInfo
+            self.stickerUrl = stickerUrl
+            self.contentType = contentType
+            self.emojiString = emojiString
+        }
+    }
+
     @objc
     public class func installSticker(stickerInfo: StickerInfo,
                                      stickerUrl stickerTemporaryUrl: URL,
@@ -664,9 +696,44 @@ public class StickerManager: NSObject {
             return false
         }
 
+        let downloadedSticker = DownloadedSticker(
+            stickerInfo: stickerInfo,
+            stickerUrl: stickerTemporaryUrl,
+            contentType: contentType,
+            emojiString: emojiString
+        )
+        guard let installedSticker = copyStickerData(downloadedSticker) else {
+            return false
+        }
+
+        return databaseStorage.write { (transaction) -> Bool in
+            insertInstalledSticker(installedSticker, transaction: transaction)
+        }
+    }
+
+    /// Installs `downloadedStickers` in a single write transaction, and
+    /// returns the number of stickers that weren't already installed.
+    public class func installStickers(_ downloadedStickers: [DownloadedSticker]) -> Int {
+        let installedStickers = downloadedStickers.compactMap { copyStickerData($0) }
+        guard !installedStickers.isEmpty else {
+            return 0
+        }
+        return databaseStorage.write { transaction in
+            installedStickers.filter { insertInstalledSticker($0, transaction: transaction) }.count
+        }
+    }
+
+    /// Copies the sticker's data to where installed stickers are kept and
+    /// returns the sticker, ready to be inserted.
+    private class func copyStickerData(_ downloadedSticker: DownloadedSticker) -> InstalledSticker? {
+        let stickerInfo = downloadedSticker.stickerInfo
+        let stickerTemporaryUrl = downloadedSticker.stickerUrl
+        let contentType = downloadedSticker.contentType
+        let emojiString = downloadedSticker.emojiString
+
         guard OWSFileSystem.fileOrFolderExists(url: stickerTemporaryUrl) else {
             owsFailDebug("Missing sticker file.")
-            return false
+            return nil
         }
 
         let installedSticker = InstalledSticker(info: stickerInfo,
@@ -675,7 +742,7 @@ public class StickerManager: NSObject {
 
         guard let stickerDataUrl = self.stickerDataUrl(forInstalledSticker: installedSticker, verifyExists: false) else {
             owsFailDebug("Could not generate sticker data URL.")
-            return false
+            return nil
         }
 
         do {
@@ -690,56 +757,65 @@ public class StickerManager: NSObject {
                 Logger.warn("File already exists: \(error)")
             } else {
                 owsFailDebug("File write failed: \(error)")
-                return false
+                return nil
             }
         }
 
-        return databaseStorage.write { (transaction) -> Bool in
-            guard nil == fetchInstalledSticker(stickerInfo: stickerInfo, transaction: transaction) else {
-                // RACE: sticker has already been installed between now and when we last checked.
-                //
-                // Initially we check for a stickers presence with a read transaction, to avoid opening
-                // an unnecessary write transaction. However, it's possible a race has occurred and the
-                // sticker has since been installed, in which case there's nothing more for us to do.
-                return false
-            }
+        return installedSticker
+    }
 
-            installedSticker.anyInsert(transaction: transaction)
+    /// Returns true if the sticker was inserted, or false if it was already
+    /// installed.
+    private class func insertInstalledSticker(_ installedSticker: InstalledSticker, transaction: SDSAnyWriteTransaction) -> Bool {
+        let stickerInfo = installedSticker.info
+        guard nil == fetchInstalledSticker(stickerInfo: stickerInfo, transaction: transaction) else {
+            // RACE: sticker has already been installed between now and when we last checked.
+            //
+            // Initially we check for a stickers presence with a read transaction, to avoid opening
+            // an unnecessary write transaction. However, it's possible a race has occurred and the
+            // sticker has since been installed, in which case there's nothing more for us to do.
+            return false
+        }
 
-            #if DEBUG
-            guard self.isStickerInstalled(stickerInfo: stickerInfo, transaction: transaction) else {
-                owsFailDebug("Skipping redundant sticker install.")
-                return false
-            }
-            if !OWSFileSystem.fileOrFolderExists(url: stickerDataUrl) {
-                owsFailDebug("Missing sticker data for installed sticker.")
-                return false
-            }
-            #endif
+        installedSticker.anyInsert(transaction: transaction)
 
-            self.addStickerToEmojiMap(installedSticker, tx: transaction)
-            return true
+        #if DEBUG
+        guard self.isStickerInstalled(stickerInfo: stickerInfo, transaction: transaction) else {
+            owsFailDebug("Skipping redundant sticker install.")
+            return false
         }
+        guard
+            let stickerDataUrl = self.stickerDataUrl(forInstalledSticker: installedSticker, verifyExists: false),
+            OWSFileSystem.fileOrFolderExists(url: stickerDataUrl)
+        else {
+            owsFailDebug("Missing sticker data for installed sticker.")
+            return false
+        }
+        #endif
+
+        self.addStickerToEmojiMap(installedSticker, tx: transaction)
+        return true
     }
 
-    private class func tryToDownloadAndInstallSticker(stickerPack: StickerPack,
+    /// Downloads the sticker so it can be installed with `installStickers(_:)`.
+    /// Resolves to nil if the sticker is already installed.
+    private class func tryToDownloadStickerForInstall(stickerPack: StickerPack,
                                                       item: StickerPackItem,
-                                                      transaction: SDSAnyReadTransaction) -> Promise<Bool> {
+                                                      transaction: SDSAnyReadTransaction) -> Promise<DownloadedSticker?> {
         let stickerInfo: StickerInfo = item.stickerInfo(with: stickerPack)
-        let emojiString = item.emojiString
 
         guard !self.isStickerInstalled(stickerInfo: stickerInfo, transaction: transaction) else {
             // Skipping redundant sticker install.
-            return .value(false)
+            return .value(nil)
         }
 
         return firstly {
             tryToDownloadSticker(stickerPack: stickerPack, stickerInfo: stickerInfo)
         }.map(on: DispatchQueue.global()) { stickerUrl in
-            self.installSticker(stickerInfo: stickerInfo,
-                                stickerUrl: stickerUrl,
-                                contentType: item.contentType,
-                                emojiString: emojiString)
+            DownloadedSticker(stickerInfo: stickerInfo,
+                              stickerUrl: stickerUrl,
+                              contentType: item.contentType,
+                              emojiString: item.emojiString)
         }
     }
 
@@ -131,6 +131,14 @@ public class BaseOWSURLSessionMock: OWSURLSessionProtocol {
         ))
     }
 
+    public func streamingDataTaskPromise(
+        request: URLRequest,
+        shouldContinue: @escaping (Data) -> Bool
+    ) -> Promise<HTTPResponse> {
+        // Want different behavior? Write a custom mock class
+        return dataTaskPromise(request: request, ignoreAppExpiry: false)
+    }
+
     public func downloadTaskPromise(
         request: URLRequest,
         progress progressBlock: ProgressBlock?
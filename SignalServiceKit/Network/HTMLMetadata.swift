@@ -108,6 +108,69 @@ extension HTMLMetadata {
     }
 }
 
+// MARK: - Head Scanning
+
+extension HTMLMetadata {
+
+    /// Finds the end of a document's `<head>` as it's downloaded.
+    ///
+    /// Everything `construct(parsing:)` looks for belongs in the head, so a
+    /// download can stop as soon as the head is complete. The head ends at
+    /// the first `</head` or `<body` (either is optional in HTML). Each byte
+    /// is only scanned once, however the document is split into chunks.
+    struct HeadScanner {
+        private static let endMarkers: [[UInt8]] = ["</head", "<body"].map { Array($0.utf8) }
+        private static let maxMarkerLength = endMarkers.map(\.count).max()!
+
+        /// The length of the head, in bytes, once its end has been found.
+        private(set) var headLength: Int?
+
+        private var scannedLength = 0
+
+        /// Scans the newly received part of `data`, which must be the entire
+        /// document received so far. Returns true once the head is complete.
+        mutating func scan(_ data: Data) -> Bool {
+            if headLength != nil {
+                return true
+            }
+            // Markers may straddle chunks, so back up far enough to see one.
+            let startOffset = max(0, scannedLength - (Self.maxMarkerLength - 1))
+            headLength = data.withUnsafeBytes { buffer -> Int? in
+                let bytes = buffer.bindMemory(to: UInt8.self)
+                var offset = startOffset
+                while offset < bytes.count {
+                    if bytes[offset] == UInt8(ascii: "<"), Self.hasEndMarker(in: bytes, at: offset) {
+                        return offset
+                    }
+                    offset += 1
+                }
+                return nil
+            }
+            scannedLength = data.count
+            return headLength != nil
+        }
+
+        private static func hasEndMarker(in bytes: UnsafeBufferPointer<UInt8>, at offset: Int) -> Bool {
+            return endMarkers.contains { marker in
+                guard offset + marker.count <= bytes.count else {
+                    return false
+                }
+                for (index, markerByte) in marker.enumerated() {
+                    // ASCII lowercase; the markers are all lowercase.
+                    var byte = bytes[offset + index]
+                    if byte >= UInt8(ascii: "A"), byte <= UInt8(ascii: "Z") {
+                        byte += 32
+                    }
+                    guard byte == markerByte else {
+                        return false
+                    }
+                }
+                return true
+            }
+        }
+    }
+}
+
  // MARK: - Regular Expressions
 
 extension HTMLMetadata {
@@ -160,6 +160,15 @@ public protocol OWSURLSessionProtocol: AnyObject, Dependencies {
         ignoreAppExpiry: Bool
     ) -> Promise<HTTPResponse>
 
+    /// Like `dataTaskPromise(request:ignoreAppExpiry:)`, but passes the body
+    /// received so far to `shouldContinue` as each chunk arrives. If it returns
+    /// false, the rest of the body isn't downloaded, and the promise resolves
+    /// with the part that was.
+    func streamingDataTaskPromise(
+        request: URLRequest,
+        shouldContinue: @escaping (Data) -> Bool
+    ) -> Promise<HTTPResponse>
+
     func downloadTaskPromise(
         requestUrl: URL,
         resumeData: Data,
@@ -248,6 +257,19 @@ public extension OWSURLSessionProtocol {
         }
     }
 
+    func streamingDataTaskPromise(
+        on scheduler: Scheduler = DispatchQueue.global(),
+        _ urlString: String,
+        method: HTTPMethod,
+        headers: [String: String]? = nil,
+        shouldContinue: @escaping (Data) -> Bool
+    ) -> Promise<HTTPResponse> {
+        firstly(on: scheduler) { () -> Promise<HTTPResponse> in
+            let request = try self.endpoint.buildRequest(urlString, method: method, headers: headers)
+            return self.streamingDataTaskPromise(request: request, shouldContinue: shouldContinue)
+        }
+    }
+
     // MARK: - Download Tasks Convenience
 
     func downloadTaskPromise(
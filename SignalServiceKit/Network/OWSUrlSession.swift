@@ -222,6 +222,53 @@ public class OWSURLSession: NSObject, OWSURLSessionProtocol {
         }
     }
 
+    public func streamingDataTaskPromise(
+        request: URLRequest,
+        shouldContinue: @escaping (Data) -> Bool
+    ) -> Promise<HTTPResponse> {
+        if DependenciesBridge.shared.appExpiry.isExpired {
+            return Promise(error: OWSAssertionError("App is expired."))
+        }
+
+        let request = prepareRequest(request: request)
+        let taskState = StreamingDataTaskState(shouldContinue: shouldContinue)
+        // Without a completion handler, the body is delivered to the delegate.
+        let task = session.dataTask(with: request)
+        addTask(task, taskState: taskState)
+        guard let requestUrl = request.url else {
+            owsFail("Request missing url.")
+        }
+        let requestConfig = self.requestConfig(forTask: task, requestUrl: requestUrl)
+        task.resume()
+
+        return firstly { () -> Promise<StreamingDataTaskState.Result> in
+            taskState.promise
+        }.then(on: DispatchQueue.global()) { (result: StreamingDataTaskState.Result) -> Promise<HTTPResponse> in
+            guard result.didStopEarly else {
+                return Self.uploadOrDataTaskCompletionPromise(requestConfig: requestConfig, responseData: result.responseData)
+            }
+            // The task was cancelled on purpose, so its error doesn't matter.
+            guard let httpUrlResponse = requestConfig.task.response as? HTTPURLResponse else {
+                throw OWSHTTPError.invalidResponse(requestUrl: requestUrl)
+            }
+            let statusCode = httpUrlResponse.statusCode
+            if requestConfig.require2xxOr3xx, !(200..<400).contains(statusCode) {
+                throw OWSHTTPError.forServiceResponse(
+                    requestUrl: requestUrl,
+                    responseStatus: statusCode,
+                    responseHeaders: OWSHttpHeaders(response: httpUrlResponse),
+                    responseError: nil,
+                    responseData: result.responseData
+                )
+            }
+            return .value(HTTPResponseImpl.build(
+                requestUrl: requestUrl,
+                httpUrlResponse: httpUrlResponse,
+                bodyData: result.responseData
+            ))
+        }
+    }
+
     @available(swift, obsoleted: 1.0)
     func dataTask(_ urlString: String,
                   method: HTTPMethod,
@@ -680,6 +727,23 @@ public class OWSURLSession: NSObject, OWSURLSessionProtocol {
         }
     }
 
+    private func streamingDataTaskState(forTask task: URLSessionTask) -> StreamingDataTaskState? {
+        lock.withLock {
+            self.taskStateMap[task.taskIdentifier] as? StreamingDataTaskState
+        }
+    }
+
+    private func streamingDataTaskDidFinish(_ task: URLSessionTask, didStopEarly: Bool) {
+        guard let taskState = removeCompletedTaskState(task) as? StreamingDataTaskState else {
+            owsFailDebug("Missing TaskState.")
+            return
+        }
+        taskState.finish(didStopEarly: didStopEarly)
+        if didStopEarly {
+            task.cancel()
+        }
+    }
+
     private func downloadTaskDidSucceed(_ task: URLSessionTask, downloadUrl: URL) {
         guard let taskState = removeCompletedTaskState(task) as? DownloadTaskState else {
             owsFailDebug("Missing TaskState.")
@@ -739,6 +803,8 @@ extension OWSURLSession: URLSessionDelegate {
         if let error = error {
             Logger.info("Error: \(error)")
             taskDidFail(task, error: error)
+        } else if streamingDataTaskState(forTask: task) != nil {
+            streamingDataTaskDidFinish(task, didStopEarly: false)
         }
     }
 
@@ -883,13 +949,17 @@ extension OWSURLSession: URLSessionDownloadDelegate {
     }
 
     func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive data: Data) {
-        guard let maxResponseSize = maxResponseSize else {
-            return
+        if let maxResponseSize = maxResponseSize {
+            guard dataTask.countOfBytesReceived <= maxResponseSize else {
+                owsFailDebug("Oversize response: \(dataTask.countOfBytesReceived) > \(maxResponseSize)")
+                dataTask.cancel()
+                return
+            }
         }
-        guard dataTask.countOfBytesReceived <= maxResponseSize else {
-            owsFailDebug("Oversize response: \(dataTask.countOfBytesReceived) > \(maxResponseSize)")
-            dataTask.cancel()
-            return
+        if let streamingDataTaskState = streamingDataTaskState(forTask: dataTask) {
+            if !streamingDataTaskState.didReceive(data) {
+                streamingDataTaskDidFinish(dataTask, didStopEarly: true)
+            }
         }
     }
 }
@@ -966,6 +1036,48 @@ private class UploadOrDataTaskState: TaskState {
     }
 }
 
+// MARK: - StreamingDataTaskState
+
+private class StreamingDataTaskState: TaskState {
+    struct Result {
+        let responseData: Data
+        let didStopEarly: Bool
+    }
+
+    var progressBlock: ProgressBlock? { nil }
+    let promise: Promise<Result>
+    let future: Future<Result>
+
+    private let shouldContinue: (Data) -> Bool
+    private let lock = UnfairLock()
+    private var responseData = Data()
+
+    init(shouldContinue: @escaping (Data) -> Bool) {
+        self.shouldContinue = shouldContinue
+
+        let (promise, future) = Promise<Result>.pending()
+        self.promise = promise
+        self.future = future
+    }
+
+    /// Returns false if the rest of the response isn't needed.
+    func didReceive(_ data: Data) -> Bool {
+        return lock.withLock {
+            responseData.append(data)
+            return shouldContinue(responseData)
+        }
+    }
+
+    func finish(didStopEarly: Bool) {
+        let responseData = lock.withLock { self.responseData }
+        future.resolve(Result(responseData: responseData, didStopEarly: didStopEarly))
+    }
+
+    func reject(error: Error, task: URLSessionTask) {
+        future.reject(error)
+    }
+}
+
 // MARK: - WebSocketTaskState
 
 private class WebSocketTaskState: TaskState {
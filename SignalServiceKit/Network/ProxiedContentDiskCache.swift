@@ -0,0 +1,387 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Proxied content that has been downloaded, kept on disk across launches.
+///
+/// Once the cache grows past its byte budget, the least recently used
+/// entries are evicted. Each entry keeps the validators of the response that
+/// filled it, so a stale entry can be revalidated with a conditional request
+/// instead of being downloaded again. A download that doesn't finish can be
+/// kept as a partial entry holding the prefix that did arrive, so a later
+/// request only needs to fetch the rest.
+///
+/// This class is thread-safe, but reads and writes files synchronously, so
+/// only `entry(forKey:)` should be called on the main thread. The index is
+/// loaded in the background when the cache is created; until it's loaded,
+/// `entry(forKey:)` finds nothing.
+public class ProxiedContentDiskCache {
+
+    /// The `ETag` and `Last-Modified` headers of a response.
+    public struct Validators: Codable, Equatable {
+        public let eTag: String?
+        public let lastModified: String?
+
+        public init?(response: HTTPURLResponse) {
+            let eTag = response.value(forHTTPHeaderField: "ETag")
+            let lastModified = response.value(forHTTPHeaderField: "Last-Modified")
+            guard eTag != nil || lastModified != nil else {
+                return nil
+            }
+            self.eTag = eTag
+            self.lastModified = lastModified
+        }
+
+        /// Makes `request` conditional, so that the server responds with 304
+        /// if the content hasn't changed.
+        public func addConditionalHeaders(to request: inout URLRequest) {
+            if let eTag {
+                request.setValue(eTag, forHTTPHeaderField: "If-None-Match")
+            }
+            if let lastModified {
+                request.setValue(lastModified, forHTTPHeaderField: "If-Modified-Since")
+            }
+        }
+
+        /// Makes the range in `request` conditional, so that the server sends
+        /// the whole (new) content instead if the content has changed.
+        public func addIfRangeHeader(to request: inout URLRequest) {
+            // If-Range only works with strong ETags.
+            if let eTag, !eTag.hasPrefix("W/") {
+                request.setValue(eTag, forHTTPHeaderField: "If-Range")
+            } else if let lastModified {
+                request.setValue(lastModified, forHTTPHeaderField: "If-Range")
+            }
+        }
+    }
+
+    public struct Entry: Codable {
+        fileprivate let fileName: String
+        /// The length of the whole content.
+        public let contentLength: Int
+        /// The number of bytes on disk. Equal to `contentLength` unless this is a
+        /// partial entry.
+        public let byteCount: Int
+        public let validators: Validators?
+        public fileprivate(set) var validatedDate: Date
+        fileprivate var lastAccessDate: Date
+
+        public var isComplete: Bool { byteCount == contentLength }
+    }
+
+    public struct Metrics {
+        public var requestCount = 0
+        public var memoryHitCount = 0
+        public var diskHitCount = 0
+        public var revalidatedCount = 0
+        public var resumedCount = 0
+        public var bytesDownloaded = 0
+        /// Bytes served from the cache that would otherwise have been downloaded.
+        public var bytesSaved = 0
+
+        /// The fraction of requests that didn't need to download the content.
+        public var hitRate: Double {
+            guard requestCount > 0 else {
+                return 0
+            }
+            return Double(memoryHitCount + diskHitCount + revalidatedCount) / Double(requestCount)
+        }
+    }
+
+    public let metrics = AtomicValue(Metrics(), lock: .init())
+
+    private let directoryPath: String
+    private let maxByteCount: Int
+    private let maxAge: TimeInterval
+    private let dateProvider: DateProvider
+
+    private let lock = UnfairLock()
+    /// Nil until the index has been loaded on `indexQueue`.
+    private var entries: [String: Entry]?
+    private var totalByteCount = 0
+    private var isIndexWriteScheduled = false
+    private let indexQueue = DispatchQueue(label: "org.signal.proxied-content-disk-cache")
+
+    public init(
+        directoryPath: String,
+        maxByteCount: Int = 100 * 1024 * 1024,
+        maxAge: TimeInterval = kDayInterval,
+        dateProvider: @escaping DateProvider = Date.provider
+    ) {
+        self.directoryPath = directoryPath
+        self.maxByteCount = maxByteCount
+        self.maxAge = maxAge
+        self.dateProvider = dateProvider
+
+        indexQueue.async { [weak self] in
+            self?.loadIndexIfNeeded()
+        }
+    }
+
+    public static func key(for url: URL) -> String? {
+        return Cryptography.computeSHA256Digest(Data(url.absoluteString.utf8))?.hexadecimalString
+    }
+
+    // MARK: - Reading
+
+    /// Returns the entry for `key` and marks it as recently used.
+    public func entry(forKey key: String) -> Entry? {
+        return lock.withLock {
+            guard var entry = entries?[key] else {
+                return nil
+            }
+            entry.lastAccessDate = dateProvider()
+            entries?[key] = entry
+            scheduleIndexWrite()
+            return entry
+        }
+    }
+
+    /// Whether `entry` can be used without revalidating it.
+    public func isFresh(_ entry: Entry) -> Bool {
+        return entry.isComplete && dateProvider().timeIntervalSince(entry.validatedDate) < maxAge
+    }
+
+    /// Reads the (possibly partial) content of `entry`.
+    public func readData(for entry: Entry) -> Data? {
+        do {
+            let data = try Data(contentsOf: fileUrl(fileName: entry.fileName))
+            guard data.count == entry.byteCount else {
+                owsFailDebug("Cached content has unexpected length.")
+                return nil
+            }
+            return data
+        } catch {
+            Logger.warn("Couldn't read cached content: \(error)")
+            return nil
+        }
+    }
+
+    /// Makes the content of a complete `entry` available at `filePath`.
+    ///
+    /// The file is hard-linked where possible, so it survives the entry being
+    /// evicted without taking up any more space while both exist.
+    public func linkContent(for entry: Entry, toFilePath filePath: String) -> Bool {
+        owsAssertDebug(entry.isComplete)
+
+        let fileManager = FileManager.default
+        let sourcePath = fileUrl(fileName: entry.fileName).path
+        do {
+            try fileManager.linkItem(atPath: sourcePath, toPath: filePath)
+            return true
+        } catch {
+            do {
+                try fileManager.copyItem(atPath: sourcePath, toPath: filePath)
+                return true
+            } catch {
+                Logger.warn("Couldn't link cached content: \(error)")
+                return false
+            }
+        }
+    }
+
+    // MARK: - Writing
+
+    /// Stores `data`, the first `data.count` bytes of content that is
+    /// `contentLength` bytes long, replacing any existing entry for `key`.
+    @discardableResult
+    public func store(data: Data, contentLength: Int, validators: Validators?, forKey key: String) -> Entry? {
+        guard data.count > 0, data.count <= contentLength, data.count <= maxByteCount else {
+            return nil
+        }
+        guard data.count == contentLength || validators != nil else {
+            // Partial content can only be resumed with a conditional range request.
+            return nil
+        }
+
+        // Loading the index deletes files it doesn't know about, so it must
+        // finish before this entry's file is written.
+        waitForIndex()
+
+        let fileName = UUID().uuidString
+        guard OWSFileSystem.ensureDirectoryExists(directoryPath) else {
+            owsFailDebug("Couldn't create cache directory.")
+            return nil
+        }
+        do {
+            try data.write(to: fileUrl(fileName: fileName), options: .atomic)
+        } catch {
+            owsFailDebug("Couldn't write cached content: \(error)")
+            return nil
+        }
+
+        let now = dateProvider()
+        let entry = Entry(
+            fileName: fileName,
+            contentLength: contentLength,
+            byteCount: data.count,
+            validators: validators,
+            validatedDate: now,
+            lastAccessDate: now
+        )
+        let evictedFileNames: [String] = lock.withLock {
+            var evictedFileNames = [String]()
+            if let oldEntry = entries?.removeValue(forKey: key) {
+                totalByteCount -= oldEntry.byteCount
+                evictedFileNames.append(oldEntry.fileName)
+            }
+            entries?[key] = entry
+            totalByteCount += entry.byteCount
+            evictedFileNames += evictLeastRecentlyUsedEntries()
+            scheduleIndexWrite()
+            return evictedFileNames
+        }
+        evictedFileNames.forEach { deleteFile(fileName: $0) }
+        return entry
+    }
+
+    /// Records that the server confirmed the entry for `key` is up to date.
+    public func markValidated(forKey key: String) {
+        lock.withLock {
+            guard var entry = entries?[key] else {
+                return
+            }
+            entry.validatedDate = dateProvider()
+            entries?[key] = entry
+            scheduleIndexWrite()
+        }
+    }
+
+    public func removeEntry(forKey key: String) {
+        waitForIndex()
+        let fileName: String? = lock.withLock {
+            guard let entry = entries?.removeValue(forKey: key) else {
+                return nil
+            }
+            totalByteCount -= entry.byteCount
+            scheduleIndexWrite()
+            return entry.fileName
+        }
+        if let fileName {
+            deleteFile(fileName: fileName)
+        }
+    }
+
+    /// Returns the files of the evicted entries.
+    private func evictLeastRecentlyUsedEntries() -> [String] {
+        lock.assertOwner()
+
+        guard totalByteCount > maxByteCount, let entries else {
+            return []
+        }
+        var evictedFileNames = [String]()
+        for (key, entry) in entries.sorted(by: { $0.value.lastAccessDate < $1.value.lastAccessDate }) {
+            guard totalByteCount > maxByteCount else {
+                break
+            }
+            self.entries?.removeValue(forKey: key)
+            totalByteCount -= entry.byteCount
+            evictedFileNames.append(entry.fileName)
+        }
+        return evictedFileNames
+    }
+
+    // MARK: - Index
+
+    private var indexUrl: URL {
+        URL(fileURLWithPath: directoryPath).appendingPathComponent("index.json")
+    }
+
+    private func fileUrl(fileName: String) -> URL {
+        URL(fileURLWithPath: directoryPath).appendingPathComponent(fileName)
+    }
+
+    private func deleteFile(fileName: String) {
+        do {
+            try OWSFileSystem.deleteFileIfExists(url: fileUrl(fileName: fileName))
+        } catch {
+            Logger.warn("Couldn't delete cached content: \(error)")
+        }
+    }
+
+    /// Blocks until the index has been loaded. Don't call this on the main
+    /// thread.
+    private func waitForIndex() {
+        indexQueue.sync { loadIndexIfNeeded() }
+    }
+
+    /// Loads the index. Files that aren't in the index, e.g. because the app
+    /// was terminated before the index was written, are deleted.
+    private func loadIndexIfNeeded() {
+        assertOnQueue(indexQueue)
+
+        guard lock.withLock({ entries == nil }) else {
+            return
+        }
+
+        var loadedEntries = [String: Entry]()
+        if let indexData = try? Data(contentsOf: indexUrl) {
+            do {
+                loadedEntries = try JSONDecoder().decode([String: Entry].self, from: indexData)
+            } catch {
+                owsFailDebug("Couldn't decode cache index: \(error)")
+            }
+        }
+
+        let fileManager = FileManager.default
+        let indexedFileNames = Set(loadedEntries.values.lazy.map { $0.fileName })
+        let fileNames = Set((try? fileManager.contentsOfDirectory(atPath: directoryPath)) ?? [])
+        for fileName in fileNames.subtracting(indexedFileNames) where fileName != indexUrl.lastPathComponent {
+            deleteFile(fileName: fileName)
+        }
+        loadedEntries = loadedEntries.filter { fileNames.contains($0.value.fileName) }
+
+        lock.withLock {
+            entries = loadedEntries
+            totalByteCount = loadedEntries.values.reduce(0) { $0 + $1.byteCount }
+        }
+    }
+
+    /// Writes the index soon, coalescing changes made in the meantime.
+    private func scheduleIndexWrite() {
+        lock.assertOwner()
+
+        guard !isIndexWriteScheduled else {
+            return
+        }
+        isIndexWriteScheduled = true
+        indexQueue.asyncAfter(deadline: .now() + 1) { [weak self] in
+            self?.writeIndex()
+        }
+    }
+
+    private func writeIndex() {
+        let entries: [String: Entry]? = lock.withLock {
+            isIndexWriteScheduled = false
+            return self.entries
+        }
+        guard let entries else {
+            return
+        }
+        do {
+            guard OWSFileSystem.ensureDirectoryExists(directoryPath) else {
+                owsFailDebug("Couldn't create cache directory.")
+                return
+            }
+            try JSONEncoder().encode(entries).write(to: indexUrl, options: .atomic)
+        } catch {
+            owsFailDebug("Couldn't write cache index: \(error)")
+        }
+    }
+
+    #if TESTABLE_BUILD
+
+    /// Writes any pending changes to the index immediately.
+    func flushIndex() {
+        indexQueue.sync { writeIndex() }
+    }
+
+    func waitForIndexLoad() {
+        waitForIndex()
+    }
+
+    #endif
+}
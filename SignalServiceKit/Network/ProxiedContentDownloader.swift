@@ -160,6 +160,12 @@ public class ProxiedContentAssetRequest: NSObject {
     var wasCancelled = false
     // This property is an internal implementation detail of the download process.
     var assetFilePath: String?
+    // The cache key of the asset's URL.
+    let cacheKey: String?
+    // The validators of the response, used to resume the download later.
+    var validators: ProxiedContentDiskCache.Validators?
+    // The disk cache entry being revalidated or resumed, if any.
+    var cacheEntry: ProxiedContentDiskCache.Entry?
 
     // This state should only be accessed on the main thread.
     private var segments = [ProxiedContentAssetSegment]()
@@ -181,6 +187,7 @@ public class ProxiedContentAssetRequest: NSObject {
         self.priority = priority
         self.success = success
         self.failure = failure
+        self.cacheKey = ProxiedContentDiskCache.key(for: assetDescription.url as URL)
 
         super.init()
     }
@@ -299,8 +306,15 @@ public class ProxiedContentAssetRequest: NSObject {
         return true
     }
 
-    public func writeAssetToFile(downloadFolderPath: String) -> ProxiedContentAsset? {
+    // Returns the leading segments that are complete, which can be kept
+    // if the rest of the asset fails to download.
+    public func completedPrefixSegments() -> [ProxiedContentAssetSegment] {
+        AssertIsOnMainThread()
+
+        return Array(segments.prefix(while: { $0.state == .complete }))
+    }
 
+    public static func mergeSegments(_ segments: [ProxiedContentAssetSegment]) -> Data? {
         var assetData = Data()
         for segment in segments {
             guard segment.state == .complete else {
@@ -316,6 +330,13 @@ public class ProxiedContentAssetRequest: NSObject {
                 return nil
             }
         }
+        return assetData
+    }
+
+    public func mergedAssetData() -> Data? {
+        guard let assetData = Self.mergeSegments(segments) else {
+            return nil
+        }
 
         guard assetData.count == contentLength else {
             owsFailDebug("asset data has unexpected length.")
@@ -326,10 +347,17 @@ public class ProxiedContentAssetRequest: NSObject {
             owsFailDebug("could not write empty asset to disk.")
             return nil
         }
+        return assetData
+    }
 
+    public func newAssetFilePath(downloadFolderPath: String) -> String {
         let fileExtension = assetDescription.fileExtension
         let fileName = (NSUUID().uuidString as NSString).appendingPathExtension(fileExtension)!
-        let filePath = (downloadFolderPath as NSString).appendingPathComponent(fileName)
+        return (downloadFolderPath as NSString).appendingPathComponent(fileName)
+    }
+
+    public func writeAssetToFile(assetData: Data, downloadFolderPath: String) -> ProxiedContentAsset? {
+        let filePath = newAssetFilePath(downloadFolderPath: downloadFolderPath)
 
         do {
             try assetData.write(to: NSURL.fileURL(withPath: filePath), options: .atomicWrite)
@@ -454,11 +482,21 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
 
     private var downloadFolderPath: String?
 
+    // Downloaded assets are also kept here, so that they survive relaunches
+    // and evacuation from the in-memory cache below.
+    private let diskCache: ProxiedContentDiskCache
+
+    public var metrics: ProxiedContentDiskCache.Metrics { diskCache.metrics.get() }
+
     // Force usage as a singleton
     public init(downloadFolderName: String) {
         AssertIsOnMainThread()
 
         self.downloadFolderName = downloadFolderName
+        let cachesPath = (OWSFileSystem.cachesDirectoryPath() as NSString).appendingPathComponent("ProxiedContent")
+        self.diskCache = ProxiedContentDiskCache(
+            directoryPath: (cachesPath as NSString).appendingPathComponent(downloadFolderName)
+        )
 
         super.init()
 
@@ -507,8 +545,17 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
     ) -> ProxiedContentAssetRequest? {
         AssertIsOnMainThread()
 
+        let requestCount = diskCache.metrics.update { metrics in
+            metrics.requestCount += 1
+            return metrics.requestCount
+        }
+        if requestCount % 100 == 0 {
+            logMetrics()
+        }
+
         if let asset = assetMap.get(key: assetDescription.url) {
             // Synchronous cache hit.
+            diskCache.metrics.update { $0.memoryHitCount += 1 }
             success(nil, asset)
             return nil
         }
@@ -566,7 +613,25 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
                 owsFailDebug("Missing downloadFolderPath")
                 return
             }
-            guard let asset = assetRequest.writeAssetToFile(downloadFolderPath: downloadFolderPath) else {
+            guard let assetData = assetRequest.mergedAssetData() else {
+                self.segmentRequestDidFail(assetRequest: assetRequest)
+                return
+            }
+            // Prefer to write the asset once, to the disk cache, and link it
+            // from there.
+            var linkedAsset: ProxiedContentAsset?
+            if
+                let cacheKey = assetRequest.cacheKey,
+                let cacheEntry = self.diskCache.store(
+                    data: assetData,
+                    contentLength: assetData.count,
+                    validators: assetRequest.validators,
+                    forKey: cacheKey
+                )
+            {
+                linkedAsset = self.linkAsset(assetRequest: assetRequest, cacheEntry: cacheEntry)
+            }
+            guard let asset = linkedAsset ?? assetRequest.writeAssetToFile(assetData: assetData, downloadFolderPath: downloadFolderPath) else {
                 self.segmentRequestDidFail(assetRequest: assetRequest)
                 return
             }
@@ -575,6 +640,90 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
         return true
     }
 
+    private func linkAsset(assetRequest: ProxiedContentAssetRequest, cacheEntry: ProxiedContentDiskCache.Entry) -> ProxiedContentAsset? {
+        guard let downloadFolderPath = self.downloadFolderPath else {
+            owsFailDebug("Missing downloadFolderPath")
+            return nil
+        }
+        let filePath = assetRequest.newAssetFilePath(downloadFolderPath: downloadFolderPath)
+        guard diskCache.linkContent(for: cacheEntry, toFilePath: filePath) else {
+            return nil
+        }
+        return ProxiedContentAsset(assetDescription: assetRequest.assetDescription, filePath: filePath)
+    }
+
+    private func assetRequestDidLoadFromDiskCache(
+        assetRequest: ProxiedContentAssetRequest,
+        cacheEntry: ProxiedContentDiskCache.Entry,
+        wasRevalidated: Bool
+    ) {
+        DispatchQueue.global().async {
+            guard let asset = self.linkAsset(assetRequest: assetRequest, cacheEntry: cacheEntry) else {
+                // The cached asset is unusable; download it instead.
+                if let cacheKey = assetRequest.cacheKey {
+                    self.diskCache.removeEntry(forKey: cacheKey)
+                }
+                DispatchQueue.main.async {
+                    assetRequest.cacheEntry = nil
+                    assetRequest.state = .waiting
+                    self.processRequestQueueSync()
+                }
+                return
+            }
+            self.diskCache.metrics.update { metrics in
+                if wasRevalidated {
+                    metrics.revalidatedCount += 1
+                } else {
+                    metrics.diskHitCount += 1
+                }
+                metrics.bytesSaved += cacheEntry.contentLength
+            }
+            self.assetRequestDidSucceed(assetRequest: assetRequest, asset: asset)
+        }
+    }
+
+    // Keeps the leading segments of an asset that failed to download, so
+    // that a later request for the asset only needs to download the rest.
+    private func savePartialAsset(assetRequest: ProxiedContentAssetRequest) {
+        AssertIsOnMainThread()
+
+        guard
+            let cacheKey = assetRequest.cacheKey,
+            let validators = assetRequest.validators,
+            assetRequest.contentLength > 0
+        else {
+            return
+        }
+        let segments = assetRequest.completedPrefixSegments()
+        guard !segments.isEmpty else {
+            return
+        }
+        let contentLength = assetRequest.contentLength
+        DispatchQueue.global().async {
+            guard
+                let partialData = ProxiedContentAssetRequest.mergeSegments(segments),
+                partialData.count < contentLength
+            else {
+                return
+            }
+            if let cacheEntry = self.diskCache.entry(forKey: cacheKey), cacheEntry.byteCount >= partialData.count {
+                return
+            }
+            self.diskCache.store(data: partialData, contentLength: contentLength, validators: validators, forKey: cacheKey)
+        }
+    }
+
+    private func logMetrics() {
+        let metrics = diskCache.metrics.get()
+        Logger.info(
+            "\(downloadFolderName): requests: \(metrics.requestCount), "
+            + "hit rate: \(String(format: "%.2f", metrics.hitRate)) "
+            + "(memory: \(metrics.memoryHitCount), disk: \(metrics.diskHitCount), revalidated: \(metrics.revalidatedCount)), "
+            + "resumed: \(metrics.resumedCount), "
+            + "downloaded: \(metrics.bytesDownloaded) bytes, saved: \(metrics.bytesSaved) bytes"
+        )
+    }
+
     private func assetRequestDidSucceed(assetRequest: ProxiedContentAssetRequest, asset: ProxiedContentAsset) {
         DispatchQueue.main.async {
             self.assetMap.set(key: assetRequest.assetDescription.url, value: asset)
@@ -591,6 +740,7 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
                 // TODO: If we wanted to implement segment retry, we'd do so here.
                 //       For now, we just fail the entire asset request.
             }
+            self.savePartialAsset(assetRequest: assetRequest)
             assetRequest.state = .failed
             self.assetRequestDidFail(assetRequest: assetRequest)
         }
@@ -635,6 +785,7 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
         }
         guard !assetRequest.wasCancelled else {
             // Discard the cancelled asset request and try again.
+            savePartialAsset(assetRequest: assetRequest)
             removeAssetRequestFromQueue(assetRequest: assetRequest)
             return
         }
@@ -649,22 +800,48 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
         if let asset = assetMap.get(key: assetRequest.assetDescription.url) {
             // Deferred cache hit, avoids re-downloading assets that were
             // downloaded while this request was queued.
+            // This is also how requests for an asset that's already being
+            // downloaded are coalesced; see popNextAssetRequest().
 
+            diskCache.metrics.update { $0.memoryHitCount += 1 }
             assetRequest.state = .complete
             assetRequestDidSucceed(assetRequest: assetRequest, asset: asset)
             return
         }
 
+        if assetRequest.state == .waiting, let cacheKey = assetRequest.cacheKey, let cacheEntry = diskCache.entry(forKey: cacheKey) {
+            if diskCache.isFresh(cacheEntry) {
+                assetRequest.state = .complete
+                assetRequestDidLoadFromDiskCache(assetRequest: assetRequest, cacheEntry: cacheEntry, wasRevalidated: false)
+                return
+            }
+            // A stale or partial asset can only be reused if the server
+            // can tell us whether it has changed.
+            if cacheEntry.validators != nil {
+                assetRequest.cacheEntry = cacheEntry
+            }
+        }
+
         if assetRequest.state == .waiting {
             // If asset request hasn't yet determined the resource size,
             // try to do so now, by requesting a small initial segment.
             assetRequest.state = .requestingSize
 
-            let segmentStart: UInt = 0
+            var segmentStart: UInt = 0
             // Vary the initial segment size to obscure the length of the response headers.
             let segmentLength = UInt.random(in: 1024..<2048)
             var request = URLRequest(url: assetRequest.assetDescription.url as URL)
             request.httpShouldUsePipelining = true
+            if let cacheEntry = assetRequest.cacheEntry, let validators = cacheEntry.validators {
+                if cacheEntry.isComplete {
+                    // Revalidate the stale asset; a 304 means it can be used as is.
+                    validators.addConditionalHeaders(to: &request)
+                } else {
+                    // Resume the partial download where it left off.
+                    segmentStart = UInt(cacheEntry.byteCount)
+                    validators.addIfRangeHeader(to: &request)
+                }
+            }
             let rangeHeaderValue = "bytes=\(segmentStart)-\(segmentStart + segmentLength - 1)"
             request.setValue(rangeHeaderValue, forHTTPHeaderField: "Range")
 
@@ -694,6 +871,8 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             request.httpShouldUsePipelining = true
             let rangeHeaderValue = "bytes=\(assetSegment.segmentStart)-\(assetSegment.segmentStart + assetSegment.segmentLength - 1)"
             request.setValue(rangeHeaderValue, forHTTPHeaderField: "Range")
+            // Don't mix segments of different versions of the asset.
+            assetRequest.validators?.addIfRangeHeader(to: &request)
 
             guard ContentProxy.configureProxiedRequest(request: &request) else {
                 assetRequest.state = .failed
@@ -719,6 +898,20 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             self.assetRequestDidFail(assetRequest: assetRequest)
             return
         }
+        if
+            let cacheKey = assetRequest.cacheKey,
+            let cacheEntry = assetRequest.cacheEntry,
+            cacheEntry.isComplete,
+            (response as? HTTPURLResponse)?.statusCode == 304
+        {
+            // The stale asset hasn't changed.
+            diskCache.markValidated(forKey: cacheKey)
+            DispatchQueue.main.async {
+                assetRequest.state = .complete
+                self.assetRequestDidLoadFromDiskCache(assetRequest: assetRequest, cacheEntry: cacheEntry, wasRevalidated: true)
+            }
+            return
+        }
         guard let data = data,
         data.count > 0 else {
             owsFailDebug("Asset size response missing data.")
@@ -738,6 +931,18 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             self.assetRequestDidFail(assetRequest: assetRequest)
             return
         }
+        if let cacheKey = assetRequest.cacheKey, assetRequest.cacheEntry != nil, httpResponse.statusCode == 200 {
+            // The If-Range condition failed, so the cached asset is out of
+            // date and the response is the whole new asset. Start over with
+            // a plain size request.
+            diskCache.removeEntry(forKey: cacheKey)
+            DispatchQueue.main.async {
+                assetRequest.cacheEntry = nil
+                assetRequest.state = .waiting
+                self.processRequestQueueSync()
+            }
+            return
+        }
         var firstContentRangeString: String?
         for header in httpResponse.allHeaderFields.keys {
             guard let headerString = header as? String else {
@@ -779,9 +984,45 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             return
         }
 
+        diskCache.metrics.update { $0.bytesDownloaded += data.count }
+
+        var initialData = data
+        if let cacheKey = assetRequest.cacheKey, let cacheEntry = assetRequest.cacheEntry {
+            let rangeStartString = NSRegularExpression.parseFirstMatch(pattern: "^bytes (\\d+)\\-\\d+/\\d+$",
+                                                                       text: contentRangeString)
+            if
+                !cacheEntry.isComplete,
+                contentLength == cacheEntry.contentLength,
+                rangeStartString.flatMap({ Int($0) }) == cacheEntry.byteCount,
+                let partialData = diskCache.readData(for: cacheEntry)
+            {
+                // The response continues the partial asset.
+                initialData = partialData + data
+                diskCache.metrics.update { metrics in
+                    metrics.resumedCount += 1
+                    metrics.bytesSaved += partialData.count
+                }
+            } else {
+                // The asset has changed, so the cached copy is useless.
+                diskCache.removeEntry(forKey: cacheKey)
+                if !cacheEntry.isComplete {
+                    // The response isn't the start of the asset, so start over.
+                    DispatchQueue.main.async {
+                        assetRequest.cacheEntry = nil
+                        assetRequest.state = .waiting
+                        self.processRequestQueueSync()
+                    }
+                    return
+                }
+            }
+        }
+        let validators = ProxiedContentDiskCache.Validators(response: httpResponse)
+
         DispatchQueue.main.async {
+            assetRequest.cacheEntry = nil
+            assetRequest.validators = validators
             assetRequest.contentLength = contentLength
-            assetRequest.createSegments(withInitialData: data)
+            assetRequest.createSegments(withInitialData: initialData)
             assetRequest.state = .active
 
             if !self.tryToCompleteRequest(assetRequest: assetRequest) {
@@ -807,6 +1048,11 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             for assetRequest in assetRequestQueue where assetRequest.priority == priority {
                 switch assetRequest.state {
                 case .waiting:
+                    // If another request is already downloading this asset,
+                    // wait for it to finish and use its result.
+                    guard !isDownloadingAsset(url: assetRequest.assetDescription.url) else {
+                        continue
+                    }
                     // This asset request needs its content length.
                     return assetRequest
                 case .requestingSize:
@@ -845,11 +1091,29 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
         return nil
     }
 
+    private func isDownloadingAsset(url: NSURL) -> Bool {
+        AssertIsOnMainThread()
+
+        return assetRequestQueue.contains { assetRequest in
+            guard !assetRequest.wasCancelled, assetRequest.assetDescription.url == url else {
+                return false
+            }
+            return assetRequest.state == .requestingSize || assetRequest.state == .active
+        }
+    }
+
     // MARK: URLSessionDataDelegate
 
     @nonobjc
     public func urlSession(_ session: URLSession, dataTask: URLSessionDataTask, didReceive response: URLResponse, completionHandler: @escaping (URLSession.ResponseDisposition) -> Void) {
 
+        // A segment request that gets the whole asset back (rather than a 206)
+        // means the asset changed since its download started; see If-Range.
+        if (response as? HTTPURLResponse)?.statusCode == 200 {
+            Logger.warn("Asset changed during download.")
+            completionHandler(.cancel)
+            return
+        }
         completionHandler(.allow)
     }
 
@@ -861,6 +1125,7 @@ open class ProxiedContentDownloader: NSObject, URLSessionTaskDelegate, URLSessio
             segmentRequestDidFail(assetRequest: assetRequest, assetSegment: assetSegment)
             return
         }
+        diskCache.metrics.update { $0.bytesDownloaded += data.count }
         assetSegment.append(data: data)
     }
 
@@ -835,6 +835,16 @@ internal class GroupsMessageProcessor: MessageProcessingPipelineStage, Dependenc
                 Logger.warn("Error: \(type(of: error)) \(error)")
             } else {
                 owsFailDebugUnlessNetworkFailure(error)
+
+                // We know the group is behind; make sure the next auto-refresh
+                // catches it up.
+                await databaseStorage.awaitableWrite { tx in
+                    GroupAutoRefreshScheduler.noteKnownRevision(
+                        groupContext.revision,
+                        groupId: groupContextInfo.groupId,
+                        transaction: tx
+                    )
+                }
             }
 
             return .failureShouldDiscard
@@ -638,7 +638,7 @@ extension OWSProfileManager: ProfileManager, Dependencies {
             if shouldFetchProfile {
                 tx.addSyncCompletion {
                     let profileFetcher = SSKEnvironment.shared.profileFetcherRef
-                    _ = profileFetcher.fetchProfileSync(for: serviceId, options: [.mainAppOnly], authedAccount: authedAccount)
+                    _ = profileFetcher.fetchProfileSync(for: serviceId, options: [.mainAppOnly, .profileKeyChanged], authedAccount: authedAccount)
                 }
             }
         }
@@ -12,6 +12,13 @@ public struct ProfileFetchOptions: OptionSet {
 
     public static let opportunistic: Self = .init(rawValue: 1 << 0)
     public static let mainAppOnly: Self = .init(rawValue: 1 << 1)
+    /// For opportunistic fetches, fetches this profile ahead of any
+    /// background fetches. Use this for profiles that are visible right now,
+    /// e.g., the members of the conversation that's open.
+    public static let activeThread: Self = .init(rawValue: 1 << 2)
+    /// The profile key just changed. A fetch that's already in flight may
+    /// be using the old key, so this one won't join it.
+    public static let profileKeyChanged: Self = .init(rawValue: 1 << 3)
 }
 
 public protocol ProfileFetcher {
@@ -37,11 +44,58 @@ extension ProfileFetcher {
     }
 }
 
+struct ProfileFetchMetrics {
+    private(set) var requestCount = 0
+    private(set) var dedupedRequestCount = 0
+    private(set) var fetchCount = 0
+    private var recentFetchDates = [Date]()
+
+    /// Records a request to fetch a profile. A request is "deduped" if it was
+    /// satisfied by a fetch that was queued, in flight or recently completed.
+    mutating func didRequestFetch(wasDeduped: Bool) {
+        requestCount += 1
+        if wasDeduped {
+            dedupedRequestCount += 1
+        }
+    }
+
+    mutating func didStartFetch(now: Date = Date()) {
+        fetchCount += 1
+        recentFetchDates.append(now)
+        recentFetchDates.removeAll { now.timeIntervalSince($0) >= kMinuteInterval }
+    }
+
+    func fetchesPerMinute(now: Date = Date()) -> Int {
+        return recentFetchDates.lazy.filter { now.timeIntervalSince($0) < kMinuteInterval }.count
+    }
+
+    var dedupeRatio: Double {
+        guard requestCount > 0 else {
+            return 0
+        }
+        return Double(dedupedRequestCount) / Double(requestCount)
+    }
+}
+
 public actor ProfileFetcherImpl: ProfileFetcher {
 
-    private var serviceIdQueue = OrderedSet<ServiceId>()
+    // Opportunistic fetches are queued in one of two tiers. Profiles that are
+    // visible right now are fetched before everything else.
+    private var activeThreadServiceIdQueue = OrderedSet<ServiceId>()
+    private var backgroundServiceIdQueue = OrderedSet<ServiceId>()
+
+    // Bulk fetches spend most of their time waiting on the network, so a few
+    // run at once. They still start at most once per `minimumBulkFetchInterval`
+    // (see `runBulkFetch`), so this doesn't raise the rate they're sent at.
+    private static let maxConcurrentBulkFetches = 3
+    private static let minimumBulkFetchInterval: TimeInterval = 0.1
+    private var bulkFetchesInFlight = 0
+    private var nextBulkFetchStartDate = Date.distantPast
+
+    // Concurrent fetches for the same ServiceId share a single request.
+    private var inFlightFetches = [ServiceId: Task<FetchedProfile, Error>]()
 
-    private var isUpdateInFlight = false
+    private var metrics = ProfileFetchMetrics()
 
     private struct UpdateOutcome {
         let outcome: Outcome
@@ -66,6 +120,7 @@ public actor ProfileFetcherImpl: ProfileFetcher {
     private var observers = [NSObjectProtocol]()
 
     private let jobCreator: (ServiceId, AuthedAccount) -> ProfileFetcherJob
+    private let updateBatcher: ProfileUpdateBatcher
     private let reachabilityManager: any SSKReachabilityManager
     private let tsAccountManager: any TSAccountManager
 
@@ -84,11 +139,14 @@ public actor ProfileFetcherImpl: ProfileFetcher {
     ) {
         self.reachabilityManager = reachabilityManager
         self.tsAccountManager = tsAccountManager
+        let updateBatcher = ProfileUpdateBatcher(db: db)
+        self.updateBatcher = updateBatcher
         self.jobCreator = { serviceId, authedAccount in
             return ProfileFetcherJob(
                 serviceId: serviceId,
                 authedAccount: authedAccount,
                 db: db,
+                updateBatcher: updateBatcher,
                 identityManager: identityManager,
                 paymentsHelper: paymentsHelper,
                 profileManager: profileManager,
@@ -151,7 +209,7 @@ public actor ProfileFetcherImpl: ProfileFetcher {
         authedAccount: AuthedAccount
     ) async throws -> FetchedProfile {
         if options.contains(.opportunistic) {
-            await self._fetchProfiles(serviceIds: [serviceId])
+            await self._fetchProfiles(serviceIds: [serviceId], isActiveThread: options.contains(.activeThread))
             // TODO: Clean up this type so that we can pass back real results.
             throw OWSGenericError("Detaching profile fetch because it's opportunistic.")
         }
@@ -161,10 +219,52 @@ public actor ProfileFetcherImpl: ProfileFetcher {
         if options.contains(.mainAppOnly), !CurrentAppContext().isMainApp {
             throw OWSGenericError("Skipping profile fetch because we're not the main app.")
         }
-        return try await jobCreator(serviceId, authedAccount).run()
+        return try await fetchProfileCoalescingRequests(
+            for: serviceId,
+            canJoinInFlightFetch: !options.contains(.profileKeyChanged),
+            authedAccount: authedAccount
+        )
+    }
+
+    private func fetchProfileCoalescingRequests(
+        for serviceId: ServiceId,
+        canJoinInFlightFetch: Bool,
+        authedAccount: AuthedAccount
+    ) async throws -> FetchedProfile {
+        // Fetches for an explicit account happen during registration, when
+        // there's nothing else to share a request with.
+        guard authedAccount.info == .implicit else {
+            metrics.didRequestFetch(wasDeduped: false)
+            didStartFetch()
+            return try await jobCreator(serviceId, authedAccount).run()
+        }
+        if canJoinInFlightFetch, let inFlightFetch = inFlightFetches[serviceId] {
+            metrics.didRequestFetch(wasDeduped: true)
+            return try await inFlightFetch.value
+        }
+        metrics.didRequestFetch(wasDeduped: false)
+        didStartFetch()
+        let job = jobCreator(serviceId, authedAccount)
+        let fetch = Task { try await job.run() }
+        // Later requests join this fetch rather than one that may be using an
+        // older profile key.
+        inFlightFetches[serviceId] = fetch
+        defer {
+            if inFlightFetches[serviceId] == fetch {
+                inFlightFetches[serviceId] = nil
+            }
+        }
+        return try await fetch.value
+    }
+
+    private func didStartFetch() {
+        metrics.didStartFetch()
+        if metrics.fetchCount % 50 == 0 {
+            Logger.info("Profile fetches: \(metrics.fetchCount) total, \(metrics.fetchesPerMinute()) in the last minute, \(Int(metrics.dedupeRatio * 100))% of requests deduped")
+        }
     }
 
-    private func _fetchProfiles(serviceIds: [ServiceId]) async {
+    private func _fetchProfiles(serviceIds: [ServiceId], isActiveThread: Bool) async {
         guard tsAccountManager.registrationStateWithMaybeSneakyTransaction.isRegistered else {
             return
         }
@@ -176,10 +276,27 @@ public actor ProfileFetcherImpl: ProfileFetcher {
             if localIdentifiers.contains(serviceId: serviceId) {
                 continue
             }
-            if serviceIdQueue.contains(serviceId) {
+            if inFlightFetches[serviceId] != nil || !shouldUpdateServiceId(serviceId) {
+                metrics.didRequestFetch(wasDeduped: true)
                 continue
             }
-            serviceIdQueue.append(serviceId)
+            if isActiveThread {
+                if activeThreadServiceIdQueue.contains(serviceId) {
+                    metrics.didRequestFetch(wasDeduped: true)
+                    continue
+                }
+                // Promote it if it was waiting in the background.
+                metrics.didRequestFetch(wasDeduped: backgroundServiceIdQueue.contains(serviceId))
+                backgroundServiceIdQueue.remove(serviceId)
+                activeThreadServiceIdQueue.append(serviceId)
+            } else {
+                if activeThreadServiceIdQueue.contains(serviceId) || backgroundServiceIdQueue.contains(serviceId) {
+                    metrics.didRequestFetch(wasDeduped: true)
+                    continue
+                }
+                metrics.didRequestFetch(wasDeduped: false)
+                backgroundServiceIdQueue.append(serviceId)
+            }
         }
         await process()
     }
@@ -187,13 +304,19 @@ public actor ProfileFetcherImpl: ProfileFetcher {
     private func dequeueServiceIdToUpdate() -> ServiceId? {
         while true {
             // Dequeue.
-            guard let serviceId = serviceIdQueue.first else {
+            let serviceId: ServiceId
+            if let activeThreadServiceId = activeThreadServiceIdQueue.first {
+                serviceId = activeThreadServiceId
+                activeThreadServiceIdQueue.remove(serviceId)
+            } else if let backgroundServiceId = backgroundServiceIdQueue.first {
+                serviceId = backgroundServiceId
+                backgroundServiceIdQueue.remove(serviceId)
+            } else {
                 return nil
             }
-            serviceIdQueue.remove(serviceId)
 
             // De-bounce.
-            guard shouldUpdateServiceId(serviceId) else {
+            guard inFlightFetches[serviceId] == nil, shouldUpdateServiceId(serviceId) else {
                 continue
             }
 
@@ -202,46 +325,59 @@ public actor ProfileFetcherImpl: ProfileFetcher {
     }
 
     private func process() async {
-        // Only one update in flight at a time.
-        guard !isUpdateInFlight else {
-            return
-        }
+        // A few bulk fetches can be in flight at once.
+        while bulkFetchesInFlight < Self.maxConcurrentBulkFetches {
+            guard
+                CurrentAppContext().isMainApp,
+                reachabilityManager.isReachable,
+                tsAccountManager.registrationStateWithMaybeSneakyTransaction.isRegistered,
+                !DebugFlags.reduceLogChatter
+            else {
+                return
+            }
 
-        guard
-            CurrentAppContext().isMainApp,
-            reachabilityManager.isReachable,
-            tsAccountManager.registrationStateWithMaybeSneakyTransaction.isRegistered,
-            !DebugFlags.reduceLogChatter
-        else {
-            return
-        }
+            guard let serviceId = dequeueServiceIdToUpdate() else {
+                return
+            }
 
-        guard let serviceId = dequeueServiceIdToUpdate() else {
-            return
+            bulkFetchesInFlight += 1
+            Task {
+                await self.runBulkFetch(for: serviceId)
+            }
         }
+    }
 
-        isUpdateInFlight = true
-
+    private func runBulkFetch(for serviceId: ServiceId) async {
         defer {
             Task {
-                // We need to throttle these jobs.
-                //
-                // The profile fetch rate limit is a bucket size of 4320, which refills at
-                // a rate of 3 per minute.
-                //
-                // This class handles the "bulk" profile fetches which are common but not
-                // urgent. The app also does other "blocking" profile fetches which are
-                // urgent but not common. To help ensure that "blocking" profile fetches
-                // succeed, the "bulk" profile fetches are cautious. This takes two forms:
-                //
-                // * Rate-limiting bulk profiles faster than the service's rate limit.
-                // * Backing off aggressively if we hit the rate limit.
-                try? await Task.sleep(nanoseconds: 100 * NSEC_PER_MSEC)
-                self.isUpdateInFlight = false
+                self.bulkFetchesInFlight -= 1
                 await self.process()
             }
         }
 
+        // We need to throttle these jobs.
+        //
+        // The profile fetch rate limit is a bucket size of 4320, which refills at
+        // a rate of 3 per minute.
+        //
+        // This class handles the "bulk" profile fetches which are common but not
+        // urgent. The app also does other "blocking" profile fetches which are
+        // urgent but not common. To help ensure that "blocking" profile fetches
+        // succeed, the "bulk" profile fetches are cautious. This takes two forms:
+        //
+        // * Rate-limiting bulk profiles faster than the service's rate limit.
+        // * Backing off aggressively if we hit the rate limit.
+        //
+        // Fetches that run at once share one schedule, so together they start no
+        // faster than a single fetcher pausing `minimumBulkFetchInterval` between
+        // fetches on an instant network would.
+        let now = Date()
+        let startDate = max(now, nextBulkFetchStartDate)
+        nextBulkFetchStartDate = startDate.addingTimeInterval(Self.minimumBulkFetchInterval)
+        if startDate > now {
+            try? await Task.sleep(nanoseconds: UInt64(startDate.timeIntervalSince(now) * Double(NSEC_PER_SEC)))
+        }
+
         // Wait before updating if we've recently hit the rate limit.
         // This will give the rate limit bucket time to refill.
         if let lastRateLimitErrorDate, -lastRateLimitErrorDate.timeIntervalSinceNow < 5*kMinuteInterval {
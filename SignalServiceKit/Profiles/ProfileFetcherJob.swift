@@ -20,6 +20,7 @@ public class ProfileFetcherJob {
     private let authedAccount: AuthedAccount
 
     private let db: any DB
+    private let updateBatcher: ProfileUpdateBatcher
     private let identityManager: any OWSIdentityManager
     private let paymentsHelper: any PaymentsHelper
     private let profileManager: any ProfileManager
@@ -34,6 +35,7 @@ public class ProfileFetcherJob {
         serviceId: ServiceId,
         authedAccount: AuthedAccount,
         db: any DB,
+        updateBatcher: ProfileUpdateBatcher,
         identityManager: any OWSIdentityManager,
         paymentsHelper: any PaymentsHelper,
         profileManager: any ProfileManager,
@@ -47,6 +49,7 @@ public class ProfileFetcherJob {
         self.serviceId = serviceId
         self.authedAccount = authedAccount
         self.db = db
+        self.updateBatcher = updateBatcher
         self.identityManager = identityManager
         self.paymentsHelper = paymentsHelper
         self.profileManager = profileManager
@@ -286,7 +289,8 @@ public class ProfileFetcherJob {
         let profile = fetchedProfile.profile
         let serviceId = profile.serviceId
 
-        await db.awaitableWrite { transaction in
+        // Concurrent fetches share write transactions.
+        await updateBatcher.write { transaction in
             self.updateUnidentifiedAccess(
                 serviceId: serviceId,
                 verifier: profile.unidentifiedAccessVerifier,
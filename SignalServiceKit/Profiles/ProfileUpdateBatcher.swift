@@ -0,0 +1,62 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+
+/// Applies the database updates from concurrent profile fetches together.
+///
+/// Bulk profile fetches tend to finish at around the same time, and each one
+/// used to open its own write transaction. Updates that arrive while a batch
+/// is being written are queued and applied together in the next transaction.
+actor ProfileUpdateBatcher {
+    static let maxBatchSize = 32
+
+    private let db: any DB
+
+    private struct PendingUpdate {
+        let block: (DBWriteTransaction) -> Void
+        let continuation: CheckedContinuation<Void, Never>
+    }
+
+    private var pendingUpdates = [PendingUpdate]()
+    private var isWriting = false
+
+    private(set) var transactionCount = 0
+
+    var pendingUpdateCount: Int { pendingUpdates.count }
+
+    init(db: any DB) {
+        self.db = db
+    }
+
+    /// Runs `block` in a write transaction that may be shared with other
+    /// updates. Returns once that transaction has been committed.
+    func write(_ block: @escaping (DBWriteTransaction) -> Void) async {
+        await withCheckedContinuation { continuation in
+            pendingUpdates.append(PendingUpdate(block: block, continuation: continuation))
+            if !isWriting {
+                isWriting = true
+                Task { await self.writePendingUpdates() }
+            }
+        }
+    }
+
+    private func writePendingUpdates() async {
+        while !pendingUpdates.isEmpty {
+            let batch = pendingUpdates.prefix(Self.maxBatchSize)
+            pendingUpdates.removeFirst(batch.count)
+            transactionCount += 1
+            await db.awaitableWrite { tx in
+                for update in batch {
+                    update.block(tx)
+                }
+            }
+            for update in batch {
+                update.continuation.resume()
+            }
+        }
+        isWriting = false
+    }
+}
@@ -630,6 +630,7 @@ CREATE
             ,"albumMessageId" INTEGER NOT NULL
             ,"threadId" INTEGER NOT NULL
             ,"originalAlbumOrder" INTEGER NOT NULL
+            ,"receivedAtTimestamp" INTEGER NOT NULL DEFAULT 0
         )
 ;
 
@@ -1681,3 +1682,12 @@ CREATE
                 ,"note" TEXT
 )
 ;
+
+CREATE
+    INDEX "index_media_gallery_items_on_threadId_and_receivedAtTimestamp"
+        ON "media_gallery_items"("threadId"
+    ,"receivedAtTimestamp"
+    ,"albumMessageId"
+    ,"originalAlbumOrder"
+)
+;
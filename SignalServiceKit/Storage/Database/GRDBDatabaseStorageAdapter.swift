@@ -519,6 +519,8 @@ extension GRDBDatabaseStorageAdapter: SDSDatabaseStorageAdapter {
         }
     }
 
+    private static let checkpointMetric = PerformanceMetrics.shared.histogram("db.checkpoint")
+
     private func scheduleCheckpoint(lastCheckpointTimestamp: UInt64?) {
         let checkpointDelay: UInt64
         if let lastCheckpointTimestamp {
@@ -680,7 +682,7 @@ extension GRDBDatabaseStorageAdapter: SDSDatabaseStorageAdapter {
                 Logger.warn("Skipping checkpoint for database that's already closed.")
                 return
             }
-            Bench(title: "Checkpoint", logIfLongerThan: 0.25, logInProduction: true) {
+            Bench(title: "Checkpoint", metric: Self.checkpointMetric, logIfLongerThan: 0.25, logInProduction: true) {
                 do {
                     try database.checkpoint(.truncate)
 
@@ -1042,15 +1044,42 @@ extension GRDBDatabaseStorageAdapter {
     }
 }
 
+// MARK: - Snapshots
+
+extension GRDBDatabaseStorageAdapter {
+    private static let snapshotMetric = PerformanceMetrics.shared.histogram("db.snapshot")
+
+    /// Writes a consistent snapshot of the database to a new file at `url`.
+    ///
+    /// The snapshot is taken with SQLite's online backup API inside a read
+    /// transaction, so unlike copying the database and WAL files it doesn't
+    /// need to hold off writers while it runs. The snapshot is encrypted with
+    /// the same key and has no WAL; all of its content is in the one file.
+    public func writeSnapshot(to url: URL, keyFetcher: GRDBKeyFetcher) throws {
+        var configuration = Configuration()
+        configuration.label = "GRDB Snapshot"
+        configuration.prepareDatabase { db in
+            try GRDBDatabaseStorageAdapter.prepareDatabase(db: db, keyFetcher: keyFetcher)
+        }
+        let snapshotQueue = try DatabaseQueue(path: url.path, configuration: configuration)
+        try Bench(title: "Database snapshot", metric: Self.snapshotMetric, logIfLongerThan: 1, logInProduction: true) {
+            try pool.backup(to: snapshotQueue)
+        }
+        try snapshotQueue.close()
+    }
+}
+
 // MARK: - Checkpoints
 
 extension GRDBDatabaseStorageAdapter {
+    private static let syncCheckpointMetric = PerformanceMetrics.shared.histogram("db.syncCheckpoint")
+
     public func syncTruncatingCheckpoint() throws {
         try GRDBDatabaseStorageAdapter.checkpoint(pool: pool)
     }
 
     private static func checkpoint(pool: DatabasePool) throws {
-        try Bench(title: "Slow checkpoint", logIfLongerThan: 0.01, logInProduction: true) {
+        try Bench(title: "Slow checkpoint", metric: Self.syncCheckpointMetric, logIfLongerThan: 0.01, logInProduction: true) {
             // Set checkpointTimeout flag.
             // If we hit the timeout, we get back SQLITE_BUSY, which is ignored below.
             owsAssertDebug(GRDBStorage.checkpointTimeout == nil)
@@ -259,6 +259,7 @@ public class GRDBSchemaMigrator: NSObject {
         case addNicknamesToSearchableName
         case addAttachmentMetadataColumnsToIncomingContactSyncJobRecord
         case removeRedundantPhoneNumbers3
+        case addReceivedAtTimestampToMediaGalleryItems
 
         // NOTE: Every time we add a migration id, consider
         // incrementing grdbSchemaVersionLatest.
@@ -2802,6 +2803,30 @@ public class GRDBSchemaMigrator: NSObject {
             return .success(())
         }
 
+        migrator.registerMigration(.addReceivedAtTimestampToMediaGalleryItems) { tx in
+            // The gallery is ordered and sectioned by the message's
+            // receivedAtTimestamp; keeping a copy alongside the thread lets
+            // every gallery query be a range scan of one index instead of
+            // sorting all of the thread's media.
+            try tx.database.alter(table: "media_gallery_items") { table in
+                table.add(column: "receivedAtTimestamp", .integer).notNull().defaults(to: 0)
+            }
+            try tx.database.execute(sql: """
+                UPDATE media_gallery_items
+                SET receivedAtTimestamp = COALESCE(
+                    (SELECT receivedAtTimestamp FROM model_TSInteraction WHERE id = media_gallery_items.albumMessageId),
+                    0
+                )
+            """)
+            try tx.database.create(
+                index: "index_media_gallery_items_on_threadId_and_receivedAtTimestamp",
+                on: "media_gallery_items",
+                columns: ["threadId", "receivedAtTimestamp", "albumMessageId", "originalAlbumOrder"]
+            )
+
+            return .success(())
+        }
+
         // MARK: - Schema Migration Insertion Point
     }
 
@@ -183,6 +183,34 @@ public class InteractionFinder: NSObject {
         return result
     }
 
+    /// Returns the visible threads in the inbox or the archive that have
+    /// unread messages or are marked as unread.
+    public class func unreadThreadIds(isArchived: Bool, transaction: SDSAnyReadTransaction) -> [String] {
+        let sql = """
+            SELECT thread.\(threadColumn: .uniqueId)
+            FROM \(ThreadRecord.databaseTableName) AS thread
+            INNER JOIN \(ThreadAssociatedData.databaseTableName) AS associatedData
+                ON associatedData.threadUniqueId = thread.\(threadColumn: .uniqueId)
+            WHERE associatedData.isArchived = ?
+            AND thread.\(threadColumn: .shouldThreadBeVisible) = 1
+            AND (
+                associatedData.isMarkedUnread = 1
+                OR EXISTS (
+                    SELECT 1
+                    FROM \(InteractionRecord.databaseTableName) AS interaction
+                    WHERE interaction.\(interactionColumn: .threadUniqueId) = thread.\(threadColumn: .uniqueId)
+                    AND \(sqlClauseForUnreadInteractionCounts(interactionsAlias: "interaction"))
+                )
+            )
+        """
+        do {
+            return try String.fetchAll(transaction.unwrapGrdbRead.database, sql: sql, arguments: [isArchived])
+        } catch {
+            owsFailDebug("error: \(error.grdbErrorForLogging)")
+            return []
+        }
+    }
+
     public class func unreadCountInAllThreads(transaction: SDSAnyReadTransaction) -> UInt {
         do {
             let includeMutedThreads = SSKPreferences.includeMutedThreadsInBadgeCount(transaction: transaction)
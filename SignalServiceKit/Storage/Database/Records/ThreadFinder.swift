@@ -112,7 +112,7 @@ public class ThreadFinder: Dependencies {
             FROM \(ThreadRecord.databaseTableName)
             \(archivedJoin(isArchived: isArchived))
             AND \(threadColumn: .shouldThreadBeVisible) = 1
-            ORDER BY \(threadColumn: .lastInteractionRowId) DESC
+            ORDER BY \(threadColumn: .lastInteractionRowId) DESC, \(threadColumn: .id) DESC
         """
 
         do {
@@ -141,12 +141,49 @@ public class ThreadFinder: Dependencies {
             FROM \(ThreadRecord.databaseTableName)
             \(archivedJoin(isArchived: isArchived))
             AND \(threadColumn: .shouldThreadBeVisible) = 1
-            ORDER BY \(threadColumn: .lastInteractionRowId) DESC
+            ORDER BY \(threadColumn: .lastInteractionRowId) DESC, \(threadColumn: .id) DESC
         """
 
         return try String.fetchAll(transaction.unwrapGrdbRead.database, sql: sql)
     }
 
+    /// Returns up to `limit` visible thread ids, in the same order as
+    /// `visibleThreadIds(isArchived:transaction:)`, starting after
+    /// `afterThread` if it's set.
+    ///
+    /// Pages are keyed on the position of the last thread of the previous page
+    /// rather than an offset, so later pages are as cheap as the first.
+    public func visibleThreadIds(
+        isArchived: Bool,
+        excludingThreadIds: [String],
+        after afterThread: TSThread?,
+        limit: Int,
+        transaction: SDSAnyReadTransaction
+    ) throws -> [String] {
+        var sql = """
+            SELECT \(threadColumn: .uniqueId)
+            FROM \(ThreadRecord.databaseTableName)
+            \(archivedJoin(isArchived: isArchived))
+            AND \(threadColumn: .shouldThreadBeVisible) = 1
+        """
+        var arguments = StatementArguments()
+        if let afterThread {
+            guard let afterRowId = afterThread.sqliteRowId else {
+                throw OWSAssertionError("Missing rowId.")
+            }
+            sql += " AND (\(threadColumn: .lastInteractionRowId), \(threadColumn: .id)) < (?, ?)"
+            arguments += [afterThread.lastInteractionRowId, afterRowId]
+        }
+        if !excludingThreadIds.isEmpty {
+            sql += " AND \(threadColumn: .uniqueId) NOT IN (\(excludingThreadIds.map { _ in "?" }.joined(separator: ",")))"
+            arguments += StatementArguments(excludingThreadIds)
+        }
+        sql += " ORDER BY \(threadColumn: .lastInteractionRowId) DESC, \(threadColumn: .id) DESC LIMIT ?"
+        arguments += [limit]
+
+        return try String.fetchAll(transaction.unwrapGrdbRead.database, sql: sql, arguments: arguments)
+    }
+
     public func fetchContactSyncThreadRowIds(tx: SDSAnyReadTransaction) throws -> [Int64] {
         let sql = """
             SELECT \(threadColumn: .id)
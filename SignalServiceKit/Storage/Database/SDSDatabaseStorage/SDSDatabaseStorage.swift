@@ -18,6 +18,8 @@ public class SDSDatabaseStorage: NSObject {
 
     private let crossProcess = SDSCrossProcess()
 
+    private static let writeMetric = PerformanceMetrics.shared.histogram("db.write")
+
     // MARK: - Initialization / Setup
 
     public let databaseFileUrl: URL
@@ -465,7 +467,7 @@ public class SDSDatabaseStorage: NSObject {
 
         do {
             try grdbStorage.write { transaction in
-                Bench(title: benchTitle, logIfLongerThan: timeoutThreshold, logInProduction: true) {
+                Bench(title: benchTitle, metric: Self.writeMetric, logIfLongerThan: timeoutThreshold, logInProduction: true) {
                     block(transaction.asAnyWrite)
                 }
             }
@@ -426,6 +426,19 @@ public class SDSKeyValueStore: NSObject {
         }
     }
 
+    /// Reads every key and value in the collection with a single query.
+    public func allDataValuesMap(transaction: SDSAnyReadTransaction) -> [String: Data] {
+        var result = [String: Data]()
+        for pair in allPairs(transaction: transaction) {
+            guard let key = pair.key, let value = pair.value else {
+                owsFailDebug("missing key or value.")
+                continue
+            }
+            result[key] = value
+        }
+        return result
+    }
+
     private struct PairRecord: Codable, FetchableRecord, PersistableRecord {
         public let key: String?
         public let value: Data?
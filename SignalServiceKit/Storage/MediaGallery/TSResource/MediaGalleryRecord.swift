@@ -13,4 +13,7 @@ struct MediaGalleryRecord: Codable, FetchableRecord, PersistableRecord {
     let albumMessageId: Int64
     let threadId: Int64
     let originalAlbumOrder: Int
+    /// A copy of the album message's `receivedAtTimestamp`, which the gallery
+    /// is sorted by.
+    let receivedAtTimestamp: UInt64
 }
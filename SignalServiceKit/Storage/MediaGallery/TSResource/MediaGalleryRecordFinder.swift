@@ -72,7 +72,7 @@ extension MediaGalleryRecordFinder {
                 // at the boundaries, leading to the first millisecond of a month being considered part of the previous
                 // month as well. Subtract 1ms from the end timestamp to avoid this.
                 let endMillis = $0.end.ows_millisecondsSince1970 - 1
-                var clauses = ["AND \(interactionColumn: .receivedAtTimestamp) BETWEEN \(startMillis) AND \(endMillis)"]
+                var clauses = ["AND media_gallery_items.receivedAtTimestamp BETWEEN \(startMillis) AND \(endMillis)"]
                 switch filter {
                 case .gifs:
                     // Note that this isn't quite the same as -[TSAttachmentStream
@@ -126,9 +126,11 @@ extension MediaGalleryRecordFinder {
                     \(whereCondition)
             """
 
+            // Matches index_media_gallery_items_on_threadId_and_receivedAtTimestamp,
+            // so a batch costs what it returns rather than the size of the thread.
             orderClauses = """
                 ORDER BY
-                    \(interactionColumn: .receivedAtTimestamp) \(order),
+                    media_gallery_items.receivedAtTimestamp \(order),
                     media_gallery_items.albumMessageId \(order),
                     media_gallery_items.originalAlbumOrder \(order)
             """
@@ -200,7 +202,7 @@ extension MediaGalleryRecordFinder {
                                transaction: GRDBReadTransaction) -> [DatedMediaGalleryRecordId] {
         let interval = givenInterval ?? DateInterval.init(start: Date(timeIntervalSince1970: 0),
                                                           end: .distantFutureForMillisecondTimestamp)
-        let sql = Self.itemsQuery(result: "media_gallery_items.rowid, \(interactionColumnFullyQualified: .receivedAtTimestamp)",
+        let sql = Self.itemsQuery(result: "media_gallery_items.rowid, media_gallery_items.receivedAtTimestamp",
                                   in: interval,
                                   excluding: deletedAttachmentIds,
                                   order: ascending ? .ascending : .descending,
@@ -261,7 +263,7 @@ extension MediaGalleryRecordFinder {
         block: (DatedMediaGalleryRecordId) -> Void
     ) -> EnumerationCompletion {
         let sql = Self.itemsQuery(
-            result: "media_gallery_items.rowid, \(interactionColumn: .receivedAtTimestamp)",
+            result: "media_gallery_items.rowid, media_gallery_items.receivedAtTimestamp",
             in: interval,
             excluding: deletedAttachmentIds,
             order: order,
@@ -125,7 +125,8 @@ public final class MediaGalleryRecordManager: NSObject {
             attachmentId: legacyAttachmentRowId,
             albumMessageId: messageRowId,
             threadId: threadId,
-            originalAlbumOrder: originalAlbumIndex
+            originalAlbumOrder: originalAlbumIndex,
+            receivedAtTimestamp: message.receivedAtTimestamp
         )
 
         try galleryRecord.insert(transaction.database)
@@ -188,7 +189,9 @@ public final class MediaGalleryRecordManager: NSObject {
         transaction: GRDBReadTransaction
     ) throws -> ChangedAttachmentInfo {
         let timestamp: UInt64
-        if let maybeTimestamp = recentlyChangedMessageTimestampsByRowId[record.albumMessageId] {
+        if record.receivedAtTimestamp != 0 {
+            timestamp = record.receivedAtTimestamp
+        } else if let maybeTimestamp = recentlyChangedMessageTimestampsByRowId[record.albumMessageId] {
             timestamp = maybeTimestamp
         } else {
             let timestampQuery = """
@@ -954,7 +954,9 @@ public class AvatarBuilder: NSObject {
                 return nil
             }
         }
-        guard let sourceImage = UIImage(contentsOfFile: fileUrl.path) else {
+        // Downsample while decoding rather than decoding the full-size image
+        // and then resizing it.
+        guard let sourceImage = AvatarImageDecoder.decodeImage(fileUrl: fileUrl, fillPixelSize: diameterPixels) else {
             owsFailDebug("Missing or invalid sourceImage.")
             return nil
         }
@@ -984,7 +986,7 @@ public class AvatarBuilder: NSObject {
                 return nil
             }
         }
-        guard let sourceImage = UIImage(data: imageData) else {
+        guard let sourceImage = AvatarImageDecoder.decodeImage(data: imageData, fillPixelSize: diameterPixels) else {
             owsFailDebug("Missing or invalid sourceImage.")
             return nil
         }
@@ -0,0 +1,78 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import ImageIO
+
+/// Decodes avatar images with ImageIO, downsampling them while decoding.
+///
+/// Avatars are usually far larger than the cells they're shown in, and
+/// decoding one at full size just to shrink it is expensive. AvatarBuilder
+/// caches the results, keyed by the avatar's content and diameter.
+enum AvatarImageDecoder {
+
+    // Don't let ImageIO cache the full-size decoded image; we only keep the
+    // downsampled one.
+    private static let imageSourceOptions = [kCGImageSourceShouldCache: false] as CFDictionary
+
+    /// Decodes `data`, downsampling it as far as possible while still being
+    /// able to fill a `fillPixelSize` square.
+    static func decodeImage(data: Data, fillPixelSize: CGFloat) -> UIImage? {
+        guard let imageSource = CGImageSourceCreateWithData(data as CFData, imageSourceOptions) else {
+            return nil
+        }
+        return decodeImage(imageSource: imageSource, fillPixelSize: fillPixelSize)
+    }
+
+    /// Like `decodeImage(data:fillPixelSize:)`, for a file.
+    static func decodeImage(fileUrl: URL, fillPixelSize: CGFloat) -> UIImage? {
+        guard let imageSource = CGImageSourceCreateWithURL(fileUrl as CFURL, imageSourceOptions) else {
+            return nil
+        }
+        return decodeImage(imageSource: imageSource, fillPixelSize: fillPixelSize)
+    }
+
+    private static func decodeImage(imageSource: CGImageSource, fillPixelSize: CGFloat) -> UIImage? {
+        guard let (pixelWidth, pixelHeight) = pixelDimensions(imageSource: imageSource) else {
+            return nil
+        }
+        let shortSide = CGFloat(min(pixelWidth, pixelHeight))
+        let longSide = CGFloat(max(pixelWidth, pixelHeight))
+        guard shortSide > fillPixelSize else {
+            return decodeImage(imageSource: imageSource, maxPixelSize: longSide)
+        }
+        // The short side must still cover the square once downsampled.
+        let maxPixelSize = (fillPixelSize * longSide / shortSide).rounded(.up)
+        return decodeImage(imageSource: imageSource, maxPixelSize: maxPixelSize)
+    }
+
+    private static func decodeImage(imageSource: CGImageSource, maxPixelSize: CGFloat) -> UIImage? {
+        // Thumbnails (unlike CGImageSourceCreateImageAtIndex) apply the EXIF
+        // orientation, like UIImage(data:) does.
+        let options = [
+            kCGImageSourceCreateThumbnailFromImageAlways: true,
+            kCGImageSourceCreateThumbnailWithTransform: true,
+            kCGImageSourceShouldCacheImmediately: true,
+            kCGImageSourceThumbnailMaxPixelSize: max(1, Int(maxPixelSize))
+        ] as CFDictionary
+        guard let cgImage = CGImageSourceCreateThumbnailAtIndex(imageSource, 0, options) else {
+            return nil
+        }
+        return UIImage(cgImage: cgImage)
+    }
+
+    private static func pixelDimensions(imageSource: CGImageSource) -> (width: Int, height: Int)? {
+        guard
+            let properties = CGImageSourceCopyPropertiesAtIndex(imageSource, 0, nil) as? [CFString: Any],
+            let pixelWidth = properties[kCGImagePropertyPixelWidth] as? Int,
+            let pixelHeight = properties[kCGImagePropertyPixelHeight] as? Int,
+            pixelWidth > 0,
+            pixelHeight > 0
+        else {
+            return nil
+        }
+        return (pixelWidth, pixelHeight)
+    }
+}
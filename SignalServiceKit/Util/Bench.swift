@@ -9,6 +9,11 @@ import SignalCoreKit
 /// Benchmark time for async code by calling the passed in block parameter when the work
 /// is done.
 ///
+/// Every benchmark shows up as an interval in Instruments. If `metric` is given, the
+/// duration is also recorded in that histogram (see `PerformanceMetrics`). Titles can
+/// include details like IDs, but metric names should be fixed. Look the histogram up
+/// once and keep it, rather than looking it up on every call.
+///
 ///     foo(fooCompletion: (Error?) -> ()) {
 ///         BenchAsync(title: "my benchmark") { completeBenchmark in
 ///             bar { error in
@@ -21,11 +26,11 @@ import SignalCoreKit
 ///             }
 ///         }
 ///     }
-private func BenchAsync(title: String, logInProduction: Bool = false, block: (@escaping () -> Void) -> Void) {
-    let startTime = CACurrentMediaTime()
+private func BenchAsync(title: String, metric: LatencyHistogram? = nil, logInProduction: Bool = false, block: (@escaping () -> Void) -> Void) {
+    let span = PerformanceSpan(name: title, histogram: metric)
     block {
+        let timeElapsed = span.end()
         if !DebugFlags.reduceLogChatter {
-            let timeElapsed = CACurrentMediaTime() - startTime
             let formattedTime = String(format: "%0.2fms", timeElapsed * 1000)
             let logMessage = "[Bench] title: \(title), duration: \(formattedTime)"
             if logInProduction {
@@ -51,23 +56,30 @@ private func BenchAsync(title: String, logInProduction: Bool = false, block: (@e
 ///        }
 ///    }
 ///
-public func Bench<T>(title: String, logIfLongerThan intervalLimit: TimeInterval = 0, logInProduction: Bool = false, block: () throws -> T) rethrows -> T {
-    let startTime = CACurrentMediaTime()
-    let value = try block()
-    let timeElapsed = CACurrentMediaTime() - startTime
+public func Bench<T>(
+    title: String,
+    metric: LatencyHistogram? = nil,
+    logIfLongerThan intervalLimit: TimeInterval = 0,
+    logInProduction: Bool = false,
+    block: () throws -> T
+) rethrows -> T {
+    let span = PerformanceSpan(name: title, histogram: metric)
+    defer {
+        let timeElapsed = span.end()
 
-    if timeElapsed > intervalLimit {
-        if !DebugFlags.reduceLogChatter {
-            let formattedTime = String(format: "%0.2fms", timeElapsed * 1000)
-            let logMessage = "[Bench] title: \(title), duration: \(formattedTime)"
-            if logInProduction {
-                Logger.info(logMessage)
-            } else {
-                Logger.debug(logMessage)
+        if timeElapsed > intervalLimit {
+            if !DebugFlags.reduceLogChatter {
+                let formattedTime = String(format: "%0.2fms", timeElapsed * 1000)
+                let logMessage = "[Bench] title: \(title), duration: \(formattedTime)"
+                if logInProduction {
+                    Logger.info(logMessage)
+                } else {
+                    Logger.debug(logMessage)
+                }
             }
         }
     }
-    return value
+    return try block()
 }
 
 public protocol MemorySampler {
@@ -130,8 +142,8 @@ public func Bench(title: String,
 ///    [BenchManager startEventWithTitle:"message sending" eventId:message.id]
 ///    ...
 ///    [BenchManager completeEventWithEventId:message.id]
-public func BenchEventStart(title: String, eventId: BenchmarkEventId, logInProduction: Bool = false) {
-    BenchAsync(title: title, logInProduction: logInProduction) { finish in
+public func BenchEventStart(title: String, metric: LatencyHistogram? = nil, eventId: BenchmarkEventId, logInProduction: Bool = false) {
+    BenchAsync(title: title, metric: metric, logInProduction: logInProduction) { finish in
         eventQueue.sync {
             runningEvents[eventId] = Event(title: title, eventId: eventId, completion: finish)
         }
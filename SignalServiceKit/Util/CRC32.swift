@@ -18,6 +18,9 @@ import zlib
 ///
 /// let checksum: UInt32 = crc.value
 /// ```
+///
+/// For hot paths, `append(_:)` updates the checksum in place from raw
+/// bytes, and `checksum(of:)` checksums large buffers on several threads.
 public struct CRC32 {
     private var rawValue: CUnsignedLong
 
@@ -32,10 +35,73 @@ public struct CRC32 {
     }
 
     public func update(with data: Data) -> CRC32 {
-        let newRawValue = data.withUnsafeBytes { bytes -> CUnsignedLong in
-            let pointerForC = bytes.baseAddress?.assumingMemoryBound(to: UInt8.self)
-            return crc32(self.rawValue, pointerForC, UInt32(bytes.count))
+        var result = self
+        result.append(data)
+        return result
+    }
+
+    public mutating func append(_ data: Data) {
+        data.withUnsafeBytes { append($0) }
+    }
+
+    public mutating func append(_ bytes: UnsafeRawBufferPointer) {
+        guard var baseAddress = bytes.baseAddress?.assumingMemoryBound(to: UInt8.self) else {
+            return
         }
-        return CRC32(rawValue: newRawValue)
+        // zlib takes a 32-bit length.
+        var remainingCount = bytes.count
+        while remainingCount > 0 {
+            let count = min(remainingCount, Int(UInt32.max))
+            rawValue = crc32(rawValue, baseAddress, UInt32(count))
+            baseAddress += count
+            remainingCount -= count
+        }
+    }
+
+    /// The checksum of the bytes checksummed by `self` followed by the
+    /// `length` bytes checksummed by `next`.
+    ///
+    /// Lets separately computed checksums of consecutive pieces of data be
+    /// combined without reading the data again.
+    public func combined(with next: CRC32, length: Int) -> CRC32 {
+        return CRC32(rawValue: crc32_combine(rawValue, next.rawValue, off_t(length)))
+    }
+
+    // MARK: - Bulk
+
+    /// Buffers smaller than this are checksummed on the calling thread; the
+    /// overhead of dispatching outweighs the parallelism.
+    public static let defaultPieceSize = 1024 * 1024
+
+    /// Checksums `bytes`, splitting it into pieces of `pieceSize` bytes that
+    /// are checksummed concurrently and then combined.
+    public static func checksum(of bytes: UnsafeRawBufferPointer, pieceSize: Int = defaultPieceSize) -> CRC32 {
+        owsAssertDebug(pieceSize > 0)
+        let pieceCount = pieceSize > 0 ? (bytes.count + pieceSize - 1) / pieceSize : 0
+        guard pieceCount > 1 else {
+            var result = CRC32()
+            result.append(bytes)
+            return result
+        }
+
+        var pieceChecksums = [CRC32](repeating: CRC32(), count: pieceCount)
+        pieceChecksums.withUnsafeMutableBufferPointer { pieceChecksums in
+            DispatchQueue.concurrentPerform(iterations: pieceCount) { index in
+                let start = index * pieceSize
+                let end = min(start + pieceSize, bytes.count)
+                pieceChecksums[index].append(UnsafeRawBufferPointer(rebasing: bytes[start..<end]))
+            }
+        }
+
+        var result = pieceChecksums[0]
+        for index in 1..<pieceCount {
+            let length = min(pieceSize, bytes.count - index * pieceSize)
+            result = result.combined(with: pieceChecksums[index], length: length)
+        }
+        return result
+    }
+
+    public static func checksum(of data: Data, pieceSize: Int = defaultPieceSize) -> CRC32 {
+        return data.withUnsafeBytes { checksum(of: $0, pieceSize: pieceSize) }
     }
 }
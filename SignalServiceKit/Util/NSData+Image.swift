@@ -411,23 +411,12 @@ extension Data {
     ///   `false` if the contents are a still PNG.
     ///   `nil` if the contents are invalid.
     func isAnimatedPngData() -> NSNumber? {
-        let actl = "acTL".data(using: .ascii)
-        let idat = "IDAT".data(using: .ascii)
-
         do {
-            let chunker = try PngChunker(data: self as Data)
-            while let chunk = try chunker.next() {
-                if chunk.type == actl {
-                    return NSNumber(value: true)
-                } else if chunk.type == idat {
-                    return NSNumber(value: false)
-                }
-            }
+            return NSNumber(value: try PngChunker.isAnimated(data: self as Data))
         } catch {
             Logger.warn("Error: \(error)")
+            return nil
         }
-
-        return nil
     }
 
     // MARK: - Sticker Like Properties
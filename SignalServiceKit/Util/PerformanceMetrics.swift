@@ -0,0 +1,345 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import os
+import SignalCoreKit
+
+/// Counters, gauges and latency histograms, for following how the app
+/// performs in the field.
+///
+/// Metrics are looked up by name, and the same name always returns the same
+/// metric; hot paths can look a metric up once and keep it. Recording takes a
+/// lock and a few arithmetic operations, which is cheap enough to do for every
+/// message or database transaction.
+///
+///     PerformanceMetrics.shared.measure("db.write") {
+///         doTheWrite()
+///     }
+///
+///     PerformanceMetrics.shared.counter("messageProcessor.envelopes").add(batch.count)
+///
+/// Or in objc
+///
+///     PerformanceSpan *span = [PerformanceMetrics.shared startSpan:@"my.metric"];
+///     ...
+///     [span end];
+///
+/// Spans also appear as intervals in Instruments' "Points of Interest". Once
+/// `startLoggingSnapshots()` has been called, a summary of everything recorded
+/// is written to the debug log every few minutes.
+@objc
+public final class PerformanceMetrics: NSObject {
+
+    @objc
+    public static let shared = PerformanceMetrics()
+
+    /// Metric names should be fixed strings, not titles with IDs or
+    /// timestamps in them. Past this many, new metrics aren't registered.
+    static let maximumMetricCount = 256
+
+    static let snapshotInterval: TimeInterval = 5 * kMinuteInterval
+
+    fileprivate static let signpostLog = OSLog(subsystem: "org.signal.metrics", category: .pointsOfInterest)
+
+    private let lock = UnfairLock()
+    private var counters = [String: Counter]()
+    private var gauges = [String: Gauge]()
+    private var histograms = [String: LatencyHistogram]()
+    private var snapshotTimer: DispatchSourceTimer?
+
+    // MARK: - Registry
+
+    public func counter(_ name: String) -> Counter {
+        return metric(named: name, in: \.counters, make: Counter.init)
+    }
+
+    public func gauge(_ name: String) -> Gauge {
+        return metric(named: name, in: \.gauges, make: Gauge.init)
+    }
+
+    public func histogram(_ name: String) -> LatencyHistogram {
+        return metric(named: name, in: \.histograms, make: LatencyHistogram.init)
+    }
+
+    private func metric<T>(
+        named name: String,
+        in keyPath: ReferenceWritableKeyPath<PerformanceMetrics, [String: T]>,
+        make: () -> T
+    ) -> T {
+        return lock.withLock {
+            if let metric = self[keyPath: keyPath][name] {
+                return metric
+            }
+            let metric = make()
+            guard counters.count + gauges.count + histograms.count < Self.maximumMetricCount else {
+                owsFailDebug("Too many metrics, not registering \(name)")
+                return metric
+            }
+            self[keyPath: keyPath][name] = metric
+            return metric
+        }
+    }
+
+    // MARK: - Spans
+
+    /// Runs `block`, recording how long it took in the histogram `name`.
+    public func measure<T>(_ name: String, block: () throws -> T) rethrows -> T {
+        let span = startSpan(name)
+        defer { span.end() }
+        return try block()
+    }
+
+    /// Starts timing something that will be recorded in the histogram `name`
+    /// when the span ends.
+    @objc
+    public func startSpan(_ name: String) -> PerformanceSpan {
+        return PerformanceSpan(name: name, histogram: histogram(name))
+    }
+
+    // MARK: - Snapshots
+
+    /// Starts writing a summary of the metrics to the debug log every
+    /// `snapshotInterval`. Does nothing if it's already started.
+    public func startLoggingSnapshots() {
+        lock.withLock {
+            guard snapshotTimer == nil else {
+                return
+            }
+            let timer = DispatchSource.makeTimerSource(queue: .global(qos: .utility))
+            timer.schedule(deadline: .now() + Self.snapshotInterval, repeating: Self.snapshotInterval)
+            timer.setEventHandler { [weak self] in
+                self?.logSnapshot()
+            }
+            timer.resume()
+            snapshotTimer = timer
+        }
+    }
+
+    /// Writes the metrics recorded since the last snapshot to the debug log,
+    /// and starts counting afresh.
+    public func logSnapshot() {
+        let (counters, gauges, histograms) = lock.withLock { (self.counters, self.gauges, self.histograms) }
+
+        for (name, histogram) in histograms.sorted(by: { $0.key < $1.key }) {
+            let snapshot = histogram.takeSnapshot()
+            guard snapshot.count > 0 else {
+                continue
+            }
+            Logger.info("[Metrics] \(name): \(snapshot)")
+        }
+        for (name, counter) in counters.sorted(by: { $0.key < $1.key }) {
+            let count = counter.takeCount()
+            guard count != 0 else {
+                continue
+            }
+            Logger.info("[Metrics] \(name): \(count)")
+        }
+        for (name, gauge) in gauges.sorted(by: { $0.key < $1.key }) {
+            guard let value = gauge.value else {
+                continue
+            }
+            Logger.info("[Metrics] \(name): \(value)")
+        }
+    }
+
+    // MARK: - Metrics
+
+    public final class Counter {
+        private let lock = UnfairLock()
+        private var count = 0
+
+        public func increment() {
+            add(1)
+        }
+
+        public func add(_ delta: Int) {
+            lock.withLock { count += delta }
+        }
+
+        /// Returns the count, and resets it to zero.
+        func takeCount() -> Int {
+            return lock.withLock {
+                defer { count = 0 }
+                return count
+            }
+        }
+    }
+
+    public final class Gauge {
+        private let lock = UnfairLock()
+        private var _value: Double?
+
+        public var value: Double? {
+            lock.withLock { _value }
+        }
+
+        public func set(_ value: Double) {
+            lock.withLock { _value = value }
+        }
+    }
+}
+
+// MARK: -
+
+/// Records durations in buckets whose widths grow with their values, like
+/// HdrHistogram, so that percentiles can be read off without storing every
+/// sample.
+///
+/// Durations are recorded in whole microseconds. Below 16µs each value has its
+/// own bucket; above that, each power of two is split into 16 buckets, so a
+/// percentile is at most 1/16th more than the real value. Durations longer
+/// than about 50 days are recorded as 50 days.
+public final class LatencyHistogram {
+    private static let subBucketBits = 4
+    private static let subBucketCount = 1 << subBucketBits
+    private static let maximumExponent = 41
+    static let bucketCount = (maximumExponent - subBucketBits + 2) * subBucketCount
+    private static let maximumValue: UInt64 = (1 << (maximumExponent + 1)) - 1
+
+    private let lock = UnfairLock()
+    private var counts = [UInt64](repeating: 0, count: LatencyHistogram.bucketCount)
+    private var count: UInt64 = 0
+    private var totalMicroseconds: UInt64 = 0
+    private var maximumMicroseconds: UInt64 = 0
+
+    public init() {}
+
+    public func record(_ duration: TimeInterval) {
+        let microseconds = UInt64(min(Double(Self.maximumValue), max(0, (duration * 1_000_000).rounded())))
+        let index = Self.bucketIndex(for: microseconds)
+        lock.withLock {
+            counts[index] += 1
+            count += 1
+            totalMicroseconds &+= microseconds
+            maximumMicroseconds = max(maximumMicroseconds, microseconds)
+        }
+    }
+
+    static func bucketIndex(for value: UInt64) -> Int {
+        guard value >= subBucketCount else {
+            return Int(value)
+        }
+        let exponent = UInt64.bitWidth - 1 - value.leadingZeroBitCount
+        let subBucket = Int(value >> (exponent - subBucketBits)) & (subBucketCount - 1)
+        return (exponent - subBucketBits + 1) * subBucketCount + subBucket
+    }
+
+    /// The largest value that's recorded in bucket `index`.
+    static func highestValue(inBucket index: Int) -> UInt64 {
+        guard index >= subBucketCount else {
+            return UInt64(index)
+        }
+        let exponent = index / subBucketCount + subBucketBits - 1
+        let subBucket = index % subBucketCount
+        let lowestValue = UInt64(subBucketCount + subBucket) << (exponent - subBucketBits)
+        return lowestValue + (1 << (exponent - subBucketBits)) - 1
+    }
+
+    public struct Snapshot: CustomStringConvertible {
+        fileprivate let counts: [UInt64]
+        public let count: UInt64
+        public let total: TimeInterval
+        public let maximum: TimeInterval
+
+        /// The duration that `fraction` of the recorded durations were no
+        /// longer than, e.g. 0.99 for the 99th percentile.
+        public func percentile(_ fraction: Double) -> TimeInterval {
+            guard count > 0 else {
+                return 0
+            }
+            let target = max(1, UInt64((fraction * Double(count)).rounded(.up)))
+            var seen: UInt64 = 0
+            for (index, bucketCount) in counts.enumerated() {
+                seen += bucketCount
+                if seen >= target {
+                    // Never report more than the real maximum.
+                    return min(maximum, TimeInterval(LatencyHistogram.highestValue(inBucket: index)) / 1_000_000)
+                }
+            }
+            return maximum
+        }
+
+        public var description: String {
+            func format(_ duration: TimeInterval) -> String {
+                return String(format: "%.2fms", duration * 1000)
+            }
+            return (
+                "count: \(count), p50: \(format(percentile(0.5))), p90: \(format(percentile(0.9))), "
+                + "p99: \(format(percentile(0.99))), max: \(format(maximum))"
+            )
+        }
+    }
+
+    public func snapshot() -> Snapshot {
+        return lock.withLock { makeSnapshot() }
+    }
+
+    /// Returns a snapshot, and clears the histogram.
+    func takeSnapshot() -> Snapshot {
+        return lock.withLock {
+            defer {
+                counts = [UInt64](repeating: 0, count: Self.bucketCount)
+                count = 0
+                totalMicroseconds = 0
+                maximumMicroseconds = 0
+            }
+            return makeSnapshot()
+        }
+    }
+
+    private func makeSnapshot() -> Snapshot {
+        return Snapshot(
+            counts: counts,
+            count: count,
+            total: TimeInterval(totalMicroseconds) / 1_000_000,
+            maximum: TimeInterval(maximumMicroseconds) / 1_000_000
+        )
+    }
+}
+
+// MARK: -
+
+/// Times something from when it's created until `end()` is called.
+@objc
+public final class PerformanceSpan: NSObject {
+    private let name: String
+    private let histogram: LatencyHistogram?
+    private let signpostID: OSSignpostID?
+    private let startTime = CACurrentMediaTime()
+    private var hasEnded = false
+
+    /// - Parameter histogram: Where to record the duration, if anywhere.
+    init(name: String, histogram: LatencyHistogram?) {
+        self.name = name
+        self.histogram = histogram
+        let log = PerformanceMetrics.signpostLog
+        if log.signpostsEnabled {
+            let signpostID = OSSignpostID(log: log)
+            os_signpost(.begin, log: log, name: "Span", signpostID: signpostID, "%{public}s", name)
+            self.signpostID = signpostID
+        } else {
+            self.signpostID = nil
+        }
+        super.init()
+    }
+
+    /// Records the span's duration, and returns it.
+    @objc
+    @discardableResult
+    public func end() -> TimeInterval {
+        let duration = CACurrentMediaTime() - startTime
+        guard !hasEnded else {
+            owsFailDebug("Span \(name) already ended.")
+            return duration
+        }
+        hasEnded = true
+        histogram?.record(duration)
+        if let signpostID {
+            os_signpost(.end, log: PerformanceMetrics.signpostLog, name: "Span", signpostID: signpostID)
+        }
+        return duration
+    }
+}
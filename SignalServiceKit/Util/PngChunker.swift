@@ -55,7 +55,7 @@ public class PngChunker {
             throw PngChunkerError.fileDoesNotStartWithPngSignature
         }
         pngData = data
-        cursor = Self.pngSignature.count
+        cursor = data.startIndex + Self.pngSignature.count
     }
 
     /// Get the next PNG chunk.
@@ -64,57 +64,90 @@ public class PngChunker {
     /// - Throws: `PngChunkerError.invalidChunkChecksum` if a chunk's checksum is invalid.
     /// - Throws: `PngChunkerError.endedUnexpectedly` if a chunk's length is longer than the remaining data available, or if the first chunk's length is too short.
     public func next() throws -> Chunk? {
-        guard var cursor = cursor, cursor < pngData.count else {
+        return try next(verifyingChecksum: { _ in true })
+    }
+
+    /// Get the next PNG chunk, skipping the checksum for chunks whose type
+    /// doesn't pass `shouldVerifyChecksum`.
+    ///
+    /// The returned chunk's fields are slices of the data the chunker was
+    /// created with, so no chunk bytes are copied. Checksums cover the type
+    /// and data, which are adjacent, so they're computed in a single pass.
+    private func next(verifyingChecksum shouldVerifyChecksum: (Data) -> Bool) throws -> Chunk? {
+        guard let chunkStart = cursor, chunkStart < pngData.endIndex else {
             return nil
         }
 
         // Checks that there's enough space for the length (4 bytes) and the type (4 bytes).
-        guard cursor + 8 <= pngData.count else {
+        let typeStart = chunkStart + 4
+        let dataStart = typeStart + 4
+        guard dataStart <= pngData.endIndex else {
             self.cursor = nil
             throw PngChunkerError.endedUnexpectedly
         }
 
-        let lengthBytes = pngData[cursor..<(cursor + 4)]
-        let length = try lengthBytes.asPngUInt32()
-        cursor += 4
-
-        var expectedCrc = CRC32()
+        let length = pngData.pngUInt32(at: chunkStart)
 
-        let type = pngData[cursor..<(cursor + 4)]
+        let type = pngData[typeStart..<dataStart]
         guard type.isValidPngType else {
             self.cursor = nil
             throw PngChunkerError.invalidChunkType
         }
-        expectedCrc = expectedCrc.update(with: type)
-        cursor += 4
 
         // Checks that there's enough space for the data (N bytes) and the CRC (4 bytes).
-        let lengthAsInt = Int(length)
-        guard cursor + lengthAsInt + 4 <= pngData.count else {
+        let (dataEnd, dataEndOverflow) = dataStart.addingReportingOverflow(Int(length))
+        guard !dataEndOverflow, dataEnd <= pngData.endIndex - 4 else {
             self.cursor = nil
             throw PngChunkerError.endedUnexpectedly
         }
-        let data = pngData[cursor..<(cursor + lengthAsInt)]
-        expectedCrc = expectedCrc.update(with: data)
-        cursor += lengthAsInt
+        let chunkEnd = dataEnd + 4
+
+        if shouldVerifyChecksum(type) {
+            // Image data chunks can be megabytes long, so they're checksummed in
+            // parallel pieces.
+            let expectedCrc = CRC32.checksum(of: pngData[typeStart..<dataEnd])
+            guard pngData.pngUInt32(at: dataEnd) == expectedCrc.value else {
+                self.cursor = nil
+                throw PngChunkerError.invalidChunkChecksum
+            }
+        }
 
-        let crcBytes = pngData[cursor..<(cursor + 4)]
-        let actualCrc = try crcBytes.asPngUInt32()
-        cursor += 4
+        self.cursor = chunkEnd
 
-        guard actualCrc == expectedCrc.value else {
-            self.cursor = nil
-            throw PngChunkerError.invalidChunkChecksum
-        }
+        return Chunk(bytes: pngData[chunkStart..<chunkEnd])
+    }
 
-        self.cursor = cursor
+    // MARK: - Animation
 
-        return Chunk(
-            lengthBytes: lengthBytes,
-            type: type,
-            data: data,
-            crcBytes: crcBytes
-        )
+    private static let actlType = "acTL".data(using: .ascii)!
+    private static let idatType = "IDAT".data(using: .ascii)!
+
+    /// Whether a PNG is animated, without reading any of its image data.
+    ///
+    /// Stops at the first `acTL` or `IDAT` chunk, since [the APNG spec][0]
+    /// requires `acTL` to come before any `IDAT`. The checksum of the `IDAT`
+    /// chunk isn't verified, so the cost doesn't grow with the image's size.
+    /// The first chunk doesn't have to be `IHDR`, so nonstandard PNGs (like
+    /// Apple's CgBI variant, which starts with a `CgBI` chunk) are still
+    /// classified.
+    ///
+    /// [0]: https://wiki.mozilla.org/APNG_Specification#Structure
+    ///
+    /// - Throws: Any error thrown by `init(data:)` or `next()`.
+    /// - Throws: `PngChunkerError.endedUnexpectedly` if there's no `acTL` or `IDAT` chunk.
+    public static func isAnimated(data: Data) throws -> Bool {
+        let chunker = try PngChunker(data: data)
+        while let chunk = try chunker.next(verifyingChecksum: { $0 != idatType }) {
+            switch chunk.type {
+            case actlType:
+                return true
+            case idatType:
+                return false
+            default:
+                continue
+            }
+        }
+        throw PngChunkerError.endedUnexpectedly
     }
 
     // MARK: - Chunker errors
@@ -144,36 +177,37 @@ public class PngChunker {
     ///
     /// [0]: https://www.w3.org/TR/2003/REC-PNG-20031110/#5Chunk-layout
     public struct Chunk {
+        /// The whole chunk, as a slice of the chunker's data.
+        private let bytes: Data
+
         /// The chunk data's length, encoded as a PNG 32-bit big endian number.
-        public let lengthBytes: Data
+        public var lengthBytes: Data { bytes.prefix(4) }
 
         /// The chunk's type, as raw data.
         ///
         /// You may wish to convert this to a string. This is just a normal ASCII conversion:
         ///
         ///     let typeString = String(data: myChunk.type, encoding: .ascii)
-        public let type: Data
+        public var type: Data { bytes.dropFirst(4).prefix(4) }
 
         /// The chunk's data.
-        public let data: Data
+        public var data: Data { bytes.dropFirst(8).dropLast(4) }
 
         /// The chunk's CRC32 code, encoded as a PNG 32-bit big endian number.
-        public let crcBytes: Data
+        public var crcBytes: Data { bytes.suffix(4) }
 
-        fileprivate init(lengthBytes: Data, type: Data, data: Data, crcBytes: Data) {
-            self.lengthBytes = lengthBytes
-            self.type = type
-            self.data = data
-            self.crcBytes = crcBytes
+        fileprivate init(bytes: Data) {
+            self.bytes = bytes
         }
 
         /// Get all the bytes for this chunk.
         ///
         /// Includes all four sections: the length, type, data, and checksum.
+        /// Chunks are contiguous in the PNG, so this doesn't copy anything.
         ///
         /// - Returns: The full chunk in bytes.
         public func allBytes() -> Data {
-            lengthBytes + type + data + crcBytes
+            bytes
         }
     }
 }
@@ -181,13 +215,13 @@ public class PngChunker {
 // MARK: - Extensions
 
 extension Data {
-    func asPngUInt32() throws -> UInt32 {
-        owsAssert(count == 4)
-        var result: UInt32 = 0
-        for (i, byte) in reversed().enumerated() {
-            result += UInt32(byte) * (1 << (8 * i))
-        }
-        return result
+    /// Reads a PNG 32-bit big endian number from the 4 bytes at `index`,
+    /// which the caller must have checked are in bounds.
+    fileprivate func pngUInt32(at index: Index) -> UInt32 {
+        return (UInt32(self[index]) << 24)
+            | (UInt32(self[index + 1]) << 16)
+            | (UInt32(self[index + 2]) << 8)
+            | UInt32(self[index + 3])
     }
 
     var isValidPngType: Bool {
@@ -188,9 +188,10 @@ public class ReadyFlag: NSObject {
         let didBecomeReadyAsyncTasks = ReadyTask.sort(tasksToPerform.didBecomeReadyAsyncTasks)
 
         // We bench the blocks individually and as a group.
-        BenchManager.bench(title: self.name + ".willBecomeReady group",
-                           logIfLongerThan: Self.groupLogDuration,
-                           logInProduction: true) {
+        Bench(title: self.name + ".willBecomeReady group",
+              metric: PerformanceMetrics.shared.histogram(self.name + ".willBecomeReady"),
+              logIfLongerThan: Self.groupLogDuration,
+              logInProduction: true) {
             for task in willBecomeReadyTasks {
                 BenchManager.bench(title: self.name + ".willBecomeReady " + task.displayLabel,
                                    logIfLongerThan: Self.blockLogDuration,
@@ -202,9 +203,10 @@ public class ReadyFlag: NSObject {
             }
         }
 
-        BenchManager.bench(title: self.name + ".didBecomeReady group",
-                           logIfLongerThan: Self.groupLogDuration,
-                           logInProduction: true) {
+        Bench(title: self.name + ".didBecomeReady group",
+              metric: PerformanceMetrics.shared.histogram(self.name + ".didBecomeReady"),
+              logIfLongerThan: Self.groupLogDuration,
+              logInProduction: true) {
             for task in didBecomeReadySyncTasks {
                 BenchManager.bench(title: self.name + ".didBecomeReady " + task.displayLabel,
                                    logIfLongerThan: Self.blockLogDuration,
@@ -0,0 +1,83 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import LibSignalClient
+import XCTest
+
+@testable import SignalServiceKit
+
+class ComparableDisplayNameTest: XCTestCase {
+    private let config = DisplayName.ComparableValue.Config(
+        displayNameConfig: DisplayName.Config(shouldUseSystemContactNicknames: false),
+        shouldSortByGivenName: true
+    )
+
+    private func comparableName(_ displayName: DisplayName) -> ComparableDisplayName {
+        return ComparableDisplayName(
+            address: SignalServiceAddress(Aci.randomForTesting()),
+            displayName: displayName,
+            config: config
+        )
+    }
+
+    private func profileName(_ givenName: String, _ familyName: String? = nil) -> DisplayName {
+        var nameComponents = PersonNameComponents()
+        nameComponents.givenName = givenName
+        nameComponents.familyName = familyName
+        return .profileName(nameComponents)
+    }
+
+    private func assertSortMatchesLocalizedComparison(_ names: [String], file: StaticString = #file, line: UInt = #line) {
+        let sortedNames = names.map { comparableName(profileName($0)) }.sorted(by: <).map { $0.resolvedValue() }
+        let expectedNames = names.sorted { $0.localizedCaseInsensitiveCompare($1) == .orderedAscending }
+        XCTAssertEqual(sortedNames, expectedNames, file: file, line: line)
+    }
+
+    func testSortMatchesLocalizedComparison() {
+        assertSortMatchesLocalizedComparison(["zoe", "Adam", "émile", "Eli", "bea", "Ana", "Zach", "adele"])
+    }
+
+    func testNonLatinSortMatchesLocalizedComparison() {
+        // Letters that sort after "z" in some locales, or that don't fold to a
+        // Latin letter at all.
+        assertSortMatchesLocalizedComparison(["Örjan", "Åsa", "Ärla", "Zara", "Oskar", "Anna"])
+        assertSortMatchesLocalizedComparison(["Øystein", "Æsa", "Straße", "Łukasz", "Lars", "Strand", "Olav"])
+        assertSortMatchesLocalizedComparison(["Мария", "Алексей", "Борис", "мирон"])
+        assertSortMatchesLocalizedComparison(["山田", "佐藤", "鈴木", "たなか", "김민수", "이지은"])
+        assertSortMatchesLocalizedComparison(["محمد", "أحمد", "Ahmed", "יוסף", "David"])
+    }
+
+    func testCollationIndexSortMatchesComparison() {
+        // A small key spacing makes the index renumber often.
+        let collationIndex = DisplayNameCollationIndex(keySpacing: 2)
+        let nameSets = [
+            ["zoe", "Adam", "émile", "Eli", "bea", "Ana", "Zach", "adele", "anna", "Anna", "ANNA"],
+            ["Örjan", "Åsa", "Ärla", "Zara", "Oskar", "Anna", "Øystein", "Æsa", "Straße", "Łukasz"],
+            ["Мария", "Алексей", "山田", "佐藤", "김민수", "محمد", "יוסף", "David", "adam"],
+        ]
+        for names in nameSets {
+            let comparableNames = names.map { comparableName(profileName($0)) } + [
+                comparableName(.unknown),
+                comparableName(.phoneNumber(E164("+13135550100")!)),
+            ]
+            // Sort twice so the second sort uses keys from the first.
+            for _ in 0..<2 {
+                XCTAssertEqual(
+                    ComparableDisplayName.sorted(comparableNames.shuffled(), collationIndex: collationIndex).map { $0.address },
+                    comparableNames.sorted(by: <).map { $0.address }
+                )
+            }
+        }
+    }
+
+    func testKindsSortInOrder() {
+        let unknown = comparableName(.unknown)
+        let phoneNumber = comparableName(.phoneNumber(E164("+13135550100")!))
+        let name = comparableName(profileName("Zed"))
+        XCTAssertEqual([unknown, phoneNumber, name].sorted(by: <).map { $0.displayName.hasKnownValue }, [true, true, false])
+        XCTAssertTrue(name < phoneNumber)
+        XCTAssertTrue(phoneNumber < unknown)
+    }
+}
@@ -0,0 +1,82 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Contacts
+import XCTest
+
+@testable import SignalServiceKit
+
+class FetchedSystemContactsTest: XCTestCase {
+    private let phoneNumberUtil = PhoneNumberUtil(swiftValues: PhoneNumberUtilSwiftValues())
+
+    private func buildSystemContact(_ phoneNumbers: [String]) -> SystemContact {
+        let cnContact = CNMutableContact()
+        cnContact.givenName = "Alice"
+        cnContact.phoneNumbers = phoneNumbers.map {
+            CNLabeledValue(label: CNLabelPhoneNumberMobile, value: CNPhoneNumber(stringValue: $0))
+        }
+        return SystemContact(cnContact: cnContact)
+    }
+
+    private func phoneNumbers(_ fetchedSystemContacts: FetchedSystemContacts) -> Set<String> {
+        return Set(fetchedSystemContacts.phoneNumberToContactRef.keys.map { $0.rawValue.stringValue })
+    }
+
+    func testIncrementalParseMatchesFullParse() {
+        let systemContacts = [
+            buildSystemContact(["+1 (313) 555-0101"]),
+            buildSystemContact(["313-555-0102", "+44 20 7946 0103"]),
+            buildSystemContact(["(313) 555-0100"]),
+        ]
+        let priorFetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100"
+        )
+        XCTAssertEqual(phoneNumbers(priorFetchedSystemContacts), ["+13135550101", "+13135550102", "+442079460103"])
+
+        var editedContacts = systemContacts
+        editedContacts[0] = buildSystemContact(["+1 (313) 555-0104"])
+
+        let fullFetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            editedContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100"
+        )
+        let incrementalFetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            editedContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100",
+            priorFetchedSystemContacts: priorFetchedSystemContacts
+        )
+        XCTAssertEqual(phoneNumbers(incrementalFetchedSystemContacts), ["+13135550104", "+13135550102", "+442079460103"])
+        XCTAssertEqual(phoneNumbers(incrementalFetchedSystemContacts), phoneNumbers(fullFetchedSystemContacts))
+        XCTAssertEqual(
+            Set(incrementalFetchedSystemContacts.cnContactIdToContact.keys),
+            Set(fullFetchedSystemContacts.cnContactIdToContact.keys)
+        )
+    }
+
+    func testLocalNumberChangeInvalidatesPriorResults() {
+        let systemContacts = [
+            buildSystemContact(["(313) 555-0100"]),
+            buildSystemContact(["(313) 555-0101"]),
+        ]
+        let priorFetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100"
+        )
+        XCTAssertEqual(phoneNumbers(priorFetchedSystemContacts), ["+13135550101"])
+
+        let fetchedSystemContacts = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550101",
+            priorFetchedSystemContacts: priorFetchedSystemContacts
+        )
+        XCTAssertEqual(phoneNumbers(fetchedSystemContacts), ["+13135550100"])
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Contacts
+import XCTest
+
+@testable import SignalServiceKit
+
+class ParsedPhoneNumberCacheTest: SSKBaseTestSwift {
+    private let keyValueStore = SDSKeyValueStore(collection: "ParsedPhoneNumberCacheTest")
+
+    private func load(localPhoneNumber: String?, regionCode: String = "US") -> ParsedPhoneNumberCache {
+        return databaseStorage.read { tx in
+            ParsedPhoneNumberCache.load(
+                localPhoneNumber: localPhoneNumber,
+                regionCode: regionCode,
+                keyValueStore: keyValueStore,
+                tx: tx
+            )
+        }
+    }
+
+    func testRoundTrip() {
+        let cache = load(localPhoneNumber: "+13135550100")
+        XCTAssertNil(cache.phoneNumbers(for: "555-0101"))
+        cache.setPhoneNumbers([E164("+13135550101")!], for: "555-0101")
+        cache.setPhoneNumbers([], for: "not a number")
+        write { cache.saveIfNeeded(keyValueStore: keyValueStore, tx: $0) }
+
+        let reloadedCache = load(localPhoneNumber: "+13135550100")
+        XCTAssertEqual(reloadedCache.phoneNumbers(for: "555-0101"), [E164("+13135550101")!])
+        XCTAssertEqual(reloadedCache.phoneNumbers(for: "not a number"), [])
+        XCTAssertNil(reloadedCache.phoneNumbers(for: "555-0102"))
+        XCTAssertEqual(reloadedCache.hitCount, 2)
+        XCTAssertEqual(reloadedCache.missCount, 1)
+    }
+
+    func testSavesOnlyChanges() {
+        let cache = load(localPhoneNumber: "+13135550100")
+        XCTAssertTrue(cache.hasUnsavedChanges)
+        cache.setPhoneNumbers([E164("+13135550101")!], for: "555-0101")
+        cache.setPhoneNumbers([E164("+13135550102")!], for: "555-0102")
+        write { cache.saveIfNeeded(keyValueStore: keyValueStore, tx: $0) }
+        XCTAssertFalse(cache.hasUnsavedChanges)
+
+        // Parsing the same number to the same result isn't a change.
+        let reloadedCache = load(localPhoneNumber: "+13135550100")
+        XCTAssertFalse(reloadedCache.hasUnsavedChanges)
+        reloadedCache.setPhoneNumbers([E164("+13135550101")!], for: "555-0101")
+        XCTAssertFalse(reloadedCache.hasUnsavedChanges)
+
+        reloadedCache.setPhoneNumbers([E164("+13135550103")!], for: "555-0103")
+        reloadedCache.removeAll(except: ["555-0101", "555-0103"])
+        XCTAssertTrue(reloadedCache.hasUnsavedChanges)
+        write { reloadedCache.saveIfNeeded(keyValueStore: keyValueStore, tx: $0) }
+
+        let finalCache = load(localPhoneNumber: "+13135550100")
+        XCTAssertEqual(finalCache.count, 2)
+        XCTAssertEqual(finalCache.phoneNumbers(for: "555-0101"), [E164("+13135550101")!])
+        XCTAssertEqual(finalCache.phoneNumbers(for: "555-0103"), [E164("+13135550103")!])
+        XCTAssertNil(finalCache.phoneNumbers(for: "555-0102"))
+    }
+
+    func testInvalidation() {
+        let cache = load(localPhoneNumber: "+13135550100")
+        cache.setPhoneNumbers([E164("+13135550101")!], for: "555-0101")
+        write { cache.saveIfNeeded(keyValueStore: keyValueStore, tx: $0) }
+
+        XCTAssertEqual(load(localPhoneNumber: "+13135550100", regionCode: "CA").count, 0)
+        XCTAssertEqual(load(localPhoneNumber: "+447700900000").count, 0)
+        XCTAssertEqual(load(localPhoneNumber: "+13135550100").count, 1)
+    }
+
+    func testParseContactsUsesCache() {
+        let phoneNumberUtil = PhoneNumberUtil(swiftValues: PhoneNumberUtilSwiftValues())
+        let systemContacts: [SystemContact] = ["555-0101", "(313) 555-0102"].map {
+            let cnContact = CNMutableContact()
+            cnContact.phoneNumbers = [CNLabeledValue(label: nil, value: CNPhoneNumber(stringValue: $0))]
+            return SystemContact(cnContact: cnContact)
+        }
+        let cache = ParsedPhoneNumberCache(localPhoneNumber: "+13135550100", regionCode: "US")
+        cache.setPhoneNumbers([], for: "stale")
+
+        let coldResult = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100",
+            parsedPhoneNumberCache: cache
+        )
+        XCTAssertEqual(cache.missCount, 2)
+        XCTAssertEqual(cache.count, 2)
+
+        cache.resetStatistics()
+        let warmResult = FetchedSystemContacts.parseContacts(
+            systemContacts,
+            phoneNumberUtil: phoneNumberUtil,
+            localPhoneNumber: "+13135550100",
+            parsedPhoneNumberCache: cache
+        )
+        XCTAssertEqual(cache.hitCount, 2)
+        XCTAssertEqual(cache.missCount, 0)
+        XCTAssertEqual(
+            Set(warmResult.phoneNumberToContactRef.keys.map { $0.rawValue }),
+            Set(coldResult.phoneNumberToContactRef.keys.map { $0.rawValue })
+        )
+    }
+}
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: AGPL-3.0-only
 //
 
+import libPhoneNumber_iOS
 import XCTest
 
 @testable import SignalServiceKit
@@ -158,4 +159,110 @@ class PhoneNumberTest: XCTestCase {
             )
         }
     }
+
+    func testParsingMatchesReferenceAlgorithm() {
+        let inputValues = [
+            "555-1234",
+            "(323) 555-1234",
+            "+33 1 70 39 38 00",
+            "87654321",
+            "+5521987654321",
+            "044 55 1234 5678",
+            "",
+            "not a number",
+            "555-1234",
+        ]
+        for localNumber in ["+13233214321", "+5521912345678", "+5215512345678"] {
+            let batchResults = phoneNumberUtilRef.parsePhoneNumbers(
+                userSpecifiedTexts: inputValues,
+                localPhoneNumber: localNumber
+            )
+            XCTAssertEqual(batchResults.count, inputValues.count)
+            for (inputValue, batchResult) in zip(inputValues, batchResults) {
+                let expectedValues = referenceE164s(userSpecifiedText: inputValue, localPhoneNumber: localNumber)
+                let individualResult = phoneNumberUtilRef.parsePhoneNumbers(
+                    userSpecifiedText: inputValue,
+                    localPhoneNumber: localNumber
+                )
+                XCTAssertEqual(batchResult.map { $0.toE164() }, expectedValues, inputValue)
+                XCTAssertEqual(individualResult.map { $0.toE164() }, expectedValues, inputValue)
+            }
+        }
+    }
+
+    /// How `parsePhoneNumbers(userSpecifiedText:localPhoneNumber:)` worked
+    /// before batch parsing, built only from libPhoneNumber calls.
+    private func referenceE164s(userSpecifiedText: String, localPhoneNumber: String) -> [String] {
+        let phoneNumberUtil = phoneNumberUtilRef!
+        let defaultCountryCode = PhoneNumberUtil.defaultCountryCode()
+        let localCallingCode = phoneNumberUtil.parseE164(localPhoneNumber)!.getCallingCode()!
+        let localCallingCodePrefix = "+\(localCallingCode)"
+        let localCountryCode = phoneNumberUtil.probableCountryCode(forCallingCode: localCallingCodePrefix)
+
+        func parse(normalizedText: String) -> [String] {
+            guard let text = normalizedText.filteredAsE164.nilIfEmpty else {
+                return []
+            }
+
+            var results = [String]()
+            func tryParsing(_ text: String, countryCode: String) {
+                guard
+                    let phoneNumber = try? phoneNumberUtil.parse(text, defaultRegion: countryCode),
+                    phoneNumberUtil.isPossibleNumber(phoneNumber),
+                    let e164 = try? phoneNumberUtil.format(phoneNumber, numberFormat: .E164),
+                    !results.contains(e164)
+                else {
+                    return
+                }
+                results.append(e164)
+            }
+
+            tryParsing(text, countryCode: defaultCountryCode)
+            if text.hasPrefix("+") {
+                return results
+            }
+            tryParsing("+" + text, countryCode: defaultCountryCode)
+            tryParsing(localCallingCodePrefix + text, countryCode: defaultCountryCode)
+            if localCountryCode != defaultCountryCode {
+                tryParsing(localCallingCodePrefix + text, countryCode: localCountryCode)
+            }
+
+            let areaCodePatterns: (missingAreaCode: String, areaCode: String)?
+            switch localCallingCode.intValue {
+            case 1:
+                areaCodePatterns = (#"^(\d{7})$"#, #"^\+1(\d{3})"#)
+            case 55:
+                areaCodePatterns = (#"^(9?\d{8})$"#, #"^\+55(\d{2})9?\d{8}"#)
+            default:
+                areaCodePatterns = nil
+            }
+            if
+                let areaCodePatterns,
+                text.range(of: areaCodePatterns.missingAreaCode, options: .regularExpression) != nil,
+                let areaCodeMatch = try! NSRegularExpression(pattern: areaCodePatterns.areaCode)
+                    .firstMatch(in: localPhoneNumber, range: localPhoneNumber.entireRange),
+                let areaCodeRange = Range(areaCodeMatch.range(at: 1), in: localPhoneNumber)
+            {
+                tryParsing("\(localCallingCodePrefix)\(localPhoneNumber[areaCodeRange])\(text)", countryCode: localCountryCode)
+            }
+
+            return results
+        }
+
+        var results = parse(normalizedText: userSpecifiedText)
+        for countryCode in [defaultCountryCode, localCountryCode].removingDuplicates(uniquingElementsBy: { $0 }) {
+            guard
+                let transformRule = NBMetadataHelper().getMetadataForRegion(countryCode)?.nationalPrefixTransformRule,
+                transformRule.contains("$1")
+            else {
+                continue
+            }
+            let normalizedText = transformRule.replacingOccurrences(of: "$1", with: userSpecifiedText)
+            guard !normalizedText.contains("$") else {
+                continue
+            }
+            results += parse(normalizedText: normalizedText)
+        }
+        return results
+    }
 }
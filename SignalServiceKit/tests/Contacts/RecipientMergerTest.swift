@@ -325,6 +325,76 @@ class RecipientMergerTest: XCTestCase {
         }
     }
 
+    func testBatchedContactDiscoveryMatchesSequentialMerges() {
+        let aci1 = Aci.constantForTesting("00000000-0000-4000-8000-0000000000a1")
+        let aci2 = Aci.constantForTesting("00000000-0000-4000-8000-0000000000a2")
+        let aci3 = Aci.constantForTesting("00000000-0000-4000-8000-0000000000a3")
+        let phone1 = E164("+16505550101")!
+        let phone2 = E164("+16505550102")!
+        let phone3 = E164("+16505550103")!
+        let phone4 = E164("+16505550104")!
+        let pni1 = Pni.constantForTesting("PNI:00000000-0000-4000-8000-0000000000b1")
+        let pni2 = Pni.constantForTesting("PNI:00000000-0000-4000-8000-0000000000b2")
+        let pni3 = Pni.constantForTesting("PNI:00000000-0000-4000-8000-0000000000b3")
+        let pni4 = Pni.constantForTesting("PNI:00000000-0000-4000-8000-0000000000b4")
+
+        let initialState: [(aci: Aci?, phoneNumber: E164?, pni: Pni?)] = [
+            (aci1, phone1, pni1),
+            (aci2, phone2, pni2),
+            (nil, phone3, pni3),
+        ]
+        let results: [(phoneNumber: E164, pni: Pni, aci: Aci?)] = [
+            // Unchanged.
+            (phone1, pni1, aci1),
+            (phone3, pni3, nil),
+            // aci2 changes its number to phone4, which touches the phone2
+            // recipient, so a later (unchanged-looking) phone2 result must
+            // be merged rather than served from the prefetched copy.
+            (phone4, pni4, aci2),
+            (phone2, pni2, nil),
+            // phone3 learns its ACI.
+            (phone3, pni3, aci3),
+            // Our own number is never merged.
+            (E164("+16505550100")!, pni4, nil),
+        ]
+
+        func run(isBatched: Bool) -> (returned: [String?], final: Set<String>) {
+            let d = TestDependencies()
+            let returned = d.mockDB.write { tx in
+                for state in initialState {
+                    d.recipientDatabaseTable.insertRecipient(
+                        SignalRecipient(aci: state.aci, pni: state.pni, phoneNumber: state.phoneNumber),
+                        transaction: tx
+                    )
+                }
+                if isBatched {
+                    return d.recipientMerger.applyMergesFromContactDiscovery(localIdentifiers: .forUnitTests, results: results, tx: tx)
+                }
+                return results.map {
+                    d.recipientMerger.applyMergeFromContactDiscovery(
+                        localIdentifiers: .forUnitTests,
+                        phoneNumber: $0.phoneNumber,
+                        pni: $0.pni,
+                        aci: $0.aci,
+                        tx: tx
+                    )
+                }
+            }
+            if isBatched {
+                XCTAssertEqual(d.recipientDatabaseTable.fetchRecipientsCallCount, 1)
+            }
+            func describe(_ recipient: SignalRecipient) -> String {
+                return "\(recipient.aci?.serviceIdString ?? "-") \(recipient.phoneNumber?.stringValue ?? "-") \(recipient.pni?.serviceIdString ?? "-")"
+            }
+            return (returned.map { $0.map(describe(_:)) }, Set(d.recipientDatabaseTable.recipientTable.values.map(describe(_:))))
+        }
+
+        let sequential = run(isBatched: false)
+        let batched = run(isBatched: true)
+        XCTAssertEqual(batched.returned, sequential.returned)
+        XCTAssertEqual(batched.final, sequential.final)
+    }
+
     func testSessionSwitchoverEvents() throws {
         let aci1 = Aci.constantForTesting("00000000-0000-4000-8000-0000000000a1")
         let phone1 = E164("+16505550101")!
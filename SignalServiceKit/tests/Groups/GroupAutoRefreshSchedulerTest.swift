@@ -0,0 +1,149 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class GroupAutoRefreshSchedulerTest: XCTestCase {
+
+    private typealias Candidate = GroupAutoRefreshScheduler.Candidate
+
+    private func candidate(
+        _ index: UInt8,
+        localRevision: UInt32 = 10,
+        knownRevision: UInt32? = nil,
+        lastRefreshDate: Date? = .distantPast,
+        lastInteractionRowId: UInt64 = 0
+    ) -> Candidate {
+        return Candidate(
+            groupId: Data(repeating: index, count: 32),
+            groupSecretParamsData: Data(),
+            localRevision: localRevision,
+            knownRevision: knownRevision,
+            lastRefreshDate: lastRefreshDate,
+            lastInteractionRowId: lastInteractionRowId
+        )
+    }
+
+    func testPrioritize() {
+        let now = Date()
+        let candidates = [
+            candidate(0, lastRefreshDate: now.addingTimeInterval(-kDayInterval)),
+            candidate(1, lastInteractionRowId: 5),
+            candidate(2, lastInteractionRowId: 50),
+            candidate(3, lastRefreshDate: nil),
+            candidate(4, localRevision: 10, knownRevision: 11),
+            candidate(5, localRevision: 10, knownRevision: 20),
+            // Already caught up to the known revision, and refreshed recently.
+            candidate(6, localRevision: 20, knownRevision: 20, lastRefreshDate: now)
+        ]
+
+        let prioritized = GroupAutoRefreshScheduler.prioritize(candidates, now: now)
+
+        XCTAssertEqual(prioritized.map { $0.groupId[0] }, [5, 4, 3, 2, 1])
+    }
+
+    /// Stands in for the groups service. Each refresh stays in flight until
+    /// the test finishes it.
+    private actor FakeGroupsService {
+        private(set) var startedGroupIds = [Data]()
+        private(set) var maxInFlightCount = 0
+        private var inFlightRefreshes = [Data: CheckedContinuation<Void, Error>]()
+
+        var inFlightCount: Int { inFlightRefreshes.count }
+
+        func refresh(_ candidate: Candidate) async throws {
+            startedGroupIds.append(candidate.groupId)
+            try await withCheckedThrowingContinuation { continuation in
+                inFlightRefreshes[candidate.groupId] = continuation
+                maxInFlightCount = max(maxInFlightCount, inFlightRefreshes.count)
+            }
+        }
+
+        func finish(_ groupId: Data, error: Error? = nil) {
+            guard let continuation = inFlightRefreshes.removeValue(forKey: groupId) else {
+                return XCTFail("Refresh isn't in flight")
+            }
+            if let error {
+                continuation.resume(throwing: error)
+            } else {
+                continuation.resume()
+            }
+        }
+
+        func finishAll() {
+            for groupId in inFlightRefreshes.keys {
+                finish(groupId)
+            }
+        }
+    }
+
+    /// Waits for the scheduler to react to the last thing the test did.
+    private func waitUntil(_ condition: () async -> Bool, file: StaticString = #file, line: UInt = #line) async throws {
+        for _ in 0..<10_000 {
+            if await condition() {
+                return
+            }
+            try await Task.sleep(nanoseconds: NSEC_PER_MSEC)
+        }
+        XCTFail("Condition never became true", file: file, line: line)
+    }
+
+    func testRefreshThroughput() async throws {
+        let candidates = (0..<100).map { candidate(UInt8($0)) }
+        let service = FakeGroupsService()
+        let scheduler = GroupAutoRefreshScheduler(maxConcurrentRefreshes: 4) { try await service.refresh($0) }
+        let refreshTask = Task { await scheduler.refresh(candidates) }
+
+        // Every refresh takes the same time on a simulated clock, so the
+        // scheduler should get through them in rounds of four.
+        let refreshLatency: TimeInterval = 0.005
+        var simulatedTime: TimeInterval = 0
+        var remainingCount = candidates.count
+        while remainingCount > 0 {
+            let expectedInFlightCount = min(4, remainingCount)
+            try await waitUntil { await service.inFlightCount == expectedInFlightCount }
+            await service.finishAll()
+            simulatedTime += refreshLatency
+            remainingCount -= expectedInFlightCount
+        }
+
+        let successCount = await refreshTask.value
+        XCTAssertEqual(successCount, candidates.count)
+        let startedGroupIds = await service.startedGroupIds
+        XCTAssertEqual(startedGroupIds.count, candidates.count)
+        XCTAssertEqual(Set(startedGroupIds), Set(candidates.map { $0.groupId }))
+        let maxInFlightCount = await service.maxInFlightCount
+        XCTAssertEqual(maxInFlightCount, 4)
+        // 100 sequential refreshes would take 100 * refreshLatency.
+        XCTAssertEqual(simulatedTime, 25 * refreshLatency, accuracy: refreshLatency / 2)
+    }
+
+    func testRefreshStopsAfterNetworkFailure() async throws {
+        let candidates = (0..<20).map { candidate(UInt8($0)) }
+        let service = FakeGroupsService()
+        let scheduler = GroupAutoRefreshScheduler(maxConcurrentRefreshes: 2) { try await service.refresh($0) }
+        let refreshTask = Task { await scheduler.refresh(candidates) }
+
+        try await waitUntil { await service.inFlightCount == 2 }
+        // Fail the first refresh while the second is still in flight, so the
+        // scheduler sees the failure before anything else finishes.
+        await service.finish(
+            candidates[0].groupId,
+            error: OWSHTTPError.networkFailure(requestUrl: URL(string: "https://signal.org")!)
+        )
+        await service.finish(candidates[1].groupId)
+
+        // The refresh that was in flight alongside the failing one finishes,
+        // but nothing new is started.
+        let successCount = await refreshTask.value
+        XCTAssertEqual(successCount, 1)
+        let startedGroupIds = await service.startedGroupIds
+        XCTAssertEqual(Set(startedGroupIds), [candidates[0].groupId, candidates[1].groupId])
+        XCTAssertEqual(startedGroupIds.count, 2)
+    }
+}
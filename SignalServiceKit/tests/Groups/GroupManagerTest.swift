@@ -0,0 +1,146 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import XCTest
+@testable import SignalServiceKit
+
+class GroupManagerTest: SSKBaseTestSwift {
+    override func setUp() {
+        super.setUp()
+        tsAccountManager.registerForTests(withLocalNumber: "+12225550101", uuid: UUID(), pni: UUID())
+    }
+
+    private struct GroupState: Equatable {
+        var name: String?
+        var revision: UInt32
+        var fullMembers: Set<SignalServiceAddress>
+        var disappearingMessageDuration: UInt32
+        var infoMessageUpdateItems: [Data]
+    }
+
+    private func groupState(groupId: Data, tx: SDSAnyReadTransaction) throws -> GroupState {
+        let groupThread = try XCTUnwrap(TSGroupThread.fetch(groupId: groupId, transaction: tx))
+        let groupModel = try XCTUnwrap(groupThread.groupModel as? TSGroupModelV2)
+        let dmConfigurationStore = DependenciesBridge.shared.disappearingMessagesConfigurationStore
+        let dmConfiguration = dmConfigurationStore.fetchOrBuildDefault(for: .thread(groupThread), tx: tx.asV2Read)
+
+        var infoMessages = [TSInfoMessage]()
+        try InteractionFinder(threadUniqueId: groupThread.uniqueId).enumerateRecentInteractions(transaction: tx) { interaction, _ in
+            if let infoMessage = interaction as? TSInfoMessage {
+                infoMessages.append(infoMessage)
+            }
+        }
+        let localIdentifiers = try XCTUnwrap(DependenciesBridge.shared.tsAccountManager.localIdentifiers(tx: tx.asV2Read))
+        let infoMessageUpdateItems = try infoMessages.reversed().map { infoMessage -> Data in
+            switch infoMessage.groupUpdateMetadata(localIdentifiers: localIdentifiers) {
+            case .precomputed(let wrapper):
+                return try JSONEncoder().encode(wrapper.updateItems)
+            default:
+                XCTFail("Unexpected info message.")
+                return Data()
+            }
+        }
+
+        return GroupState(
+            name: groupModel.groupName,
+            revision: groupModel.revision,
+            fullMembers: groupModel.groupMembership.fullMembers,
+            disappearingMessageDuration: dmConfiguration.isEnabled ? dmConfiguration.durationSeconds : 0,
+            infoMessageUpdateItems: infoMessageUpdateItems
+        )
+    }
+
+    private func buildUpdates(
+        startingFrom groupModel: TSGroupModelV2,
+        otherAci: Aci
+    ) throws -> [GroupManager.ExistingGroupThreadUpdate] {
+        var updates = [GroupManager.ExistingGroupThreadUpdate]()
+
+        func appendUpdate(
+            revision: UInt32,
+            disappearingMessageToken: DisappearingMessageToken? = nil,
+            mutate: (inout TSGroupModelBuilder) -> Void
+        ) throws {
+            var builder = (updates.last?.newGroupModel ?? groupModel).asBuilder
+            builder.groupV2Revision = revision
+            mutate(&builder)
+            updates.append(GroupManager.ExistingGroupThreadUpdate(
+                newGroupModel: try builder.buildAsV2(),
+                newDisappearingMessageToken: disappearingMessageToken,
+                newlyLearnedPniToAciAssociations: [:],
+                groupUpdateSource: .unknown
+            ))
+        }
+
+        try appendUpdate(revision: 1) { $0.name = "Renamed" }
+        try appendUpdate(revision: 2) {
+            var membershipBuilder = $0.groupMembership.asBuilder
+            membershipBuilder.addFullMember(otherAci, role: .normal)
+            $0.groupMembership = membershipBuilder.build()
+        }
+        // Nothing user-visible changes in this revision.
+        try appendUpdate(revision: 3) { _ in }
+        try appendUpdate(revision: 4, disappearingMessageToken: DisappearingMessageToken(isEnabled: true, durationSeconds: 60)) {
+            $0.name = "Renamed again"
+        }
+        // A redundant revision, which must be ignored.
+        try appendUpdate(revision: 4) { $0.name = "Stale" }
+        try appendUpdate(revision: 5) {
+            var membershipBuilder = $0.groupMembership.asBuilder
+            membershipBuilder.remove(otherAci)
+            $0.groupMembership = membershipBuilder.build()
+        }
+
+        return updates
+    }
+
+    func testBatchedUpdatesMatchSequentialUpdates() throws {
+        let otherAci = Aci.randomForTesting()
+        let (sequentialGroupId, batchedGroupId) = try write { tx -> (Data, Data) in
+            let localIdentifiers = try XCTUnwrap(DependenciesBridge.shared.tsAccountManager.localIdentifiers(tx: tx.asV2Read))
+            let localAddress = SignalServiceAddress(localIdentifiers.aci)
+
+            let sequentialThread = try GroupManager.createGroupForTests(members: [localAddress], name: "Test group", transaction: tx)
+            let batchedThread = try GroupManager.createGroupForTests(members: [localAddress], name: "Test group", transaction: tx)
+
+            let sequentialUpdates = try buildUpdates(startingFrom: try XCTUnwrap(sequentialThread.groupModel as? TSGroupModelV2), otherAci: otherAci)
+            for update in sequentialUpdates {
+                _ = try GroupManager.updateExistingGroupThreadInDatabaseAndCreateInfoMessage(
+                    newGroupModel: update.newGroupModel,
+                    newDisappearingMessageToken: update.newDisappearingMessageToken,
+                    newlyLearnedPniToAciAssociations: update.newlyLearnedPniToAciAssociations,
+                    groupUpdateSource: update.groupUpdateSource,
+                    localIdentifiers: localIdentifiers,
+                    spamReportingMetadata: .learnedByLocallyInitatedRefresh,
+                    transaction: tx
+                )
+            }
+
+            let batchedUpdates = try buildUpdates(startingFrom: try XCTUnwrap(batchedThread.groupModel as? TSGroupModelV2), otherAci: otherAci)
+            _ = try GroupManager.updateExistingGroupThreadInDatabaseAndCreateInfoMessages(
+                updates: batchedUpdates,
+                localIdentifiers: localIdentifiers,
+                spamReportingMetadata: .learnedByLocallyInitatedRefresh,
+                transaction: tx
+            )
+
+            return (sequentialThread.groupModel.groupId, batchedThread.groupModel.groupId)
+        }
+
+        let (sequentialState, batchedState) = try databaseStorage.read { tx in
+            (
+                try groupState(groupId: sequentialGroupId, tx: tx),
+                try groupState(groupId: batchedGroupId, tx: tx)
+            )
+        }
+
+        XCTAssertEqual(batchedState.revision, 5)
+        XCTAssertEqual(batchedState.name, "Renamed again")
+        XCTAssertEqual(batchedState.disappearingMessageDuration, 60)
+        XCTAssertFalse(batchedState.infoMessageUpdateItems.isEmpty)
+
+        XCTAssertEqual(batchedState, sequentialState)
+    }
+}
@@ -121,6 +121,129 @@ class GroupModelsTest: SSKBaseTestSwift {
         XCTAssertEqual(membership4, membership5)
     }
 
+    func testGroupMembershipSerialization() throws {
+        let pni = Pni.randomForTesting()
+
+        var builder = GroupMembership.Builder()
+        builder.addFullMember(.aci1, role: .administrator)
+        builder.addInvitedMember(pni, role: .normal, addedByAci: .aci1)
+        builder.addRequestingMember(.aci2)
+        builder.addBannedMember(.aci3, bannedAtTimestamp: 1234)
+        let membership = builder.build()
+
+        let encodedData = try NSKeyedArchiver.archivedData(withRootObject: membership, requiringSecureCoding: false)
+        let decodedMembership = try XCTUnwrap(NSKeyedUnarchiver.unarchivedObject(
+            ofClass: GroupMembership.self,
+            from: encodedData,
+            requiringSecureCoding: false
+        ))
+
+        XCTAssertEqual(decodedMembership, membership)
+        XCTAssertEqual(decodedMembership.role(for: Aci.aci1), .administrator)
+        XCTAssertTrue(decodedMembership.isFullMemberAndAdministrator(Aci.aci1))
+        XCTAssertTrue(decodedMembership.isInvitedMember(pni))
+        XCTAssertEqual(decodedMembership.addedByAci(forInvitedMember: pni), .aci1)
+        XCTAssertTrue(decodedMembership.isRequestingMember(Aci.aci2))
+        XCTAssertFalse(decodedMembership.isMemberOfAnyKind(Aci.aci3))
+        XCTAssertTrue(decodedMembership.isBannedMember(.aci3))
+        XCTAssertEqual(decodedMembership.fullMembers, [SignalServiceAddress(Aci.aci1)])
+        XCTAssertEqual(decodedMembership.fullMemberList, [SignalServiceAddress(Aci.aci1)])
+        XCTAssertEqual(decodedMembership.allMembersOfAnyKindServiceIds, [Aci.aci1, pni, Aci.aci2])
+
+        // Identical memberships produce identical archives.
+        let reencodedData = try NSKeyedArchiver.archivedData(withRootObject: decodedMembership, requiringSecureCoding: false)
+        XCTAssertEqual(reencodedData, encodedData)
+    }
+
+    /// How builds from before the compact "memberStates" archive decode (and
+    /// encode) a member's state.
+    private struct OldBuildMemberState: Codable, Equatable {
+        var typeKey: UInt
+        var role: TSGroupMemberRole?
+        var addedByUuid: UUID?
+        var didJoinFromInviteLink = false
+        var didJoinFromAcceptedJoinRequest = false
+
+        private enum CodingKeys: String, CodingKey {
+            case typeKey, role, addedByUuid, didJoinFromInviteLink, didJoinFromAcceptedJoinRequest
+        }
+
+        init(typeKey: UInt, role: TSGroupMemberRole? = nil, addedByUuid: UUID? = nil) {
+            self.typeKey = typeKey
+            self.role = role
+            self.addedByUuid = addedByUuid
+        }
+
+        init(from decoder: Decoder) throws {
+            let container = try decoder.container(keyedBy: CodingKeys.self)
+            typeKey = try container.decode(UInt.self, forKey: .typeKey)
+            switch typeKey {
+            case 0:
+                role = try container.decode(TSGroupMemberRole.self, forKey: .role)
+                didJoinFromInviteLink = try container.decodeIfPresent(Bool.self, forKey: .didJoinFromInviteLink) ?? false
+                didJoinFromAcceptedJoinRequest = try container.decodeIfPresent(Bool.self, forKey: .didJoinFromAcceptedJoinRequest) ?? false
+            case 1:
+                role = try container.decode(TSGroupMemberRole.self, forKey: .role)
+                addedByUuid = try container.decode(UUID.self, forKey: .addedByUuid)
+            default:
+                break
+            }
+        }
+
+        func encode(to encoder: Encoder) throws {
+            var container = encoder.container(keyedBy: CodingKeys.self)
+            try container.encode(typeKey, forKey: .typeKey)
+            switch typeKey {
+            case 0:
+                try container.encode(role, forKey: .role)
+                try container.encode(didJoinFromInviteLink, forKey: .didJoinFromInviteLink)
+                try container.encode(didJoinFromAcceptedJoinRequest, forKey: .didJoinFromAcceptedJoinRequest)
+            case 1:
+                try container.encode(role, forKey: .role)
+                try container.encode(addedByUuid, forKey: .addedByUuid)
+            default:
+                break
+            }
+        }
+    }
+
+    func testGroupMembershipDecodesInOldBuilds() throws {
+        let pni = Pni.randomForTesting()
+        let legacyAddress = SignalServiceAddress(phoneNumber: "+13213214321")
+
+        var builder = GroupMembership.Builder()
+        builder.addFullMember(.aci1, role: .administrator)
+        builder.addFullMembers([legacyAddress], role: .normal)
+        builder.addInvitedMember(pni, role: .normal, addedByAci: .aci1)
+        builder.addRequestingMember(.aci2)
+        let membership = builder.build()
+
+        let archiver = NSKeyedArchiver(requiringSecureCoding: false)
+        membership.encode(with: archiver)
+        archiver.finishEncoding()
+        let unarchiver = try NSKeyedUnarchiver(forReadingFrom: archiver.encodedData)
+        unarchiver.requiresSecureCoding = false
+        let memberStatesData = try XCTUnwrap(unarchiver.decodeObject(forKey: "memberStates") as? Data)
+
+        // Older builds decode "memberStates" as a dictionary keyed by address.
+        let expectedMemberStates: [SignalServiceAddress: OldBuildMemberState] = [
+            SignalServiceAddress(Aci.aci1): OldBuildMemberState(typeKey: 0, role: .administrator),
+            legacyAddress: OldBuildMemberState(typeKey: 0, role: .normal),
+            SignalServiceAddress(pni): OldBuildMemberState(typeKey: 1, role: .normal, addedByUuid: Aci.aci1.rawUUID),
+            SignalServiceAddress(Aci.aci2): OldBuildMemberState(typeKey: 2)
+        ]
+        let oldBuildMemberStates = try JSONDecoder().decode(
+            [SignalServiceAddress: OldBuildMemberState].self,
+            from: memberStatesData
+        )
+        XCTAssertEqual(oldBuildMemberStates, expectedMemberStates)
+
+        // Leaving out empty fields makes the archive smaller than the one
+        // older builds wrote.
+        let oldBuildMemberStatesData = try JSONEncoder().encode(expectedMemberStates)
+        XCTAssertLessThan(memberStatesData.count, oldBuildMemberStatesData.count)
+    }
+
     func testTSGroupModelBackwardsCompatibleDeserialization() throws {
         let groupIdLength = 16 // Taken from kGroupIdLength at the time of archiving.
         let expectedGroupId = Data(repeating: 8, count: groupIdLength)
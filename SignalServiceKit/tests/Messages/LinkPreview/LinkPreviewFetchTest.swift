@@ -0,0 +1,202 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+/// Serves each of `pages` one chunk at a time, the way a slow server would.
+/// A chunk is only served once the test releases it with `chunkPermits`, and
+/// serving stops as soon as the client cancels.
+private class StubURLProtocol: URLProtocol {
+    static let pages = AtomicDictionary<URL, [Data]>(lock: .init())
+    static let requestCount = AtomicUInt(lock: .init())
+    static let servedChunkCount = AtomicUInt(lock: .init())
+
+    /// Signaled by the test once for each chunk it allows to be served.
+    static var chunkPermits = DispatchSemaphore(value: 0)
+    /// Signaled when the client cancels a request.
+    static var didStop = DispatchSemaphore(value: 0)
+    /// Signaled when a request won't serve any more chunks.
+    static var didFinishServing = DispatchSemaphore(value: 0)
+
+    static func reset() {
+        requestCount.set(0)
+        servedChunkCount.set(0)
+        chunkPermits = DispatchSemaphore(value: 0)
+        didStop = DispatchSemaphore(value: 0)
+        didFinishServing = DispatchSemaphore(value: 0)
+    }
+
+    private let isStopped = AtomicBool(false, lock: .init())
+
+    override class func canInit(with request: URLRequest) -> Bool {
+        return true
+    }
+
+    override class func canonicalRequest(for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading() {
+        _ = Self.requestCount.increment()
+
+        guard let url = request.url, let chunks = Self.pages[url] else {
+            client?.urlProtocol(self, didFailWithError: URLError(.fileDoesNotExist))
+            return
+        }
+        let response = HTTPURLResponse(
+            url: url,
+            statusCode: 200,
+            httpVersion: "HTTP/1.1",
+            headerFields: ["Content-Type": "text/html; charset=utf-8"]
+        )!
+        client?.urlProtocol(self, didReceive: response, cacheStoragePolicy: .notAllowed)
+
+        DispatchQueue.global().async {
+            defer { Self.didFinishServing.signal() }
+            for chunk in chunks {
+                guard Self.chunkPermits.wait(timeout: .now() + 10) == .success else {
+                    self.client?.urlProtocol(self, didFailWithError: URLError(.timedOut))
+                    return
+                }
+                guard !self.isStopped.get() else {
+                    return
+                }
+                _ = Self.servedChunkCount.increment()
+                self.client?.urlProtocol(self, didLoad: chunk)
+            }
+            if !self.isStopped.get() {
+                self.client?.urlProtocolDidFinishLoading(self)
+            }
+        }
+    }
+
+    override func stopLoading() {
+        isStopped.set(true)
+        Self.didStop.signal()
+    }
+}
+
+class LinkPreviewFetchTest: SSKBaseTestSwift {
+
+    private var linkPreviewManager: LinkPreviewManagerImpl!
+
+    private let pageUrl = URL(string: "https://example.com/article")!
+
+    /// A small head, then a large body, split into the chunks it's served in.
+    private let pageChunks: [String] = {
+        let head = """
+            <html><head>
+            <title>Fallback title</title>
+            <meta property="og:title" content="Stub article">
+            <meta property="og:description" content="Served by a stub">
+            </head>
+            """
+        let paragraphs = String(repeating: "<p>Lorem ipsum dolor sit amet.</p>\n", count: 100)
+        return [head, "<body>"] + Array(repeating: paragraphs, count: 8) + ["</body></html>"]
+    }()
+
+    private func releaseChunks(_ count: Int) {
+        for _ in 0..<count {
+            StubURLProtocol.chunkPermits.signal()
+        }
+    }
+
+    override func setUp() {
+        super.setUp()
+
+        StubURLProtocol.reset()
+        StubURLProtocol.pages[pageUrl] = pageChunks.map { Data($0.utf8) }
+
+        linkPreviewManager = LinkPreviewManagerImpl(
+            attachmentManager: TSResourceManagerMock(),
+            attachmentStore: TSResourceStoreMock(),
+            db: MockDB(),
+            groupsV2: LinkPreviewManagerImpl.Wrappers.GroupsV2(MockGroupsV2()),
+            sskPreferences: MockSSKPreferences()
+        )
+        linkPreviewManager.urlProtocolClassesForTesting = [StubURLProtocol.self]
+    }
+
+    func testFetchStopsAfterHead() throws {
+        let expectation = self.expectation(description: "fetch")
+        var fetchedHTML: LinkPreviewManagerImpl.FetchedHTML?
+        linkPreviewManager.fetchHTMLHead(from: pageUrl)
+            .done {
+                fetchedHTML = $0
+                expectation.fulfill()
+            }
+            .catch {
+                XCTFail("Unexpected error: \($0)")
+                expectation.fulfill()
+            }
+        // The first chunk ends with </head>, so it should be all the fetch needs.
+        releaseChunks(1)
+        waitForExpectations(timeout: 10)
+
+        let result = try XCTUnwrap(fetchedHTML)
+        XCTAssertTrue(result.stoppedAfterHead)
+        XCTAssertEqual(HTMLMetadata.construct(parsing: result.html).ogTitle, "Stub article")
+        XCTAssertEqual(result.byteCount, pageChunks[0].utf8.count)
+
+        // Once the request is cancelled, releasing the rest of the page
+        // shouldn't serve any more of it.
+        XCTAssertEqual(StubURLProtocol.didStop.wait(timeout: .now() + 10), .success)
+        releaseChunks(pageChunks.count - 1)
+        XCTAssertEqual(StubURLProtocol.didFinishServing.wait(timeout: .now() + 10), .success)
+        XCTAssertEqual(StubURLProtocol.servedChunkCount.get(), 1)
+    }
+
+    func testFetchesAreCoalescedAndCached() {
+        releaseChunks(pageChunks.count)
+
+        let expectation = self.expectation(description: "fetch")
+        expectation.expectedFulfillmentCount = 2
+        var titles = [String?]()
+        for _ in 0..<2 {
+            linkPreviewManager.fetchLinkPreview(for: pageUrl)
+                .done(on: DispatchQueue.main) {
+                    titles.append($0.title)
+                    expectation.fulfill()
+                }
+                .catch {
+                    XCTFail("Unexpected error: \($0)")
+                    expectation.fulfill()
+                }
+        }
+        waitForExpectations(timeout: 10)
+        XCTAssertEqual(titles, ["Stub article", "Stub article"])
+
+        // The same page, spelled differently.
+        let cachedExpectation = self.expectation(description: "cached fetch")
+        let equivalentUrl = URL(string: "HTTPS://EXAMPLE.com/article#comments")!
+        linkPreviewManager.fetchLinkPreview(for: equivalentUrl)
+            .done {
+                XCTAssertEqual($0.title, "Stub article")
+                XCTAssertEqual($0.url, equivalentUrl)
+                cachedExpectation.fulfill()
+            }
+            .catch {
+                XCTFail("Unexpected error: \($0)")
+                cachedExpectation.fulfill()
+            }
+        waitForExpectations(timeout: 10)
+
+        XCTAssertEqual(StubURLProtocol.requestCount.get(), 1)
+    }
+
+    func testDraftCacheExpiresEntries() {
+        var now = Date()
+        let cache = LinkPreviewDraftCache(timeToLive: 60, dateProvider: { now })
+        let key = LinkPreviewDraftCache.cacheKey(for: pageUrl)!
+        cache.setDraft(OWSLinkPreviewDraft(url: pageUrl, title: "Title"), forKey: key)
+
+        XCTAssertEqual(cache.draft(forKey: key, url: pageUrl)?.title, "Title")
+        now = now.addingTimeInterval(61)
+        XCTAssertNil(cache.draft(forKey: key, url: pageUrl))
+    }
+}
@@ -25,6 +25,10 @@ private class MockRecipientMerger: RecipientMerger {
         fatalError()
     }
 
+    func applyMergesFromContactDiscovery(localIdentifiers: LocalIdentifiers, results: [(phoneNumber: E164, pni: Pni, aci: Aci?)], tx: DBWriteTransaction) -> [SignalRecipient?] {
+        fatalError()
+    }
+
     func applyMergeFromSealedSender(localIdentifiers: LocalIdentifiers, aci: Aci, phoneNumber: E164?, tx: DBWriteTransaction) -> SignalRecipient {
         fatalError()
     }
@@ -142,4 +142,33 @@ class HTMLMetadataTests: XCTestCase {
         XCTAssertEqual(content.ogTitle, "Randomness is Random - Numberphile")
         XCTAssertEqual(content.ogImageUrlString, "https://i.ytimg.com/vi/tP-Ipsat90c/maxresdefault.jpg")
     }
+
+    func testHeadScanner() {
+        let html = Data("<html><HEAD><title>T</title></HeAd><body>Body</body></html>".utf8)
+        let expectedHeadLength = html.range(of: Data("</HeAd>".utf8))!.lowerBound
+
+        // However the document is split up, the end of the head is found once
+        // its closing tag has fully arrived.
+        for chunkSize in 1...html.count {
+            var scanner = HTMLMetadata.HeadScanner()
+            var receivedLength = 0
+            while receivedLength < html.count {
+                receivedLength = min(receivedLength + chunkSize, html.count)
+                let isComplete = scanner.scan(html.prefix(receivedLength))
+                XCTAssertEqual(isComplete, receivedLength >= expectedHeadLength + "</head".count)
+                if isComplete {
+                    break
+                }
+            }
+            XCTAssertEqual(scanner.headLength, expectedHeadLength)
+        }
+
+        var bodyOnlyScanner = HTMLMetadata.HeadScanner()
+        XCTAssertTrue(bodyOnlyScanner.scan(Data("<title>T</title><Body>".utf8)))
+        XCTAssertEqual(bodyOnlyScanner.headLength, 16)
+
+        var incompleteScanner = HTMLMetadata.HeadScanner()
+        XCTAssertFalse(incompleteScanner.scan(Data("<title>T</title></hea".utf8)))
+        XCTAssertNil(incompleteScanner.headLength)
+    }
 }
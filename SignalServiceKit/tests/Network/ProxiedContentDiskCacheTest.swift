@@ -0,0 +1,125 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class ProxiedContentDiskCacheTest: XCTestCase {
+
+    private var directoryPath: String!
+    private var now = Date()
+
+    private let validators = ProxiedContentDiskCache.Validators(response: HTTPURLResponse(
+        url: URL(string: "https://example.com/a.gif")!,
+        statusCode: 206,
+        httpVersion: "HTTP/1.1",
+        headerFields: ["ETag": "\"abc\""]
+    )!)!
+
+    override func setUp() {
+        super.setUp()
+        directoryPath = (OWSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        now = Date()
+    }
+
+    override func tearDown() {
+        OWSFileSystem.deleteFileIfExists(directoryPath)
+        super.tearDown()
+    }
+
+    private func makeCache(maxByteCount: Int = 1000) -> ProxiedContentDiskCache {
+        return ProxiedContentDiskCache(
+            directoryPath: directoryPath,
+            maxByteCount: maxByteCount,
+            maxAge: 60,
+            dateProvider: { [unowned self] in self.now }
+        )
+    }
+
+    func testEvictsLeastRecentlyUsed() {
+        let cache = makeCache()
+        for key in ["a", "b", "c"] {
+            cache.store(data: Data(count: 400), contentLength: 400, validators: nil, forKey: key)
+            now += 1
+        }
+        // "a" was evicted to make room for "c".
+        XCTAssertNil(cache.entry(forKey: "a"))
+
+        // Using "b" makes "c" the least recently used.
+        now += 1
+        XCTAssertNotNil(cache.entry(forKey: "b"))
+        now += 1
+        cache.store(data: Data(count: 400), contentLength: 400, validators: nil, forKey: "d")
+        XCTAssertNil(cache.entry(forKey: "c"))
+        XCTAssertNotNil(cache.entry(forKey: "b"))
+        XCTAssertNotNil(cache.entry(forKey: "d"))
+    }
+
+    func testFreshness() throws {
+        let cache = makeCache()
+        cache.store(data: Data(count: 10), contentLength: 10, validators: validators, forKey: "a")
+        let entry = try XCTUnwrap(cache.entry(forKey: "a"))
+        XCTAssertTrue(cache.isFresh(entry))
+
+        now += 61
+        XCTAssertFalse(cache.isFresh(entry))
+        cache.markValidated(forKey: "a")
+        XCTAssertTrue(cache.isFresh(try XCTUnwrap(cache.entry(forKey: "a"))))
+    }
+
+    func testPartialEntries() throws {
+        let cache = makeCache()
+        // Partial content can't be resumed safely without validators.
+        XCTAssertNil(cache.store(data: Data(count: 10), contentLength: 20, validators: nil, forKey: "a"))
+
+        let partialData = Data(repeating: 7, count: 10)
+        cache.store(data: partialData, contentLength: 20, validators: validators, forKey: "a")
+        let entry = try XCTUnwrap(cache.entry(forKey: "a"))
+        XCTAssertFalse(entry.isComplete)
+        XCTAssertFalse(cache.isFresh(entry))
+        XCTAssertEqual(entry.validators, validators)
+        XCTAssertEqual(cache.readData(for: entry), partialData)
+    }
+
+    func testLinkedContentOutlivesEntry() throws {
+        let cache = makeCache()
+        let data = Data(repeating: 1, count: 100)
+        let entry = try XCTUnwrap(cache.store(data: data, contentLength: 100, validators: nil, forKey: "a"))
+
+        let filePath = (OWSTemporaryDirectory() as NSString).appendingPathComponent(UUID().uuidString)
+        defer { OWSFileSystem.deleteFileIfExists(filePath) }
+        XCTAssertTrue(cache.linkContent(for: entry, toFilePath: filePath))
+
+        cache.removeEntry(forKey: "a")
+        XCTAssertNil(cache.entry(forKey: "a"))
+        XCTAssertEqual(try Data(contentsOf: URL(fileURLWithPath: filePath)), data)
+    }
+
+    func testEntriesPersist() throws {
+        let cache = makeCache()
+        cache.store(data: Data(repeating: 2, count: 50), contentLength: 50, validators: validators, forKey: "a")
+        cache.flushIndex()
+
+        let reloadedCache = makeCache()
+        reloadedCache.waitForIndexLoad()
+        let entry = try XCTUnwrap(reloadedCache.entry(forKey: "a"))
+        XCTAssertEqual(entry.validators, validators)
+        XCTAssertEqual(reloadedCache.readData(for: entry), Data(repeating: 2, count: 50))
+    }
+
+    func testLoadsIndexInBackground() throws {
+        XCTAssertTrue(OWSFileSystem.ensureDirectoryExists(directoryPath))
+        let strayFilePath = (directoryPath as NSString).appendingPathComponent(UUID().uuidString)
+        try Data(count: 10).write(to: URL(fileURLWithPath: strayFilePath))
+
+        // The index is loaded, and files it doesn't know about are deleted,
+        // without anything asking for an entry.
+        let cache = makeCache()
+        cache.waitForIndexLoad()
+        XCTAssertFalse(OWSFileSystem.fileOrFolderExists(atPath: strayFilePath))
+    }
+}
@@ -0,0 +1,81 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class ProfileFetcherTest: XCTestCase {
+
+    func testMetrics() {
+        let startDate = Date()
+        var metrics = ProfileFetchMetrics()
+
+        XCTAssertEqual(metrics.dedupeRatio, 0)
+
+        metrics.didRequestFetch(wasDeduped: false)
+        metrics.didStartFetch(now: startDate)
+        metrics.didRequestFetch(wasDeduped: true)
+        metrics.didRequestFetch(wasDeduped: true)
+        metrics.didRequestFetch(wasDeduped: false)
+        metrics.didStartFetch(now: startDate.addingTimeInterval(30))
+
+        XCTAssertEqual(metrics.requestCount, 4)
+        XCTAssertEqual(metrics.dedupedRequestCount, 2)
+        XCTAssertEqual(metrics.dedupeRatio, 0.5)
+        XCTAssertEqual(metrics.fetchCount, 2)
+        XCTAssertEqual(metrics.fetchesPerMinute(now: startDate.addingTimeInterval(45)), 2)
+        XCTAssertEqual(metrics.fetchesPerMinute(now: startDate.addingTimeInterval(75)), 1)
+        XCTAssertEqual(metrics.fetchesPerMinute(now: startDate.addingTimeInterval(120)), 0)
+    }
+
+    func testUpdateBatcherAppliesEveryUpdate() async throws {
+        let db = InMemoryDB()
+        let batcher = ProfileUpdateBatcher(db: db)
+        let appliedUpdates = AtomicValue<[Int]>([], lock: .init())
+        let updateCount = 100
+
+        // Hold up the first transaction until every other update is waiting,
+        // so that they're all written in full batches after it.
+        let firstUpdateGate = DispatchSemaphore(value: 0)
+        let firstUpdate = Task {
+            await batcher.write { _ in
+                firstUpdateGate.wait()
+                appliedUpdates.update { $0.append(0) }
+            }
+        }
+        try await waitUntil { await batcher.transactionCount == 1 }
+
+        let otherUpdates = Task {
+            await withTaskGroup(of: Void.self) { taskGroup in
+                for index in 1..<updateCount {
+                    taskGroup.addTask {
+                        await batcher.write { _ in
+                            appliedUpdates.update { $0.append(index) }
+                        }
+                    }
+                }
+            }
+        }
+        try await waitUntil { await batcher.pendingUpdateCount == updateCount - 1 }
+
+        firstUpdateGate.signal()
+        await firstUpdate.value
+        await otherUpdates.value
+
+        XCTAssertEqual(Set(appliedUpdates.get()), Set(0..<updateCount))
+        let batchSize = ProfileUpdateBatcher.maxBatchSize
+        let expectedTransactionCount = 1 + (updateCount - 1 + batchSize - 1) / batchSize
+        let transactionCount = await batcher.transactionCount
+        XCTAssertEqual(transactionCount, expectedTransactionCount)
+    }
+
+    private func waitUntil(_ condition: () async -> Bool) async throws {
+        while await !condition() {
+            try await Task.sleep(nanoseconds: NSEC_PER_MSEC)
+        }
+    }
+}
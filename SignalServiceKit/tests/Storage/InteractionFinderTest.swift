@@ -87,4 +87,53 @@ class InteractionFinderTest: SSKBaseTestSwift {
             XCTAssertEqual(unarchivedCount, unreadCount)
         }
     }
+
+    func testUnreadThreadIds() {
+        var unreadThread: TSContactThread!
+        var markedUnreadThread: TSContactThread!
+        var archivedUnreadThread: TSContactThread!
+        write { transaction in
+            func makeThread(withUnreadMessage: Bool) -> TSContactThread {
+                let thread = ContactThreadFactory().create(transaction: transaction)
+                let messageFactory = IncomingMessageFactory()
+                messageFactory.threadCreator = { _ in return thread }
+                let message = messageFactory.create(transaction: transaction)
+                if !withUnreadMessage {
+                    message.markAsRead(
+                        atTimestamp: Date.ows_millisecondTimestamp(),
+                        thread: thread,
+                        circumstance: .onLinkedDevice,
+                        shouldClearNotifications: true,
+                        transaction: transaction
+                    )
+                }
+                return thread
+            }
+
+            unreadThread = makeThread(withUnreadMessage: true)
+
+            _ = makeThread(withUnreadMessage: false)
+
+            markedUnreadThread = makeThread(withUnreadMessage: false)
+            ThreadAssociatedData
+                .fetchOrDefault(for: markedUnreadThread, transaction: transaction)
+                .updateWith(isMarkedUnread: true, updateStorageService: false, transaction: transaction)
+
+            archivedUnreadThread = makeThread(withUnreadMessage: true)
+            ThreadAssociatedData
+                .fetchOrDefault(for: archivedUnreadThread, transaction: transaction)
+                .updateWith(isArchived: true, updateStorageService: false, transaction: transaction)
+        }
+
+        read { transaction in
+            XCTAssertEqual(
+                Set(InteractionFinder.unreadThreadIds(isArchived: false, transaction: transaction)),
+                [unreadThread.uniqueId, markedUnreadThread.uniqueId]
+            )
+            XCTAssertEqual(
+                InteractionFinder.unreadThreadIds(isArchived: true, transaction: transaction),
+                [archivedUnreadThread.uniqueId]
+            )
+        }
+    }
 }
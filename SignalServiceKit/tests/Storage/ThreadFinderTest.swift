@@ -0,0 +1,48 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class ThreadFinderTest: SSKBaseTestSwift {
+
+    func testVisibleThreadPages() {
+        write { tx in
+            for _ in 0..<7 {
+                let thread = ContactThreadFactory().create(transaction: tx)
+                let messageFactory = IncomingMessageFactory()
+                messageFactory.threadCreator = { _ in thread }
+                _ = messageFactory.create(transaction: tx)
+            }
+        }
+
+        read { tx in
+            let threadFinder = ThreadFinder()
+            let allThreadIds = try! threadFinder.visibleThreadIds(isArchived: false, transaction: tx)
+            XCTAssertEqual(allThreadIds.count, 7)
+
+            var pagedThreadIds = [String]()
+            var lastThread: TSThread?
+            while true {
+                let page = try! threadFinder.visibleThreadIds(
+                    isArchived: false,
+                    excludingThreadIds: [allThreadIds[1]],
+                    after: lastThread,
+                    limit: 3,
+                    transaction: tx
+                )
+                guard let lastThreadId = page.last else {
+                    break
+                }
+                pagedThreadIds += page
+                lastThread = TSThread.anyFetch(uniqueId: lastThreadId, transaction: tx)
+            }
+
+            XCTAssertEqual(pagedThreadIds, allThreadIds.filter { $0 != allThreadIds[1] })
+        }
+    }
+}
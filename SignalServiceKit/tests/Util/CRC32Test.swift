@@ -32,4 +32,30 @@ final class CRC32Test: XCTestCase {
         crc = crc.update(with: Data([4, 5, 6]))
         XCTAssertEqual(crc.value, 2180413220)
     }
+
+    func testAppend() {
+        var crc = CRC32()
+        crc.append(Data([1, 2, 3]))
+        [UInt8]([4, 5, 6]).withUnsafeBytes { crc.append($0) }
+        XCTAssertEqual(crc.value, 2180413220)
+
+        crc.append(UnsafeRawBufferPointer(start: nil, count: 0))
+        XCTAssertEqual(crc.value, 2180413220)
+    }
+
+    func testCombined() {
+        let first = CRC32().update(with: Data([1, 2, 3]))
+        let second = CRC32().update(with: Data([4, 5, 6]))
+        XCTAssertEqual(first.combined(with: second, length: 3).value, 2180413220)
+        XCTAssertEqual(first.combined(with: CRC32(), length: 0).value, first.value)
+    }
+
+    func testBulkChecksum() {
+        let data = Randomness.generateRandomBytes(100_000)
+        let expected = CRC32().update(with: data).value
+        for pieceSize in [1, 7, 4096, 99_999, 100_000, 1_000_000] {
+            XCTAssertEqual(CRC32.checksum(of: data, pieceSize: pieceSize).value, expected, "\(pieceSize)")
+        }
+        XCTAssertEqual(CRC32.checksum(of: Data()).value, 0)
+    }
 }
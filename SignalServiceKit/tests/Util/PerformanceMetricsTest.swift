@@ -0,0 +1,102 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import Foundation
+import XCTest
+
+@testable import SignalServiceKit
+
+class PerformanceMetricsTest: XCTestCase {
+
+    func testBucketsCoverEveryValue() {
+        var previousIndex = -1
+        for value: UInt64 in 0..<100_000 {
+            let index = LatencyHistogram.bucketIndex(for: value)
+            // Buckets are contiguous, and each one ends where the next starts.
+            XCTAssert(index == previousIndex || index == previousIndex + 1, "\(value)")
+            if index != previousIndex, index > 0 {
+                XCTAssertEqual(LatencyHistogram.highestValue(inBucket: index - 1), value - 1)
+            }
+            XCTAssertLessThanOrEqual(value, LatencyHistogram.highestValue(inBucket: index))
+            previousIndex = index
+        }
+        XCTAssertEqual(LatencyHistogram.bucketIndex(for: 1 << 42 - 1), LatencyHistogram.bucketCount - 1)
+    }
+
+    func testPercentiles() {
+        let histogram = LatencyHistogram()
+        // 1ms, 2ms, ..., 1000ms.
+        for millisecond in 1...1000 {
+            histogram.record(TimeInterval(millisecond) / 1000)
+        }
+        let snapshot = histogram.snapshot()
+        XCTAssertEqual(snapshot.count, 1000)
+        XCTAssertEqual(snapshot.maximum, 1, accuracy: 0.000_001)
+        XCTAssertEqual(snapshot.total, 500.5, accuracy: 0.000_001)
+
+        for (fraction, expected) in [(0.5, 0.5), (0.9, 0.9), (0.99, 0.99), (1, 1)] {
+            let percentile = snapshot.percentile(fraction)
+            XCTAssertGreaterThanOrEqual(percentile, expected, "\(fraction)")
+            XCTAssertLessThanOrEqual(percentile, expected * (1 + 1 / 16), "\(fraction)")
+        }
+    }
+
+    func testSmallDurationsAreExact() {
+        let histogram = LatencyHistogram()
+        for microseconds in [0, 3, 3, 7, 15] {
+            histogram.record(TimeInterval(microseconds) / 1_000_000)
+        }
+        let snapshot = histogram.snapshot()
+        XCTAssertEqual(snapshot.percentile(0.2), 0)
+        XCTAssertEqual(snapshot.percentile(0.6), 0.000_003, accuracy: 0.000_000_1)
+        XCTAssertEqual(snapshot.percentile(1), 0.000_015, accuracy: 0.000_000_1)
+    }
+
+    func testExtremeDurations() {
+        let histogram = LatencyHistogram()
+        histogram.record(-1)
+        histogram.record(.infinity)
+        XCTAssertEqual(histogram.snapshot().count, 2)
+    }
+
+    func testTakeSnapshotResets() {
+        let histogram = LatencyHistogram()
+        histogram.record(0.01)
+        XCTAssertEqual(histogram.takeSnapshot().count, 1)
+        XCTAssertEqual(histogram.snapshot().count, 0)
+        XCTAssertEqual(histogram.snapshot().percentile(0.5), 0)
+    }
+
+    func testRegistry() {
+        let metrics = PerformanceMetrics()
+        XCTAssert(metrics.histogram("a") === metrics.histogram("a"))
+        XCTAssert(metrics.histogram("a") !== metrics.histogram("b"))
+        XCTAssert(metrics.counter("a") === metrics.counter("a"))
+        XCTAssert(metrics.gauge("a") === metrics.gauge("a"))
+
+        metrics.counter("a").increment()
+        metrics.counter("a").add(2)
+        XCTAssertEqual(metrics.counter("a").takeCount(), 3)
+        XCTAssertEqual(metrics.counter("a").takeCount(), 0)
+
+        XCTAssertNil(metrics.gauge("a").value)
+        metrics.gauge("a").set(5)
+        XCTAssertEqual(metrics.gauge("a").value, 5)
+    }
+
+    func testMeasure() throws {
+        let metrics = PerformanceMetrics()
+        let result = metrics.measure("span") { 42 }
+        XCTAssertEqual(result, 42)
+
+        struct TestError: Error {}
+        XCTAssertThrowsError(try metrics.measure("span") { () throws -> Void in throw TestError() })
+
+        let span = metrics.startSpan("span")
+        XCTAssertGreaterThanOrEqual(span.end(), 0)
+
+        XCTAssertEqual(metrics.histogram("span").snapshot().count, 3)
+    }
+}
@@ -155,6 +155,66 @@ class PngChunkerTest: XCTestCase {
         }
     }
 
+    func testLargeChunkChecksum() throws {
+        // Large enough to be checksummed in several pieces.
+        let type = "IDAT".data(using: .ascii)!
+        let chunkData = Randomness.generateRandomBytes(Int32(3 * CRC32.defaultPieceSize + 123))
+        let crc = CRC32().update(with: type + chunkData).value
+        var data = PngChunker.pngSignature
+        data += withUnsafeBytes(of: UInt32(chunkData.count).bigEndian) { Data($0) }
+        data += type + chunkData
+        data += withUnsafeBytes(of: crc.bigEndian) { Data($0) }
+
+        let chunk = try XCTUnwrap(PngChunker(data: data).next())
+        XCTAssertEqual(chunk.data, chunkData)
+
+        data[data.endIndex - 5] ^= 0xff
+        XCTAssertThrowsError(try PngChunker(data: data).next()) { error in
+            XCTAssertEqual(error as? PngChunker.PngChunkerError, PngChunker.PngChunkerError.invalidChunkChecksum)
+        }
+    }
+
+    func testAllBytesIsContiguous() throws {
+        let data = fixture(filename: "test-apng")
+        let chunker = try PngChunker(data: data)
+        let chunk = try XCTUnwrap(chunker.next())
+
+        XCTAssertEqual(chunk.allBytes(), chunk.lengthBytes + chunk.type + chunk.data + chunk.crcBytes)
+        XCTAssertEqual(chunk.allBytes(), data[8..<(8 + 25)])
+        XCTAssertEqual(chunk.data.count, 13)
+    }
+
+    func testIsAnimatedDoesNotVerifyImageData() throws {
+        // This stops at the IDAT chunk, so it shouldn't notice that its
+        // checksum is wrong.
+        var data = fixture(filename: "test-png")
+        let idatEnd = try {
+            let chunker = try PngChunker(data: data)
+            _ = try chunker.next()
+            let idat = try XCTUnwrap(chunker.next())
+            return idat.allBytes().endIndex
+        }()
+        data[idatEnd - 1] ^= 0xff
+
+        XCTAssertFalse(try PngChunker.isAnimated(data: data))
+    }
+
+    func testIsAnimated() throws {
+        XCTAssertFalse(try PngChunker.isAnimated(data: fixture(filename: "test-png")))
+        XCTAssertTrue(try PngChunker.isAnimated(data: fixture(filename: "test-apng")))
+
+        // Apple's CgBI PNGs have a CgBI chunk before IHDR. They should still
+        // be classified.
+        let cgbiType = "CgBI".data(using: .ascii)!
+        let cgbiData = Data([0x50, 0x00, 0x20, 0x06])
+        let cgbiCrc = CRC32().update(with: cgbiType + cgbiData).value
+        let cgbiChunk = Data([0, 0, 0, 4]) + cgbiType + cgbiData + withUnsafeBytes(of: cgbiCrc.bigEndian) { Data($0) }
+        let data = PngChunker.pngSignature + cgbiChunk + fixture(filename: "test-png").dropFirst(8)
+
+        XCTAssertFalse(try PngChunker.isAnimated(data: data))
+        XCTAssertEqual(data.isAnimatedPngData()?.boolValue, false)
+    }
+
     // MARK: - Utilities
 
     private func fixture(filename: String, withExtension ext: String = "png") -> Data {
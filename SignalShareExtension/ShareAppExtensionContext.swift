@@ -20,6 +20,11 @@ final class ShareAppExtensionContext: NSObject {
 
     private var notificationCenterObservers = [NSObjectProtocol]()
 
+    private static let didBecomeActiveMetric = PerformanceMetrics.shared.histogram("shareExtension.didBecomeActive")
+    private static let willResignActiveMetric = PerformanceMetrics.shared.histogram("shareExtension.willResignActive")
+    private static let didEnterBackgroundMetric = PerformanceMetrics.shared.histogram("shareExtension.didEnterBackground")
+    private static let willEnterForegroundMetric = PerformanceMetrics.shared.histogram("shareExtension.willEnterForeground")
+
     static private let isRTL: Bool = {
         // Borrowed from PureLayout's AppExtension compatible RTL support.
         // App Extensions may not access UIApplication.sharedApplication.
@@ -40,8 +45,9 @@ final class ShareAppExtensionContext: NSObject {
             queue: mainQueue) { [weak self] notification in
                 Logger.info("")
                 self?.internalReportedApplicationState = .active
-                BenchManager.bench(
+                Bench(
                     title: "Slow post DidBecomeActive",
+                    metric: Self.didBecomeActiveMetric,
                     logIfLongerThan: 0.01,
                     logInProduction: true) {
                         NotificationCenter.default.post(name: NSNotification.Name.OWSApplicationDidBecomeActive, object: nil)
@@ -54,8 +60,9 @@ final class ShareAppExtensionContext: NSObject {
             queue: mainQueue) { [weak self] notification in
                 Logger.info("")
                 self?.internalReportedApplicationState = .inactive
-                BenchManager.bench(
+                Bench(
                     title: "Slow post WillResignActive",
+                    metric: Self.willResignActiveMetric,
                     logIfLongerThan: 0.01,
                     logInProduction: true) {
                         NotificationCenter.default.post(name: NSNotification.Name.OWSApplicationWillResignActive, object: nil)
@@ -68,8 +75,9 @@ final class ShareAppExtensionContext: NSObject {
             queue: mainQueue) { [weak self] notification in
                 Logger.info("")
                 self?.internalReportedApplicationState = .background
-                BenchManager.bench(
+                Bench(
                     title: "Slow post DidEnterBackground",
+                    metric: Self.didEnterBackgroundMetric,
                     logIfLongerThan: 0.01,
                     logInProduction: true) {
                         NotificationCenter.default.post(name: NSNotification.Name.OWSApplicationDidEnterBackground, object: nil)
@@ -82,8 +90,9 @@ final class ShareAppExtensionContext: NSObject {
             queue: mainQueue) { [weak self] notification in
                 Logger.info("")
                 self?.internalReportedApplicationState = .inactive
-                BenchManager.bench(
+                Bench(
                     title: "Slow post WillEnterForeground",
+                    metric: Self.willEnterForegroundMetric,
                     logIfLongerThan: 0.01,
                     logInProduction: true) {
                         NotificationCenter.default.post(name: NSNotification.Name.OWSApplicationWillEnterForeground, object: nil)
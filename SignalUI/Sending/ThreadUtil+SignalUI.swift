@@ -67,6 +67,8 @@ extension ThreadUtil {
 
     // MARK: - Durable Message Enqueue
 
+    private static let sendMetric = PerformanceMetrics.shared.histogram("message.send")
+
     class func enqueueMessage(
         _ unpreparedMessage: UnpreparedOutgoingMessage,
         thread: TSThread,
@@ -77,6 +79,7 @@ extension ThreadUtil {
         let eventId = "sendMessageMarkedAsSent-\(messageTimestampForLogging)"
         BenchEventStart(
             title: "Send Message Milestone: Marked as Sent (\(messageTimestampForLogging))",
+            metric: Self.sendMetric,
             eventId: eventId,
             logInProduction: true
         )
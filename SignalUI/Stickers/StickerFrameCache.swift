@@ -0,0 +1,212 @@
+//
+// Copyright 2024 Signal Messenger, LLC
+// SPDX-License-Identifier: AGPL-3.0-only
+//
+
+import SignalServiceKit
+import YYImage
+
+/// Decoded frames of animated stickers, shared by every view that shows the
+/// same sticker at the same size.
+///
+/// YYAnimatedImageView decodes the frames of its image itself, so every view
+/// showing an animated sticker decodes it again, and a view that's short of
+/// memory decodes each frame again on every loop. Images from this cache have
+/// all of their frames decoded once, at the size they're displayed, and play
+/// back in YYAnimatedImageView with the sticker's own frame durations and
+/// loop count.
+public class StickerFrameCache {
+
+    public static let shared = StickerFrameCache()
+
+    /// Stickers are at most 512x512 pixels.
+    private static let maxStickerDimension: CGFloat = 512
+    /// Stickers with more decoded frame data than this are left to YYImage,
+    /// which only keeps a few frames decoded at a time. A quarter of
+    /// `totalCostLimit`, so that one long sticker can't evict the rest.
+    private static let maxBytesPerSticker = 16 * 1024 * 1024
+
+    private let cache = NSCache<NSString, UIImage>()
+    /// Stickers that aren't animated, or are too large, so that they aren't
+    /// read and parsed again every time they're shown.
+    private let undecodableKeys = AtomicSet<NSString>(lock: .init())
+    private let decodeQueue = DispatchQueue(label: "org.signal.sticker-frame-cache", qos: .utility)
+
+    public init() {
+        cache.totalCostLimit = 64 * 1024 * 1024
+
+        if CurrentAppContext().isMainApp {
+            NotificationCenter.default.addObserver(
+                self,
+                selector: #selector(didEnterBackground),
+                name: .OWSApplicationDidEnterBackground,
+                object: nil
+            )
+        }
+    }
+
+    @objc
+    private func didEnterBackground() {
+        cache.removeAllObjects()
+    }
+
+    private static func maxPixelSize(pointSize: CGFloat?) -> CGFloat {
+        guard let pointSize else {
+            return maxStickerDimension
+        }
+        return min(maxStickerDimension, (pointSize * UIScreen.main.scale).rounded(.up))
+    }
+
+    private static func cacheKey(stickerKey: String, maxPixelSize: CGFloat) -> NSString {
+        return "\(stickerKey)-\(Int(maxPixelSize))" as NSString
+    }
+
+    /// Returns the sticker, if it has already been decoded for display at
+    /// `pointSize`, or at full size if `pointSize` is nil.
+    public func cachedImage(stickerKey: String, pointSize: CGFloat?) -> UIImage? {
+        let maxPixelSize = Self.maxPixelSize(pointSize: pointSize)
+        return cache.object(forKey: Self.cacheKey(stickerKey: stickerKey, maxPixelSize: maxPixelSize))
+    }
+
+    /// Returns the sticker decoded for display at `pointSize`, decoding it if
+    /// necessary, which can be slow.
+    ///
+    /// Returns nil if the sticker isn't animated, or has too many frames to
+    /// keep decoded; it should be displayed with YYImage instead.
+    public func image(stickerKey: String, fileUrl: URL, pointSize: CGFloat?) -> UIImage? {
+        let maxPixelSize = Self.maxPixelSize(pointSize: pointSize)
+        let cacheKey = Self.cacheKey(stickerKey: stickerKey, maxPixelSize: maxPixelSize)
+        if let image = cache.object(forKey: cacheKey) {
+            return image
+        }
+        guard !undecodableKeys.contains(cacheKey) else {
+            return nil
+        }
+        guard let decoded = Self.decodeFrames(fileUrl: fileUrl, maxPixelSize: maxPixelSize) else {
+            undecodableKeys.insert(cacheKey)
+            return nil
+        }
+        cache.setObject(decoded.image, forKey: cacheKey, cost: decoded.byteCount)
+        return decoded.image
+    }
+
+    /// Decodes the sticker in the background, so that later calls to
+    /// `cachedImage(stickerKey:pointSize:)` find it.
+    public func prepareImage(stickerKey: String, fileUrl: URL, pointSize: CGFloat?) {
+        decodeQueue.async {
+            _ = self.image(stickerKey: stickerKey, fileUrl: fileUrl, pointSize: pointSize)
+        }
+    }
+
+    private static func decodeFrames(fileUrl: URL, maxPixelSize: CGFloat) -> (image: UIImage, byteCount: Int)? {
+        guard
+            let data = try? Data(contentsOf: fileUrl),
+            let decoder = YYImageDecoder(data: data, scale: 1),
+            decoder.frameCount > 1,
+            decoder.width > 0,
+            decoder.height > 0
+        else {
+            return nil
+        }
+
+        let imageSize = CGSize(width: CGFloat(decoder.width), height: CGFloat(decoder.height))
+        let scale = min(1, maxPixelSize / max(imageSize.width, imageSize.height))
+        let frameSize = CGSize(
+            width: max(1, (imageSize.width * scale).rounded()),
+            height: max(1, (imageSize.height * scale).rounded())
+        )
+        let frameCount = Int(decoder.frameCount)
+        let byteCount = Int(frameSize.width * frameSize.height) * 4 * frameCount
+        guard byteCount <= maxBytesPerSticker else {
+            return nil
+        }
+
+        let format = UIGraphicsImageRendererFormat()
+        format.scale = 1
+        format.opaque = false
+        let renderer = UIGraphicsImageRenderer(size: frameSize, format: format)
+
+        var frames = [UIImage]()
+        var durations = [TimeInterval]()
+        frames.reserveCapacity(frameCount)
+        durations.reserveCapacity(frameCount)
+        for index in 0..<frameCount {
+            // The decoder composites each frame onto the ones before it, so
+            // every frame is a complete image.
+            guard let frame = decoder.frame(at: UInt(index), decodeForDisplay: false), let frameImage = frame.image else {
+                return nil
+            }
+            let renderedFrame = renderer.image { _ in
+                frameImage.draw(in: CGRect(origin: .zero, size: frameSize))
+            }
+            // Keeps YYAnimatedImageView from decoding the frame again.
+            renderedFrame.yy_isDecodedForDisplay = true
+            frames.append(renderedFrame)
+            // Like browsers, treat very short frames as 100ms.
+            durations.append(frame.duration > 0.01 ? frame.duration : 0.1)
+        }
+
+        guard let image = DecodedStickerImage(
+            frames: frames,
+            durations: durations,
+            loopCount: decoder.loopCount,
+            bytesPerFrame: UInt(frameSize.width * frameSize.height) * 4
+        ) else {
+            return nil
+        }
+        return (image, byteCount)
+    }
+}
+
+// MARK: -
+
+/// An animated sticker whose frames are all decoded. The image itself is the
+/// first frame.
+private final class DecodedStickerImage: UIImage, YYAnimatedImage {
+    private let frames: [UIImage]
+    private let durations: [TimeInterval]
+    private let loopCount: UInt
+    private let bytesPerFrame: UInt
+
+    init?(frames: [UIImage], durations: [TimeInterval], loopCount: UInt, bytesPerFrame: UInt) {
+        guard let firstFrame = frames.first?.cgImage else {
+            return nil
+        }
+        owsAssertDebug(frames.count == durations.count)
+        self.frames = frames
+        self.durations = durations
+        self.loopCount = loopCount
+        self.bytesPerFrame = bytesPerFrame
+        super.init(cgImage: firstFrame, scale: 1, orientation: .up)
+        self.yy_isDecodedForDisplay = true
+    }
+
+    required init?(coder: NSCoder) {
+        fatalError("init(coder:) has not been implemented")
+    }
+
+    required convenience init(imageLiteralResourceName name: String) {
+        fatalError("init(imageLiteralResourceName:) has not been implemented")
+    }
+
+    func animatedImageFrameCount() -> UInt {
+        return UInt(frames.count)
+    }
+
+    /// 0 means loop forever.
+    func animatedImageLoopCount() -> UInt {
+        return loopCount
+    }
+
+    func animatedImageBytesPerFrame() -> UInt {
+        return bytesPerFrame
+    }
+
+    func animatedImageFrame(at index: UInt) -> UIImage? {
+        return index < frames.count ? frames[Int(index)] : nil
+    }
+
+    func animatedImageDuration(at index: UInt) -> TimeInterval {
+        return index < durations.count ? durations[Int(index)] : 0
+    }
+}
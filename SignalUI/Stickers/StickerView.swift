@@ -40,7 +40,8 @@ public class StickerView {
 
         guard let stickerView = self.stickerView(stickerInfo: stickerInfo,
                                                  stickerType: stickerMetadata.stickerType,
-                                                 stickerDataUrl: stickerDataUrl) else {
+                                                 stickerDataUrl: stickerDataUrl,
+                                                 size: size) else {
             Logger.warn("Could not load sticker for display.")
             return nil
         }
@@ -52,7 +53,8 @@ public class StickerView {
 
     static func stickerView(stickerInfo: StickerInfo,
                             stickerType: StickerType,
-                            stickerDataUrl: URL) -> UIView? {
+                            stickerDataUrl: URL,
+                            size: CGFloat? = nil) -> UIView? {
 
         guard OWSFileSystem.fileOrFolderExists(url: stickerDataUrl) else {
             Logger.warn("Sticker path does not exist: \(stickerDataUrl).")
@@ -67,9 +69,19 @@ public class StickerView {
         let stickerView: UIView
         switch stickerType {
         case .webp, .apng, .gif:
-            guard let stickerImage = YYImage(contentsOfFile: stickerDataUrl.path) else {
-                owsFailDebug("Sticker could not be parsed.")
-                return nil
+            let stickerKey = stickerInfo.asKey()
+            let stickerImage: UIImage
+            if let cachedImage = StickerFrameCache.shared.cachedImage(stickerKey: stickerKey, pointSize: size) {
+                stickerImage = cachedImage
+            } else {
+                // Decode the frames for next time, e.g. when this sticker is
+                // scrolled back into view.
+                StickerFrameCache.shared.prepareImage(stickerKey: stickerKey, fileUrl: stickerDataUrl, pointSize: size)
+                guard let yyImage = YYImage(contentsOfFile: stickerDataUrl.path) else {
+                    owsFailDebug("Sticker could not be parsed.")
+                    return nil
+                }
+                stickerImage = yyImage
             }
             let yyView = YYAnimatedImageView()
             yyView.alwaysInfiniteLoop = true